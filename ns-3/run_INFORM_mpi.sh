@@ -0,0 +1,60 @@
+#!/bin/bash
+# Distributed version of one INFORM simulation: the nodes of the scenario are split among
+# MPI ranks (routers by TopologyPartitioner, repos and clients with their router), see the
+# --mpi option of scratch/ndn-inform.cc.  ns-3 must be configured with --enable-mpi.
+#
+# Usage: ./run_INFORM_mpi.sh <ranks> <name> <ndn-inform arguments>
+#   e.g. ./run_INFORM_mpi.sh 4 smallWorld_R=1 --networkType=smallWorld --topologyImport=Adjacency ...
+#
+# Every rank writes the trace files of its own nodes (RESULTS/Inform/..., same names as in a
+# single-process run), so the per-rank traces together are the traces of the whole scenario.
+# The stdout of the ranks (mpirun --output-filename) is merged in $logDir/stdout/logSIM=<name>.out:
+# scenario setup of rank 0, then the content store (and INFORM counters) of all nodes in node order.
+
+main=./waf
+
+fws="Inform"
+logDir=RESULTS
+routeDir=ROUTES
+
+if [ $# -lt 2 ]; then
+        echo "Usage: $0 <ranks> <name> <ndn-inform arguments>"
+        exit 1
+fi
+ranks=$1
+name=$2
+shift 2
+
+# ******* Build once
+$main build || exit 1
+
+outDir=`grep "^out_dir" .lock-waf_linux2_build | awk -F "'" '{print $2}'`
+sim=${outDir}/scratch/ndn-inform
+if [ ! -x $sim ]; then
+        echo "ERROR: $sim not found"
+        exit 1
+fi
+export LD_LIBRARY_PATH=${outDir}:$LD_LIBRARY_PATH
+
+mkdir -p $logDir/stdout $routeDir
+for d in DATA DATA/APP INTEREST INTEREST/APP DOWNLOAD/APP
+do
+        mkdir -p $logDir/${fws}/$d
+done
+
+# ******* Run the ranks (--oversubscribe: more ranks than cores is allowed, e.g., for testing)
+rankDir=$logDir/stdout/mpi_${name}
+rm -rf $rankDir
+mpirun -np $ranks --oversubscribe --output-filename $rankDir $sim --mpi=1 --GlobalRoutingCache=${routeDir} "$@" > /dev/null
+status=$?
+
+# ******* Merge the stdout of the ranks
+out=$logDir/stdout/logSIM\=${name}.out
+awk '/^Node #/ {exit} {print}' $rankDir/1/rank.0/stdout > $out
+awk 'FNR == 1 { nodes = 0 }
+     /^Node #[0-9]+/ { nodes = 1; split ($0, f, /[#\t]/); node = f[2] + 0; kind = ($0 ~ /\t/) ? 1 : 0; line = 0 }
+     nodes { printf "%d\t%d\t%d\t%s\n", kind, node, line++, $0 }' $rankDir/1/rank.*/stdout |
+        sort -s -t $'\t' -k1,1n -k2,2n -k3,3n | cut -f 4- >> $out
+
+echo -e "${name}\t${ranks} ranks\texit ${status}"
+exit $status
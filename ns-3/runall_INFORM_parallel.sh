@@ -0,0 +1,122 @@
+#!/bin/bash
+# Parallel version of runall_INFORM.sh: replicas (RngRun) and INFORM parameter combinations
+# are independent simulations, so they are run concurrently as separate processes.
+#
+# Usage: ./runall_INFORM_parallel.sh [number of concurrent simulations, default = number of cores]
+#
+# The scenario is built once, then the binary is launched directly (parallel "./waf --run"
+# invocations would fight for the waf lock and re-check the build every time).
+# Read-only inputs (topologies, seed copies, content catalog) are shared through the page cache:
+# they are read once from disk, and the request catalog is memory-mapped by every replica.
+# Routes are cached in $routeDir, so replicas with the same topology (same network and RngRun,
+# which places the repositories) calculate them only once.
+
+main=./waf
+jobs=${1:-`nproc`}
+
+SCRIPTPATH=`pwd`
+
+fws="Inform"
+
+runs=4
+logDir=RESULTS
+infoDir=infoSim
+routeDir=ROUTES
+
+C=0.001
+M=101146
+estM=500000
+clPerc=50    		# Percentage of core node a client is attached to.
+qTabLifetime=100	# qTab lifitime [s]
+
+numClients=35           #approximately
+req=50000000
+
+networks="smallWorld random"	#Geant_Topo_Only
+alphas="0.8 1 1.2"
+lambdas="1"
+etas="0.7"			# Eta parameter to calculate the Q-value
+deltas="0.1"			# Treshold indicating when the Exploitation phase must be stopped.
+maxExplors="3"			# Max num of chunks for the Exploration phase
+maxExploits="30"		# Max num of chunks for the Exploitation phase
+
+summary=${infoDir}/Summary_SIM\=${fws}_`date +%Y%m%d-%H%M%S`.txt
+
+
+# ******* Build once
+$main build || exit 1
+
+outDir=`grep "^out_dir" .lock-waf_linux2_build | awk -F "'" '{print $2}'`
+sim=${outDir}/scratch/ndn-inform
+if [ ! -x $sim ]; then
+        echo "ERROR: $sim not found"
+        exit 1
+fi
+export LD_LIBRARY_PATH=${outDir}:$LD_LIBRARY_PATH
+
+mkdir -p $logDir/stdout $infoDir $routeDir
+for d in DATA DATA/APP INTEREST INTEREST/APP DOWNLOAD/APP
+do
+        mkdir -p $logDir/${fws}/$d
+done
+
+# Warm the page cache, so concurrent replicas do not read the shared inputs from disk at the same time
+cat ../TOPOLOGIES/*/*.txt ../SEED_COPIES/CommonCrawl/* > /dev/null 2>&1
+
+
+# ******* Run one replica (arguments: name, scenario arguments)
+run_replica()
+{
+        name=$1
+        shift
+        /usr/bin/time -f "%e\t%M\t%x" -o ${infoDir}/Info_SIM\=${name}.txt $sim "$@" > $logDir/stdout/logSIM\=${name}.out 2>&1
+        echo -e "${name}\t`tail -1 ${infoDir}/Info_SIM\=${name}.txt`"
+}
+export -f run_replica
+export sim logDir infoDir
+
+
+# ******* List of the replicas: one line per simulation
+for n in $networks
+do
+        if [ $n == "smallWorld" ] || [ $n == "random" ]; then
+                netImport=Adjacency
+        else
+                netImport=Annotated
+        fi
+
+        for k in $alphas
+        do
+                for z in $lambdas
+                do
+                        let "simDuration = $req / $numClients"
+
+                        for eta in $etas
+                        do
+                        for delta in $deltas
+                        do
+                        for maxExplor in $maxExplors
+                        do
+                        for maxExploit in $maxExploits
+                        do
+                                for i in `seq 0 $runs`
+                                do
+                                        j=`expr $i + 1`
+                                        name=${fws}_N\=${n}_eta\=${eta}_delta\=${delta}_chunkExplor\=${maxExplor}_chunkExploit\=${maxExploit}_qTabLife\=${qTabLifetime}_A\=${k}_R\=${i}
+
+                                        echo "$name --uniqueContents=${M} --contentCatalogFib=${estM} --cacheToCatalog=${C} --lambda=${z} --alpha=${k} --clientPerc=${clPerc} --eta=${eta} --delta=${delta} --maxChunkExplorPhase=${maxExplor} --maxChunkExploitPhase=${maxExploit} --qTabEntryLifetime=${qTabLifetime} --networkType=${n} --topologyImport=${netImport} --simDuration=${simDuration} --RngSeed=1 --RngRun=${j} --GlobalRoutingCache=${routeDir} --GlobalRoutingThreads=1"
+                                done
+                        done
+                        done
+                        done
+                        done
+                done
+        done
+done | xargs -P $jobs -L 1 bash -c 'run_replica "$@"' run_replica > $summary.tmp
+
+# ******* Summary: wall time [s], peak RSS [kBytes] and exit status of every replica
+echo -e "#replica\telapsed[s]\tmaxRSS[kB]\texit" > $summary
+sort $summary.tmp >> $summary
+rm $summary.tmp
+
+awk -F '\t' '!/^#/ {n++; t+=$2; if ($3>m) m=$3; if ($4!=0) f++} END {print n " replicas, total " t " s, max RSS " m " kB, " f+0 " failed"}' $summary
@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Content store benchmark: replays the same Zipf request sequence, mixed with one-shot requests,
+// against every content store and reports hit ratio and cost of Lookup/Add.
+//
+// ./waf --run "ndn-cs-benchmark --contents=100000 --requests=1000000 --alpha=1 --oneShot=0.2 --cacheSize=1000"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/random-variable-stream.h"
+
+#include <time.h>
+#include <cmath>
+#include <algorithm>
+#include <boost/tokenizer.hpp>
+#include <boost/lexical_cast.hpp>
+
+using namespace ns3;
+using namespace ndn;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.CsBenchmark");
+
+static inline uint64_t
+NowNs ()
+{
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t> (now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t contents = 100000;
+  uint32_t requests = 1000000;
+  double alpha = 1.0;
+  double oneShot = 0.2;
+  uint32_t cacheSize = 1000;
+  uint32_t payload = 1024;
+  std::string stores = "ns3::ndn::cs::Lru,ns3::ndn::cs::Lfu,ns3::ndn::cs::Random,ns3::ndn::cs::Fifo,ns3::ndn::cs::S3Fifo";
+
+  CommandLine cmd;
+  cmd.AddValue ("contents", "Number of contents requested with Zipf popularity", contents);
+  cmd.AddValue ("requests", "Number of requests", requests);
+  cmd.AddValue ("alpha", "Exponent of the Zipf popularity", alpha);
+  cmd.AddValue ("oneShot", "Share of requests for contents that are requested only once", oneShot);
+  cmd.AddValue ("cacheSize", "Maximum number of entries of the content stores (MaxSize)", cacheSize);
+  cmd.AddValue ("payload", "Payload size of the contents [bytes]", payload);
+  cmd.AddValue ("stores", "Comma-separated list of content store classes", stores);
+  cmd.Parse (argc, argv);
+
+  // ******* Request sequence, the same for every content store
+  std::vector<double> cumulative (contents);
+  double sum = 0;
+  for (uint32_t i = 0; i < contents; i++)
+    {
+      sum += 1.0 / std::pow (i + 1.0, alpha);
+      cumulative[i] = sum;
+    }
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  std::vector<uint32_t> sequence (requests);
+  uint32_t nextOneShot = contents;
+  for (uint32_t i = 0; i < requests; i++)
+    {
+      if (rand->GetValue () < oneShot)
+        sequence[i] = nextOneShot ++;
+      else
+        sequence[i] = std::lower_bound (cumulative.begin (), cumulative.end (), rand->GetValue () * sum) - cumulative.begin ();
+    }
+
+  std::cout << "#contents=" << contents << " requests=" << requests << " alpha=" << alpha
+            << " oneShot=" << oneShot << " cacheSize=" << cacheSize << " payload=" << payload << std::endl;
+  std::cout << "#store\thitRatio\tlookup[ns/op]\tadd[ns/op]\tentries" << std::endl;
+
+  boost::char_separator<char> separator (",");
+  boost::tokenizer<boost::char_separator<char> > tokens (stores, separator);
+  for (boost::tokenizer<boost::char_separator<char> >::iterator store = tokens.begin (); store != tokens.end (); store++)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (*store);
+      factory.Set ("MaxSize", StringValue (boost::lexical_cast<std::string> (cacheSize)));
+      Ptr<ContentStore> cs = factory.Create<ContentStore> ();
+
+      uint64_t hits = 0;
+      uint64_t lookupNs = 0;
+      uint64_t addNs = 0;
+      uint64_t adds = 0;
+      for (uint32_t i = 0; i < requests; i++)
+        {
+          Ptr<Name> name = Create<Name> ();
+          name->Add ("prefix").Add (sequence[i]);
+
+          Ptr<Interest> interest = Create<Interest> ();
+          interest->SetName (name);
+
+          uint64_t start = NowNs ();
+          bool hit = cs->Lookup (interest).get<1> () != 0;
+          lookupNs += NowNs () - start;
+
+          if (hit)
+            {
+              hits ++;
+              continue;
+            }
+
+          // content retrieved from the network is added, as done by the forwarding strategy
+          Ptr<ContentObject> header = Create<ContentObject> ();
+          header->SetName (name);
+          Ptr<Packet> packet = Create<Packet> (payload);
+
+          start = NowNs ();
+          cs->Add (header, packet);
+          addNs += NowNs () - start;
+          adds ++;
+        }
+
+      std::cout << *store << "\t" << static_cast<double> (hits) / requests
+                << "\t" << static_cast<double> (lookupNs) / requests
+                << "\t" << (adds > 0 ? static_cast<double> (addNs) / adds : 0)
+                << "\t" << cs->GetSize () << std::endl;
+    }
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -26,9 +26,12 @@
 #include "ns3/ndnSIM-module.h"
 #include "ns3/point-to-point-grid.h"
 #include "ns3/mobility-module.h"
+#include "ns3/mpi-interface.h"
 #include "../src/ndnSIM/helper/ndn-global-routing-helper.h"
 #include "../src/ndnSIM/model/ndn-global-router.h"
 #include "../src/ndnSIM/model/qtab/ndn-qtab.h"
+#include "../src/ndnSIM/utils/tracers/ndn-binary-trace-writer.h"
+#include "../src/ndnSIM/plugins/topology/topology-partitioner.h"
 #include <string.h>
 #include <stdio.h>
 #include <sstream>
@@ -59,6 +62,10 @@ void DataAppTrace(Ptr<OutputStreamWrapper> stream, Ptr<const ContentObject> head
 void InterestAppTrace(Ptr<OutputStreamWrapper> stream, const std::string* header, int64_t time_sent, std::string eventType, std::string nodeType);
 void DownloadTimeTrace(Ptr<OutputStreamWrapper> stream, const std::string* header, int64_t time_sent, int64_t downloadTime, uint32_t dist, std::string eventType, std::string nodeType);
 
+// Connect the traces of the node to text files (traceFormat = text) or to binary files (traceFormat = binary or binary-gz)
+void ConnectStrategyTraces(Ptr<Node> node, const std::string &interestFile, const std::string &dataFile, const std::string &traceFormat, std::vector<Ptr<BinaryTraceWriter> > &writers);
+void ConnectAppTraces(Ptr<Node> node, const std::string &dataAppFile, const std::string &interestAppFile, const std::string &downloadFile, const std::string &traceFormat, std::vector<Ptr<BinaryTraceWriter> > &writers);
+
 
 int
 main (int argc, char *argv[14])
@@ -98,6 +105,14 @@ main (int argc, char *argv[14])
   uint32_t qTabEntryLifetime = 0; 	     // Lifetime for the qTab Entry [s]
   std::string networkType = "";              // Type of simulated network (Network Name)
   std::string topologyImport = "";	     // How to create the network (Annotated or Adjacency)
+  std::string qTabType = "Persistent";	     // QTAB implementation (Persistent = trie, Flat = open-addressing hash table)
+  std::string csType = "Lru";	     // Content Store implementation of clients and core nodes (Lru, Lfu, Random, Fifo or S3Fifo)
+  std::string repoType = "Persistent";	     // Repo implementation (Persistent = packets stored in a trie, Synthetic = names only, packets created on demand)
+  std::string traceFormat = "text";	     // Format of the trace files (text, binary or binary-gz)
+  bool mpi = false;			     // Distributed simulation: nodes are split among the MPI ranks
+  std::string warmStateSave = "";	     // File where the warm state of the nodes is saved at warmStateTime
+  double warmStateTime = 0;		     // Time of the warm state snapshot [s]
+  std::string warmStateLoad = "";	     // File of a warm state saved by a previous run with the same topology
 
 
   double simDuration = 200.0;                                    // Duration of the Simulation [s].
@@ -116,11 +131,37 @@ main (int argc, char *argv[14])
   cmd.AddValue ("qTabEntryLifetime", "Maximum amount of time with no Interests before deleting the relative entry", qTabEntryLifetime);
   cmd.AddValue ("networkType", "Type of Simulated Network", networkType);
   cmd.AddValue ("topologyImport", "How to create the topology (Annotated or Adjacency)", topologyImport);
+  cmd.AddValue ("qTabType", "QTAB implementation (Persistent or Flat)", qTabType);
+  cmd.AddValue ("csType", "Content Store implementation of clients and core nodes (Lru, Lfu, Random, Fifo or S3Fifo)", csType);
+  cmd.AddValue ("repoType", "Repo implementation (Persistent or Synthetic)", repoType);
+  cmd.AddValue ("traceFormat", "Format of the trace files (text, binary or binary-gz; convert binary files with ndn-trace-to-text)", traceFormat);
   cmd.AddValue ("simDuration", "Duration of the Simulation", simDuration);
+  cmd.AddValue ("mpi", "Split the nodes among the MPI ranks (run with mpirun; every rank writes the traces of its nodes)", mpi);
+  cmd.AddValue ("warmStateSave", "Save content stores, QTABs and FIBs to this file at warmStateTime", warmStateSave);
+  cmd.AddValue ("warmStateTime", "Time of the warm state snapshot [s]", warmStateTime);
+  cmd.AddValue ("warmStateLoad", "Restore content stores, QTABs and FIBs from this file before the simulation starts", warmStateLoad);
 
 
   cmd.Parse (argc, argv);
 
+  if (traceFormat != "text" && traceFormat != "binary" && traceFormat != "binary-gz")
+  {
+	  std::cerr << "ERROR: traceFormat must be text, binary or binary-gz" << std::endl;
+	  return 1;
+  }
+
+  // ** Distributed simulation: every rank builds the whole topology, but simulates only the nodes
+  //    with its system id (routers are split by TopologyPartitioner, repos and clients follow their router)
+  uint32_t systemId = 0;
+  uint32_t ranks = 1;
+  if (mpi)
+  {
+	  GlobalValue::Bind ("SimulatorImplementationType", StringValue ("ns3::DistributedSimulatorImpl"));
+	  MpiInterface::Enable (&argc, &argv);
+	  systemId = MpiInterface::GetSystemId ();
+	  ranks = MpiInterface::GetSize ();
+  }
+
   Time finishTime = Seconds (simDuration);
 
   uint64_t simRun = SeedManager::GetRun();
@@ -211,6 +252,7 @@ main (int argc, char *argv[14])
 	  ss.str("");
 	  //topologyReader.SetFileName ("../TOPOLOGIES/Geant_Topo_Only.txt");
 	  topologyReader.SetFileName (topoPathCh);
+	  topologyReader.SetPartitions (ranks);
 	  topologyReader.Read ();
 	  numCoreNodes = topologyReader.GetNodes().GetN();
   }
@@ -225,7 +267,23 @@ main (int argc, char *argv[14])
 	  std::vector<std::vector<bool> > adjMatrix = readAdjMat (topoPath);
 	  numCoreNodes = adjMatrix.size();
 
-	  coreNodes.Create(numCoreNodes);
+	  std::vector<uint32_t> coreSystemIds (numCoreNodes, 0);
+	  if (ranks > 1)
+	  {
+		  TopologyPartitioner partitioner;
+		  for (size_t i = 0; i < adjMatrix.size (); i++)
+			  partitioner.AddNode ();
+		  for (size_t i = 0; i < adjMatrix.size (); i++)
+			  for (size_t j = 0; j < adjMatrix[i].size (); j++)
+				  if (adjMatrix[i][j] == 1)
+					  partitioner.AddLink (i, j, Time (linkDelayCore));
+
+		  coreSystemIds = partitioner.Partition (ranks);
+		  NS_LOG_UNCOND("Core nodes split among " << ranks << " ranks:\t" << partitioner.GetCutLinks () << " links cut, lookahead " << partitioner.GetLookahead ().GetMicroSeconds () << " us");
+	  }
+
+	  for (uint32_t i = 0; i < numCoreNodes; i++)
+		  coreNodes.Create(1, coreSystemIds[i]);
 
 	  // NB: Si potrebbe aggiungere una procedura di selezione random dove vengono settati gli
 	  //     Error Rate di alcuni link.
@@ -289,6 +347,8 @@ main (int argc, char *argv[14])
   // ** Total number of nodes in the simulated topology
   //uint32_t numNodes = topologyReader.GetNodes().GetN();
   NS_LOG_UNCOND("The total number of core nodes is:\t" << numCoreNodes);
+
+  NodeContainer routers = topologyImport.compare("Annotated")==0 ? topologyReader.GetNodes () : coreNodes;
   
   // ******************************************************
 
@@ -342,7 +402,10 @@ main (int argc, char *argv[14])
 
   // Creation and Attachment of Repo Nodes
 
-  repoNodes.Create(numRandRepo);
+  for(uint32_t i=0; i<repoAttachesID->size(); i++)
+  {
+	  repoNodes.Create(1, routers.Get (repoAttachesID->operator[](i))->GetSystemId ());
+  }
 
   PointToPointHelper p2p;
   p2p.SetDeviceAttribute ("DataRate", StringValue (linkRateEdge));
@@ -484,7 +547,10 @@ main (int argc, char *argv[14])
 
   // Creation and Attachment of Client Nodes
 
-  clientNodes.Create(numClients);
+  for(uint32_t i=0; i<clientAttachesID->size(); i++)
+  {
+	  clientNodes.Create(1, routers.Get (clientAttachesID->operator[](i))->GetSystemId ());
+  }
 
   //PointToPointHelper p2p;
   p2p.SetDeviceAttribute ("DataRate", StringValue (linkRateEdge));
@@ -536,6 +602,7 @@ main (int argc, char *argv[14])
 
   ndnHelper.SetForwardingStrategy("ns3::ndn::fw::FloodingInform");     // Selective flooding for BF scenario
   ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.SetQtab("ns3::ndn::qtab::" + qTabType);
 
 
 //  NodeContainer producerNodes;
@@ -564,12 +631,12 @@ main (int argc, char *argv[14])
 	  {
 		  // **** For Repo nodes: Cache Size = 0, that is they store only permanent copies.
 		  ndnHelper.SetContentStore("ns3::ndn::cs::Lru", "MaxSize", "0");
-		  ndnHelper.SetRepository("ns3::ndn::rp::Persistent", "MaxSize", repoSizeStr);
+		  ndnHelper.SetRepository("ns3::ndn::rp::" + repoType, "MaxSize", repoSizeStr);
 	  }
 	  else
 	  {
 		  // **** For Clients or Routers: Repo Size = 0, that is they do not store permanent copies.
-		  ndnHelper.SetContentStore("ns3::ndn::cs::Lru", "MaxSize", cacheSizeStr);
+		  ndnHelper.SetContentStore("ns3::ndn::cs::" + csType, "MaxSize", cacheSizeStr);
 		  ndnHelper.SetRepository("ns3::ndn::rp::Persistent", "MaxSize", "0");
 		  //consumerNodes.Add((*node));
 	  }
@@ -587,6 +654,7 @@ main (int argc, char *argv[14])
   std::string line;
   Ptr<Node> nd;
   const char *pathRepoCompl;
+  std::string pathRepoFile;
   std::ifstream fin;
 
   switch (numRandRepo)
@@ -606,18 +674,10 @@ main (int argc, char *argv[14])
   	// **** Read seed copies from file and insert them inside the repo.
   	while(std::getline(fin, line))
   	{
-  		static ContentObjectTail tail;
- 	    Ptr<ContentObject> header = Create<ContentObject> ();
- 	    header->SetName (Create<Name>(line));
- 	    header->SetTimestamp (Simulator::Now ());
- 	    header->SetSignature(0);
- 	    Ptr<Packet> packet = Create<Packet> (512);
- 	    packet->AddHeader (*header);
- 	    packet->AddTrailer (tail);
-
  	    ndnGlobalRoutingHelper.AddOrigin (line, nd);
 
- 	    nd->GetObject<Repo> ()->Add (header, packet);
+ 	    if (nd->GetSystemId () == systemId)
+ 	      nd->GetObject<Repo> ()->AddContent (Name (line), 512);
   	}
   	fin.close();
   	break;
@@ -630,7 +690,8 @@ main (int argc, char *argv[14])
     {
        nd = NodeList::GetNode(reposID->operator[](i));
        ss << pathRepo << (i+1) << EXT;
-  	   pathRepoCompl = ss.str().c_str();
+  	   pathRepoFile = ss.str();          // keep the string alive while its c_str () is used
+  	   pathRepoCompl = pathRepoFile.c_str();
        ss.str("");
 
        fin.open(pathRepoCompl);
@@ -642,19 +703,10 @@ main (int argc, char *argv[14])
   	   // **** Read seed copies from file and insert them inside the repo.
   	   while(std::getline(fin, line))
   	   {
-           static ContentObjectTail tail;
-  		   Ptr<ContentObject> header = Create<ContentObject> ();
-  		   header->SetName (Create<Name>(line));
-  		   header->SetTimestamp (Simulator::Now ());
-  		   header->SetSignature(0);
-
-  		   Ptr<Packet> packet = Create<Packet> (512);
-  		   packet->AddHeader (*header);
-  		   packet->AddTrailer (tail);
-
   		   ndnGlobalRoutingHelper.AddOrigin (line, nd);
 
-  		   nd->GetObject<Repo> ()->Add (header, packet);
+  		   if (nd->GetSystemId () == systemId)
+  		     nd->GetObject<Repo> ()->AddContent (Name (line), 512);
   		}
   		fin.close();
      }
@@ -683,7 +735,13 @@ main (int argc, char *argv[14])
 
 
   //consumerHelper.SetAttribute ("StartTime", TimeValue (Seconds (2.000000)));
-  ApplicationContainer consumers = consumerHelper.Install (clientNodes);
+  NodeContainer localClientNodes;
+  for (NodeContainer::Iterator node = clientNodes.Begin(); node != clientNodes.End(); ++node)
+  {
+	  if ((*node)->GetSystemId () == systemId)
+		  localClientNodes.Add (*node);
+  }
+  ApplicationContainer consumers = consumerHelper.Install (localClientNodes);
   consumers.Start (Seconds(2));
   //consumers.Stop(finishTime-Seconds(1));
 
@@ -822,7 +880,7 @@ main (int argc, char *argv[14])
 
 
   std::stringstream fname;
-  AsciiTraceHelper asciiTraceHelper;
+  std::vector<Ptr<BinaryTraceWriter> > traceWriters;
 
   uint32_t z = 0;
 
@@ -842,16 +900,9 @@ main (int argc, char *argv[14])
           ss.str("");
 
 
-          // ******** STREAM DI OUTPUT ***************
-          Ptr<OutputStreamWrapper> streamInterest = asciiTraceHelper.CreateFileStream(filename_interestClient);
-          Ptr<OutputStreamWrapper> streamData = asciiTraceHelper.CreateFileStream(filename_dataClient);
-
-           // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("AggregateInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutData", MakeBoundCallback(&DataTrace, streamData));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InData", MakeBoundCallback(&DataTrace, streamData));
+          // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
+          if ((*node)->GetSystemId () == systemId)
+                  ConnectStrategyTraces(*node, filename_interestClient, filename_dataClient, traceFormat, traceWriters);
 
           z = z+1;
   }
@@ -874,16 +925,9 @@ main (int argc, char *argv[14])
           const char *filename_dataProducer = fnDataProducer.c_str();
           ss.str("");
 
-          // ******** STREAM DI OUTPUT ***************
-          Ptr<OutputStreamWrapper> streamInterest = asciiTraceHelper.CreateFileStream(filename_interestProducer);
-          Ptr<OutputStreamWrapper> streamData = asciiTraceHelper.CreateFileStream(filename_dataProducer);
-
-           // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("AggregateInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutData", MakeBoundCallback(&DataTrace, streamData));
-          (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InData", MakeBoundCallback(&DataTrace, streamData));
+          // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
+          if ((*node)->GetSystemId () == systemId)
+                  ConnectStrategyTraces(*node, filename_interestProducer, filename_dataProducer, traceFormat, traceWriters);
 
           z = z+1;
   }
@@ -911,16 +955,9 @@ main (int argc, char *argv[14])
 
                   Ptr<Node> node = topologyReader.GetNodes().Get(i);
 
-                  // ******** STREAM DI OUTPUT ***************
-                  Ptr<OutputStreamWrapper> streamInterest = asciiTraceHelper.CreateFileStream(filename_interestCore);
-                  Ptr<OutputStreamWrapper> streamData = asciiTraceHelper.CreateFileStream(filename_dataCore);
-
-                   // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
-                  node->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-                  node->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-                  node->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("AggregateInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-                  node->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutData", MakeBoundCallback(&DataTrace, streamData));
-                  node->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InData", MakeBoundCallback(&DataTrace, streamData));
+                  // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
+                  if (node->GetSystemId () == systemId)
+                          ConnectStrategyTraces(node, filename_interestCore, filename_dataCore, traceFormat, traceWriters);
                   z = z+1;
           }
   }
@@ -942,16 +979,9 @@ main (int argc, char *argv[14])
                   const char *filename_dataCore = fnDataCore.c_str();
                   ss.str("");
 
-                  // ******** STREAM DI OUTPUT ***************
-                  Ptr<OutputStreamWrapper> streamInterest = asciiTraceHelper.CreateFileStream(filename_interestCore);
-                  Ptr<OutputStreamWrapper> streamData = asciiTraceHelper.CreateFileStream(filename_dataCore);
-
-                   // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
-                  (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-                  (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-                  (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("AggregateInterests", MakeBoundCallback(&InterestTrace, streamInterest));
-                  (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("OutData", MakeBoundCallback(&DataTrace, streamData));
-                  (*node)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("InData", MakeBoundCallback(&DataTrace, streamData));
+                  // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
+                  if ((*node)->GetSystemId () == systemId)
+                          ConnectStrategyTraces(*node, filename_interestCore, filename_dataCore, traceFormat, traceWriters);
                   z = z+1;
           }
   }
@@ -980,39 +1010,78 @@ main (int argc, char *argv[14])
           const char *filename_download_time = fnDwnTime.c_str();
           ss.str("");
 
-          // ******** STREAM DI OUTPUT APP ***************
-      Ptr<OutputStreamWrapper> streamDataApp = asciiTraceHelper.CreateFileStream(filename_data_appClient);
-          Ptr<OutputStreamWrapper> streamInterestApp = asciiTraceHelper.CreateFileStream(filename_interest_appClient);
-      Ptr<OutputStreamWrapper> streamDownloadTime = asciiTraceHelper.CreateFileStream(filename_download_time);
-
-      // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
-      (*node_app)->GetObject<ForwardingStrategy>()->TraceConnectWithoutContext("DataInCacheApp", MakeBoundCallback(&DataAppTrace, streamDataApp));
-      (*node_app)->GetApplication(0)->GetObject<App>()->TraceConnectWithoutContext("InterestApp",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
-      (*node_app)->GetApplication(0)->GetObject<App>()->TraceConnectWithoutContext("TimeOutTrace",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
-      (*node_app)->GetApplication(0)->GetObject<App>()->TraceConnectWithoutContext("NumMaxRtx",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
-      (*node_app)->GetApplication(0)->GetObject<App>()->TraceConnectWithoutContext("UncompleteFile",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
-      (*node_app)->GetApplication(0)->GetObject<App>()->TraceConnectWithoutContext("DownloadTime",MakeBoundCallback(&DownloadTimeTrace, streamDownloadTime));
-      (*node_app)->GetApplication(0)->GetObject<App>()->TraceConnectWithoutContext("DownloadTimeFile",MakeBoundCallback(&DownloadTimeTrace, streamDownloadTime));
+          // ***** ASSOCIAZIONE ALLE FUNZIONI CHE TRATTANO I VARI EVENTI DI TRACE *****
+          if ((*node_app)->GetSystemId () == systemId)
+                  ConnectAppTraces(*node_app, filename_data_appClient, filename_interest_appClient, filename_download_time, traceFormat, traceWriters);
       z=z+1;
   }
 
   // **************************************************************************************************************************
 
+  // ** Warm state: restore the caches, QTABs and FIBs reached by the warm-up of a previous run and/or save them
+  //    (in distributed simulations every rank saves and restores its own nodes, in <file>.rank<systemId>)
+  if (!warmStateLoad.empty () || !warmStateSave.empty ())
+  {
+	  NodeContainer localNodes;
+	  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node ++)
+	  {
+		  if ((*node)->GetSystemId () == systemId)
+			  localNodes.Add (*node);
+	  }
+	  std::string rankSuffix = "";
+	  if (mpi)
+	  {
+		  ss << ".rank" << systemId;
+		  rankSuffix = ss.str();
+		  ss.str("");
+	  }
+	  if (!warmStateLoad.empty ())
+		  ndn::WarmStateHelper::Restore (warmStateLoad + rankSuffix);
+	  if (!warmStateSave.empty ())
+		  ndn::WarmStateHelper::SaveAt (Seconds (warmStateTime), localNodes, warmStateSave + rankSuffix);
+  }
+
   Simulator::Stop (finishTime);
 
   NS_LOG_INFO ("Run Simulation.");
   Simulator::Run ();
 
+  // flush the buffered binary traces
+  for (std::vector<Ptr<BinaryTraceWriter> >::iterator writer = traceWriters.begin (); writer != traceWriters.end (); writer++)
+  {
+     (*writer)->Close ();
+  }
+  traceWriters.clear ();
+
   //   ** [MT] ** Print the cache of each node at the end of the simulation.
+  //   (in distributed simulations every rank prints its own nodes, see run_INFORM_mpi.sh to merge them)
   for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node ++)
   {
+     if ((*node)->GetSystemId () != systemId)
+        continue;
      std::cout << "Node #" << ((*node)->GetId ()+1) << std::endl;
      (*node)->GetObject<ndn::ContentStore> ()->Print (std::cout);
      std::cout << std::endl;
   }
 
+#ifdef NDNSIM_INFORM_COUNTERS
+  //   ** Decisions of the INFORM strategy of each node (ndnSIM configured with --enable-inform-counters)
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node ++)
+  {
+     if ((*node)->GetSystemId () != systemId)
+        continue;
+     std::cout << "Node #" << ((*node)->GetId ()+1) << "\t";
+     (*node)->GetObject<ForwardingStrategy> ()->GetInformCounters ().Print (std::cout);
+     std::cout << std::endl;
+  }
+#endif
+
 
   Simulator::Destroy ();
+  if (mpi)
+  {
+	  MpiInterface::Disable ();
+  }
   NS_LOG_INFO ("Done!");
 
   return 0;
@@ -1046,6 +1115,77 @@ void DownloadTimeTrace(Ptr<OutputStreamWrapper> stream, const std::string* heade
         *stream->GetStream() << Simulator::Now().GetMicroSeconds() << "\t" << time_sent << "\t" <<  eventType << "\t" << "--" << "\t" << downloadTime << "\t" << dist << std::endl;
 }
 
+Ptr<BinaryTraceWriter> CreateTraceWriter(const std::string &file, const std::string &traceFormat, std::vector<Ptr<BinaryTraceWriter> > &writers)
+{
+        bool compress = (traceFormat == "binary-gz");
+        Ptr<BinaryTraceWriter> writer = Create<BinaryTraceWriter> (file + (compress ? ".bin.gz" : ".bin"), compress);
+        writers.push_back (writer);
+        return writer;
+}
+
+void ConnectStrategyTraces(Ptr<Node> node, const std::string &interestFile, const std::string &dataFile, const std::string &traceFormat, std::vector<Ptr<BinaryTraceWriter> > &writers)
+{
+        Ptr<ForwardingStrategy> strategy = node->GetObject<ForwardingStrategy>();
+        if (traceFormat == "text")
+        {
+                AsciiTraceHelper asciiTraceHelper;
+                Ptr<OutputStreamWrapper> streamInterest = asciiTraceHelper.CreateFileStream(interestFile);
+                Ptr<OutputStreamWrapper> streamData = asciiTraceHelper.CreateFileStream(dataFile);
+
+                strategy->TraceConnectWithoutContext("OutInterests", MakeBoundCallback(&InterestTrace, streamInterest));
+                strategy->TraceConnectWithoutContext("InInterests", MakeBoundCallback(&InterestTrace, streamInterest));
+                strategy->TraceConnectWithoutContext("AggregateInterests", MakeBoundCallback(&InterestTrace, streamInterest));
+                strategy->TraceConnectWithoutContext("OutData", MakeBoundCallback(&DataTrace, streamData));
+                strategy->TraceConnectWithoutContext("InData", MakeBoundCallback(&DataTrace, streamData));
+        }
+        else
+        {
+                Ptr<BinaryTraceWriter> writerInterest = CreateTraceWriter(interestFile, traceFormat, writers);
+                Ptr<BinaryTraceWriter> writerData = CreateTraceWriter(dataFile, traceFormat, writers);
+
+                strategy->TraceConnectWithoutContext("OutInterests", MakeCallback(&BinaryTraceWriter::OnInterest, writerInterest));
+                strategy->TraceConnectWithoutContext("InInterests", MakeCallback(&BinaryTraceWriter::OnInterest, writerInterest));
+                strategy->TraceConnectWithoutContext("AggregateInterests", MakeCallback(&BinaryTraceWriter::OnInterest, writerInterest));
+                strategy->TraceConnectWithoutContext("OutData", MakeCallback(&BinaryTraceWriter::OnData, writerData));
+                strategy->TraceConnectWithoutContext("InData", MakeCallback(&BinaryTraceWriter::OnData, writerData));
+        }
+}
+
+void ConnectAppTraces(Ptr<Node> node, const std::string &dataAppFile, const std::string &interestAppFile, const std::string &downloadFile, const std::string &traceFormat, std::vector<Ptr<BinaryTraceWriter> > &writers)
+{
+        Ptr<ForwardingStrategy> strategy = node->GetObject<ForwardingStrategy>();
+        Ptr<App> app = node->GetApplication(0)->GetObject<App>();
+        if (traceFormat == "text")
+        {
+                AsciiTraceHelper asciiTraceHelper;
+                Ptr<OutputStreamWrapper> streamDataApp = asciiTraceHelper.CreateFileStream(dataAppFile);
+                Ptr<OutputStreamWrapper> streamInterestApp = asciiTraceHelper.CreateFileStream(interestAppFile);
+                Ptr<OutputStreamWrapper> streamDownloadTime = asciiTraceHelper.CreateFileStream(downloadFile);
+
+                strategy->TraceConnectWithoutContext("DataInCacheApp", MakeBoundCallback(&DataAppTrace, streamDataApp));
+                app->TraceConnectWithoutContext("InterestApp",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
+                app->TraceConnectWithoutContext("TimeOutTrace",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
+                app->TraceConnectWithoutContext("NumMaxRtx",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
+                app->TraceConnectWithoutContext("UncompleteFile",MakeBoundCallback(&InterestAppTrace, streamInterestApp));
+                app->TraceConnectWithoutContext("DownloadTime",MakeBoundCallback(&DownloadTimeTrace, streamDownloadTime));
+                app->TraceConnectWithoutContext("DownloadTimeFile",MakeBoundCallback(&DownloadTimeTrace, streamDownloadTime));
+        }
+        else
+        {
+                Ptr<BinaryTraceWriter> writerDataApp = CreateTraceWriter(dataAppFile, traceFormat, writers);
+                Ptr<BinaryTraceWriter> writerInterestApp = CreateTraceWriter(interestAppFile, traceFormat, writers);
+                Ptr<BinaryTraceWriter> writerDownloadTime = CreateTraceWriter(downloadFile, traceFormat, writers);
+
+                strategy->TraceConnectWithoutContext("DataInCacheApp", MakeCallback(&BinaryTraceWriter::OnDataApp, writerDataApp));
+                app->TraceConnectWithoutContext("InterestApp",MakeCallback(&BinaryTraceWriter::OnInterestApp, writerInterestApp));
+                app->TraceConnectWithoutContext("TimeOutTrace",MakeCallback(&BinaryTraceWriter::OnInterestApp, writerInterestApp));
+                app->TraceConnectWithoutContext("NumMaxRtx",MakeCallback(&BinaryTraceWriter::OnInterestApp, writerInterestApp));
+                app->TraceConnectWithoutContext("UncompleteFile",MakeCallback(&BinaryTraceWriter::OnInterestApp, writerInterestApp));
+                app->TraceConnectWithoutContext("DownloadTime",MakeCallback(&BinaryTraceWriter::OnDownloadTime, writerDownloadTime));
+                app->TraceConnectWithoutContext("DownloadTimeFile",MakeCallback(&BinaryTraceWriter::OnDownloadTime, writerDownloadTime));
+        }
+}
+
 
 
 // ******* READ ADJ MATRIX
@@ -0,0 +1,207 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Scheduler benchmark: replays the same sequence of scheduler operations against every scheduler
+// and reports events/s.  The sequence is either recorded from a scenario with
+// ns3::ndn::RecordingScheduler, or generated with the bimodal delays of INFORM runs (short
+// link delays, long PIT/QTAB/retransmission timers, some of which are removed before expiring).
+//
+// ./waf --run "ndn-inform --SchedulerType=ns3::ndn::RecordingScheduler --ns3::ndn::RecordingScheduler::File=events.txt ..."
+// ./waf --run "ndn-scheduler-benchmark --trace=events.txt"
+// ./waf --run "ndn-scheduler-benchmark --events=1000000 --pending=10000 --longFraction=0.2"
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/random-variable-stream.h"
+
+#include "ns3/ndnSIM/utils/ndn-ladder-scheduler.h"
+
+#include <time.h>
+#include <set>
+#include <fstream>
+#include <boost/tokenizer.hpp>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ndn.SchedulerBenchmark");
+
+static inline uint64_t
+NowNs ()
+{
+  struct timespec now;
+  clock_gettime (CLOCK_MONOTONIC, &now);
+  return static_cast<uint64_t> (now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+struct Operation
+{
+  char type; ///< 'i' (Insert), 'n' (RemoveNext) or 'r' (Remove)
+  uint64_t ts;
+  uint32_t uid;
+};
+
+static Scheduler::Event
+ToEvent (const Operation &op)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_ts = op.ts;
+  ev.key.m_uid = op.uid;
+  ev.key.m_context = 0;
+  return ev;
+}
+
+static void
+ReadTrace (const std::string &file, std::vector<Operation> &ops)
+{
+  std::ifstream is (file.c_str ());
+  if (!is.is_open ())
+    NS_FATAL_ERROR ("Cannot open " << file);
+
+  Operation op;
+  while (is >> op.type >> op.ts >> op.uid)
+    {
+      if (op.type != 'i' && op.type != 'n' && op.type != 'r')
+        NS_FATAL_ERROR ("Unknown operation " << op.type << " in " << file);
+      ops.push_back (op);
+    }
+}
+
+static void
+Generate (uint32_t events, uint32_t pending, double longFraction, double shortDelay, double longDelay,
+          double removeFraction, std::vector<Operation> &ops)
+{
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  std::set<std::pair<uint64_t, uint32_t> > scheduled;
+  std::vector<Operation> removable;
+  uint64_t now = 0;
+  uint32_t uid = 0;
+
+  while (ops.size () < events)
+    {
+      if (scheduled.size () >= pending)
+        {
+          // execute the next event, which schedules a new one (hold model)
+          Operation op = { 'n', scheduled.begin ()->first, scheduled.begin ()->second };
+          scheduled.erase (scheduled.begin ());
+          ops.push_back (op);
+          now = op.ts;
+        }
+
+      bool isLong = rand->GetValue () < longFraction;
+      double delay = isLong ? rand->GetValue (0.5, 1.5) * longDelay : rand->GetValue (0, 2) * shortDelay;
+      Operation op = { 'i', now + static_cast<uint64_t> (Seconds (delay).GetTimeStep ()), uid++ };
+      scheduled.insert (std::make_pair (op.ts, op.uid));
+      ops.push_back (op);
+
+      if (isLong && rand->GetValue () < removeFraction)
+        removable.push_back (op);
+      if (!removable.empty () && rand->GetValue () < removeFraction * longFraction)
+        {
+          op = removable.back ();
+          removable.pop_back ();
+          if (scheduled.erase (std::make_pair (op.ts, op.uid)) > 0)
+            {
+              op.type = 'r';
+              ops.push_back (op);
+            }
+        }
+    }
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string trace = "";
+  uint32_t events = 1000000;
+  uint32_t pending = 10000;
+  double longFraction = 0.2;
+  double shortDelay = 0.01;
+  double longDelay = 2.0;
+  double removeFraction = 0.1;
+  std::string schedulers = "ns3::MapScheduler,ns3::HeapScheduler,ns3::ListScheduler,ns3::CalendarScheduler,ns3::ndn::LadderScheduler";
+
+  CommandLine cmd;
+  cmd.AddValue ("trace", "File recorded by ns3::ndn::RecordingScheduler (if empty, operations are generated)", trace);
+  cmd.AddValue ("events", "Number of generated operations", events);
+  cmd.AddValue ("pending", "Number of scheduled events in the generated sequence", pending);
+  cmd.AddValue ("longFraction", "Share of generated events that are timers", longFraction);
+  cmd.AddValue ("shortDelay", "Mean delay of generated link events [s]", shortDelay);
+  cmd.AddValue ("longDelay", "Mean delay of generated timers [s]", longDelay);
+  cmd.AddValue ("removeFraction", "Share of generated timers that are removed before they expire", removeFraction);
+  cmd.AddValue ("schedulers", "Comma-separated list of scheduler classes", schedulers);
+  cmd.Parse (argc, argv);
+
+  // ******* Operation sequence, the same for every scheduler
+  std::vector<Operation> ops;
+  if (trace != "")
+    {
+      ReadTrace (trace, ops);
+      std::cout << "#trace=" << trace;
+    }
+  else
+    {
+      Generate (events, pending, longFraction, shortDelay, longDelay, removeFraction, ops);
+      std::cout << "#events=" << events << " pending=" << pending << " longFraction=" << longFraction
+                << " shortDelay=" << shortDelay << " longDelay=" << longDelay << " removeFraction=" << removeFraction;
+    }
+  uint64_t executed = 0;
+  for (std::vector<Operation>::const_iterator op = ops.begin (); op != ops.end (); op++)
+    {
+      if (op->type == 'n')
+        executed ++;
+    }
+  std::cout << " operations=" << ops.size () << " executed=" << executed << std::endl;
+  std::cout << "#scheduler\tevents/s\tns/operation\tmismatches" << std::endl;
+
+  boost::char_separator<char> separator (",");
+  boost::tokenizer<boost::char_separator<char> > tokens (schedulers, separator);
+  for (boost::tokenizer<boost::char_separator<char> >::iterator type = tokens.begin (); type != tokens.end (); type++)
+    {
+      ObjectFactory factory;
+      factory.SetTypeId (*type);
+      Ptr<Scheduler> scheduler = factory.Create<Scheduler> ();
+
+      // events returned in a different order than recorded (should never happen)
+      uint64_t mismatches = 0;
+      uint64_t start = NowNs ();
+      for (std::vector<Operation>::const_iterator op = ops.begin (); op != ops.end (); op++)
+        {
+          switch (op->type)
+            {
+            case 'i':
+              scheduler->Insert (ToEvent (*op));
+              break;
+            case 'n':
+              if (scheduler->RemoveNext ().key.m_uid != op->uid)
+                mismatches ++;
+              break;
+            case 'r':
+              scheduler->Remove (ToEvent (*op));
+              break;
+            }
+        }
+      uint64_t duration = NowNs () - start;
+
+      std::cout << *type << "\t" << (duration > 0 ? executed * 1e9 / duration : 0)
+                << "\t" << (ops.empty () ? 0 : static_cast<double> (duration) / ops.size ())
+                << "\t" << mismatches << std::endl;
+    }
+
+  return 0;
+}
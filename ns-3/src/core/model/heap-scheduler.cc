@@ -229,7 +229,16 @@ HeapScheduler::Remove (const Event &ev)
           NS_ASSERT (m_heap[i].impl == ev.impl);
           Exch (i, Last ());
           m_heap.pop_back ();
-          TopDown (i);
+          if (i <= Last ())
+            {
+              // the last event may belong either below or above the removed one
+              TopDown (i);
+              while (!IsRoot (i) && IsLessStrictly (i, Parent (i)))
+                {
+                  Exch (i, Parent (i));
+                  i = Parent (i);
+                }
+            }
           return;
         }
     }
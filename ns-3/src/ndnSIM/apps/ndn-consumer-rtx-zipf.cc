@@ -168,11 +168,6 @@ ConsumerRtxZipf::ConsumerRtxZipf ()
   SetRetxTimer(value.Get());
   //SetRetxTimer(Seconds(0.025));
   seq_contenuto = new std::map<std::string, uint32_t > ();
-  num_rtx = new std::map<uint32_t, uint32_t> ();
-  contentInfoSeqNum = new std::map<std::string, contentInfoEntry> ();
-  download_time = new std::map<std::string, DownloadEntry_Chunk> ();
-  download_time_first = new std::map<std::string, DownloadEntry_Chunk> ();
-  download_time_file = new std::map<std::string, DownloadEntry> ();
   m_maxNumRtx = 100;      // Num Max Rtx
 
   NS_LOG_UNCOND("COSTRUTTORE APP!!");
@@ -204,19 +199,7 @@ ConsumerRtxZipf::SetNumberOfContents (uint32_t numOfContents)
 
   NS_LOG_DEBUG (m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double> (m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i+m_q, m_s);
-    }
-
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_zipf = ZipfMandelbrot::Get (m_N, m_q, m_s);
 }
 
 uint32_t
@@ -357,8 +340,8 @@ ConsumerRtxZipf::StartApplication () // Called at time specified by Start
 	  std::string PERCORSO = ss.str();
 	  const char *PATH_C = PERCORSO.c_str();
 	  ss.str("");
-	  request_file.open(PATH_C, std::fstream::in);
-	  if(!request_file){
+	  request_catalog = RequestCatalog::Open (PERCORSO);
+	  if(request_catalog == 0){
 	  	  	std::cout << "\nERRORE: Impossibile leggere dal file dei contenuti!\n" << PATH_C ;
 	 		exit(0);
 	  }
@@ -372,14 +355,10 @@ ConsumerRtxZipf::StopApplication () // Called at time specified by Stop
   NS_LOG_FUNCTION_NOARGS ();
 
   delete seq_contenuto;
-  delete num_rtx;
-  delete contentInfoSeqNum;
-  delete download_time;
-  delete download_time_file;
-  delete download_time_first;
+  m_requests.Clear ();
+  download_time_file.clear ();
 
-  if(request_file)
-        request_file.close();
+  request_catalog = 0;
 
  NS_LOG_UNCOND("STOP APPLICATION"); 
 
@@ -406,25 +385,21 @@ ConsumerRtxZipf::SendPacket ()
   uint32_t contentID;
   uint32_t chunkNum;
   uint32_t seq=std::numeric_limits<uint32_t>::max ();
-  std::string seqStr;
-  std::stringstream seqStream;
 
   uint32_t currentSeq;    // It is assigned both in case of retransmission and in case of a new content.
+  RequestEntry *request = 0;    // State of the request, in case of retransmission.
 
   while (m_retxSeqs.size())
   {
 	  // NS_LOG_UNCOND("SEND PACKET - APP: RETX QUEUE SIZE\t" << m_retxSeqs.size () << "\t" << Simulator::Now());
 	  seq = *m_retxSeqs.begin ();
 
-	  seqStream << seq;
-	  seqStr = seqStream.str();
-
 	  //std::set< std::vector<uint32_t>* >::iterator it;
 	  //it = m_retxSeqs.begin();
-	  contentID = contentInfoSeqNum->find(seqStr)->second.contentID;
-	  chunkNum = contentInfoSeqNum->find(seqStr)->second.chunkNum;
-
-	  seqStream.str("");
+	  request = m_requests.Find (seq);
+	  NS_ASSERT_MSG (request != 0, "Retransmission of a retired request");
+	  contentID = request->contentID;
+	  chunkNum = request->chunkNum;
 
 	  currentSeq = seq;
 
@@ -471,9 +446,7 @@ ConsumerRtxZipf::SendPacket ()
 
   if(newContent || retransmit)
   {
-	  GotoLine(request_file,(contentID));
-	  std::string lineFull;
-	  std::getline(request_file,lineFull);
+	  std::string lineFull = request_catalog->GetLine (contentID);
 
 	  //NS_LOG_UNCOND("APP SENDING NEW INTEREST: " << lineFull);
 
@@ -523,7 +496,7 @@ ConsumerRtxZipf::SendPacket ()
   ss.str("");
 
   Ptr<NameComponents> mainName = Create<NameComponents> (contentName);
-  uint32_t numComponents = mainName->GetComponents().size();
+  uint32_t numComponents = mainName->size();
   std::list<std::string> mainNameLst (numComponents);
   mainNameLst.assign(mainName->begin(), mainName->end());
   mainNameLst.push_back(chunkStrCompl);
@@ -572,29 +545,12 @@ ConsumerRtxZipf::SendPacket ()
          //p->push_back(m_currentChunk);
          //p->operator[](0) = (m_currentContentID);
          //p->operator[](1) = (m_currentChunk);
-    	 num_rtx->insert(std::pair<uint32_t, uint32_t> (currentSeq,1));
-    	 //num_rtx->insert(std::pair<uint32_t, uint32_t> (currentSeq,1));
-
-    	 seqStream << currentSeq;
-    	 seqStr = seqStream.str();
-    	 seqStream.str("");
-
          seq_contenuto->insert(std::pair<std::string, uint32_t > (fullName, currentSeq));   // Bind the chunk name to the relative sequence number
-         //contentInfoSeqNum->insert(std::pair<std::vector<uint32_t>*, uint32_t> (p,m_seq));
-         contentInfoSeqNum->insert(std::pair<std::string, contentInfoEntry> (seqStr, contentInfoEntry(m_currentContentID, m_currentChunk)));
-
-     	 if(m_currentChunk == 0)     // If it is the FIRST CHUNK, all the structures must be updated: download_time_first,
-     		 	 	 	 	   // download_time, and download_time_file.
-     	 {
-     		download_time_first->insert(std::pair<std::string,DownloadEntry_Chunk> (fullName, DownloadEntry_Chunk(Simulator::Now(), Simulator::Now(), MicroSeconds(0))));
-     		download_time->insert(std::pair<std::string,DownloadEntry_Chunk> (fullName, DownloadEntry_Chunk(Simulator::Now(), Simulator::Now(), MicroSeconds(0))));
+         m_requests.Insert (currentSeq, RequestEntry (m_currentContentID, m_currentChunk, Simulator::Now()));
 
-     		// In the 'download_time_file' map, only the content name is inserted (without the chunk part).
-            download_time_file->insert(std::pair<std::string,DownloadEntry> (contentName, DownloadEntry(Simulator::Now(), MicroSeconds(0),m_expChunk,0,0)) );
-     	 }
-     	 else
+     	 if(m_currentChunk == 0)     // If it is the FIRST CHUNK, the download of the entire content starts.
      	 {
-     		download_time->insert(std::pair<std::string,DownloadEntry_Chunk> (fullName, DownloadEntry_Chunk(Simulator::Now(), Simulator::Now(), MicroSeconds(0))));
+            download_time_file.insert(std::pair<uint32_t,DownloadEntry> (m_currentContentID, DownloadEntry(Simulator::Now(), MicroSeconds(0),m_expChunk,0,0)) );
      	 }
      	 //delete p;
      }
@@ -607,25 +563,7 @@ ConsumerRtxZipf::SendPacket ()
 
           //NS_LOG_UNCOND("SEND PACKET - APP: Sending a RETRANSMISSION\t" << fullName << "\t" << Simulator::Now());
 
-          if(chunkNum != 0)     // It is the FIRST Chunk that needs to be retransmitted
-          {    
-                  if(download_time_first->find(fullName)!=download_time_first->end())
-                          download_time_first->find(fullName)->second.sentTimeChunk_New = Simulator::Now();
-                  else 
-                          NS_LOG_UNCOND("Impossible to find the retransmitted content in the map!!");
-     
-                  if(download_time->find(fullName)!=download_time->end())        // The first chunk is also considered as a general chunk
-                          download_time->find(fullName)->second.sentTimeChunk_New = Simulator::Now();
-                  else 
-                          NS_LOG_UNCOND("Impossible to find the retransmitted content in the map!!");
-          }    
-          else // It is NOT the FIRST Chunk that needs to be retransmitted
-          {    
-                  if(download_time->find(fullName)!=download_time->end())
-                          download_time->find(fullName)->second.sentTimeChunk_New = Simulator::Now();
-                  else 
-                          NS_LOG_UNCOND("Impossible to find the retransmitted content in the map!!");
-          }    
+          request->sentTimeChunk_New = Simulator::Now();
   }
 
   Ptr<Interest> interestHeader = Create<Interest>();
@@ -677,6 +615,23 @@ ConsumerRtxZipf::SendPacket ()
 ///////////////////////////////////////////////////
 
 
+// Name of the content of the chunk (i.e., without the chunk component)
+static std::string
+GetContentWithoutChunk (const std::string &chunkName)
+{
+  Ptr<NameComponents> receivedContent = Create<NameComponents> (chunkName);
+  std::list<std::string> nameReceivedContent;
+  nameReceivedContent.assign(receivedContent->begin(), receivedContent->end());
+  nameReceivedContent.pop_back();
+
+  std::stringstream ss;
+  for(std::list<std::string>::iterator it = nameReceivedContent.begin(); it != nameReceivedContent.end(); it++)
+  {
+        ss << "/" << *it;
+  }
+  return ss.str();
+}
+
 void
 ConsumerRtxZipf::OnContentObject (const Ptr<const ContentObject> &contentObject,
                                Ptr<Packet> payload)
@@ -699,183 +654,109 @@ ConsumerRtxZipf::OnContentObject (const Ptr<const ContentObject> &contentObject,
   // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\tON DATA - APP: Received CONTENT OBJECT\t" << cont_ric << "\t" << Simulator::Now());
 
 
-  // Retrieve the ContentID and the ChunkNumber associated to the received content
-  //std::vector<uint32_t>* contentInfo = seq_contenuto->find(cont_ric)->second;
-  uint32_t seqNumRic = seq_contenuto->find(cont_ric)->second;
+  // Retrieve the sequence number associated to the received content
+  std::map<std::string, uint32_t >::iterator seqEntry = seq_contenuto->find(cont_ric);
+  if(seqEntry == seq_contenuto->end())      // Duplicate chunk, or chunk already dropped after the maximum number of retransmissions
+  {
+          NS_LOG_DEBUG ("No pending request for " << cont_ric);
+          return;
+  }
+  uint32_t seqNumRic = seqEntry->second;
 
-  std::string seqStr;
-  ss << seqNumRic;
-  seqStr = ss.str();
-  ss.str("");
+  RequestEntry *request = m_requests.Find (seqNumRic);
+  NS_ASSERT_MSG (request != 0, "Request state is retired together with the name of the request");
 
   // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\tON DATA - APP: Received CONTENT OBJECT with SeqNum\t" << seqNumRic << "\t" << Simulator::Now());
 
-  //std::map<std::string, const std::vector<uint32_t>*>::iterator itMap;
-
-  //std::vector<uint32_t>* contentInfo = new std::vector<uint32_t>();
-  //itMap = contentInfoSeqNum->find(seqStr);
-  //if(contentInfoSeqNum->find(seqStr)!=contentInfoSeqNum->end())
-  //{
-          //contentInfo->push_back( (*itMap).second->operator [](0));   // Sequential seq num associated to contentInfo
-          //contentInfo->push_back( (*itMap).second->operator [](1));
-
-        //  NS_LOG_UNCOND("ECCO!!");
-  //}
-
-  //else
-  //{
-        //  NS_LOG_UNCOND("CAZOOOOOO!!!!");
-        //  return;
-  //}
-
-  //uint32_t contentID = contentInfoSeqNum->find(seqStr)->second.contentID;
-  //uint32_t chunkNum = contentInfoSeqNum->find(seqStr)->second.chunkNum;
-
-  //NS_LOG_UNCOND("ON DATA - APP: Received CONTENT OBJECT with SeqNum\t" << seqNumRic << "\tand content ID: "<< contentID << "\tand chunk Num: "<< chunkNum << "\t" << Simulator::Now());
-
-
   // Print a LOG MSG every 100 chunks.
   if((seqNumRic % 500) == 0)
 
           NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t APP-LAYER RECEIVED DATA:\t" << cont_ric << "\t" << Simulator::Now().GetMicroSeconds());
 
   // Erase the association content_name <-> seq number
-  seq_contenuto->erase(cont_ric);
+  seq_contenuto->erase(seqEntry);
+
+  // ** The download time of the chunk
+  Time downloadTime = (Simulator::Now() - request->sentTimeChunk_New)+request->incrementalTime;
 
   // *** The SEEK TIME should be calculated only concerning the FIRST Chunk.
-  if(download_time_first->find(cont_ric)!=download_time_first->end())
+  if(request->chunkNum == 0)
   {
-        Time firstTxTime = download_time_first->find(cont_ric)->second.sentTimeChunk_First;
-
-        Time lastTxTime = download_time_first->find(cont_ric)->second.sentTimeChunk_New;
-
-        Time downloadTime = (Simulator::Now() - lastTxTime)+download_time_first->find(cont_ric)->second.incrementalTime;
+        Time firstTxTime = request->sentTimeChunk_First;
 
         // It is the same Tracing File both for the Download Time and for the Hop Count
        std::string nodeType = this->GetNode()->GetObject<ForwardingStrategy>()->GetNodeType();
 
         m_downloadTime (&cont_ric_app, firstTxTime.GetMicroSeconds(), downloadTime.GetMicroSeconds(), dist, "FIRST", nodeType);
-
-        download_time_first->erase(cont_ric);
   }
 
   // Checking the received Chunk; Update the structure "download_time_file" and, eventually, calculate the file download time
 
-  Ptr<NameComponents> receivedContent = Create<NameComponents> (cont_ric);
-  uint32_t numComponents = receivedContent->GetComponents().size();
-  std::list<std::string> nameReceivedContent (numComponents);
-  nameReceivedContent.assign(receivedContent->begin(), receivedContent->end());
-  std::list<std::string>::iterator it = nameReceivedContent.end();
-
-  --it;
-  // Extract the chunk part of the name.
-  std::string chunkString = *it;
-
-  it = nameReceivedContent.begin();
-  nameReceivedContent.pop_back();
-  --numComponents;
-
-  for(uint32_t t = 0; t < numComponents; t++)
-  {
-        ss << "/" << *it;
-        it++;
-  }
-  std::string contentWithoutChunk = ss.str();
-  ss.str("");
-
-  // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t Content WITHOUT CHUNK:\t" << contentWithoutChunk);
   // Control if the respective content of the received chunk has been already deleted from the structure.
   // This can happen when one ore more chunks are received after the last chunk.
-  if(download_time_file->find(contentWithoutChunk)!=download_time_file->end())
+  std::map<uint32_t, DownloadEntry>::iterator file = download_time_file.find(request->contentID);
+  if(file != download_time_file.end())
   {
-        uint32_t totNumChunks = download_time_file->find(contentWithoutChunk)->second.expNumChunk;
-
-        // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t Content:\t" << contentWithoutChunk << " with " << totNumChunks << " expected chunks presente nella mappa");
-
-        std::string checkChunk = "s_";
-        ss << checkChunk << (totNumChunks-1);
-        checkChunk = ss.str();
+        uint32_t totNumChunks = file->second.expNumChunk;
 
-        // NS_LOG_UNCOND("Content:\t" << contentWithoutChunk << " with extracted chunk number:\t" << chunkString << "\t and expected chunk string:\t" << checkChunk);
+        // NS_LOG_UNCOND("Content ID:\t" << request->contentID << " with extracted chunk number:\t" << request->chunkNum << "\t and expected chunks:\t" << totNumChunks);
 
-        if (chunkString.compare(checkChunk) != 0)    // The received chunk does not correspond to the last one; so, only the counter of received chunk is incremented.
+        if (request->chunkNum != totNumChunks-1)     // The received chunk does not correspond to the last one; so, only the counter of received chunk is incremented.
                                                      // If exactly the last chunk is lost, the respective contents will stay into the download_time_file structure.
         {
                 // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t IS NOT THE LAST CHUNK!");
 
-                download_time_file->find(contentWithoutChunk)->second.rcvNumChunk++;
+                file->second.rcvNumChunk++;
 
                 // ** The download time of the single chunk is calculated and added to the sum the refers to the respective content
-                Time incrementTime = Simulator::Now() - download_time->find(cont_ric)->second.sentTimeChunk_New;
-                if(incrementTime > NanoSeconds(100000000)) // vuol dire che la ritrasmissione schedulata non è stata ancora effettuata.
-                        incrementTime = NanoSeconds(100000000) + download_time->find(cont_ric)->second.incrementalTime;
+                Time incrementTime = Simulator::Now() - request->sentTimeChunk_New;
+                if(incrementTime > NanoSeconds(100000000)) // vuol dire che la ritrasmissione schedulata non  stata ancora effettuata.
+                        incrementTime = NanoSeconds(100000000) + request->incrementalTime;
                 else
-                        incrementTime = (Simulator::Now() - download_time->find(cont_ric)->second.sentTimeChunk_New)+download_time->find(cont_ric)->second.incrementalTime;
-
-                //NS_LOG_UNCOND("Incremental Time of Content: " << contentWithoutChunk << "\t" << incrementTime);
-
-                //Time temp = download_time_file->find(contentWithoutChunk)->second.downloadTime;
-
-                //NS_LOG_UNCOND("Partial Download Time of Content BEFORE: " << contentWithoutChunk << "\t" << temp);
-
-                download_time_file->find(contentWithoutChunk)->second.downloadTime+=incrementTime;
-
-                //temp = download_time_file->find(contentWithoutChunk)->second.downloadTime;
+                        incrementTime = downloadTime;
 
-                //NS_LOG_UNCOND("Partial Download Time of Content AFTER: " << contentWithoutChunk << "\t" << temp);
+                //NS_LOG_UNCOND("Incremental Time of Content ID: " << request->contentID << "\t" << incrementTime);
 
-                download_time_file->find(contentWithoutChunk)->second.distance+=dist;
-                download_time->erase(cont_ric);
+                file->second.downloadTime+=incrementTime;
+                file->second.distance+=dist;
         }
         else    // The received chunk is the LAST one. If rcvChunks == expChunks --> calculate Download Time;
                 // otherwise, the content is marked as lost.
         {
                 // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t IS THE LAST CHUNK");
 
-                uint32_t cksRcv = download_time_file->find(contentWithoutChunk)->second.rcvNumChunk;
+                std::string contentWithoutChunk = GetContentWithoutChunk (cont_ric);
+
+                uint32_t cksRcv = file->second.rcvNumChunk;
                 uint32_t cksExp = totNumChunks - 1;
 
                 if(cksRcv == cksExp)
                 {
                         // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t num RECEIVED chunks:\t" << cksRcv << " equal to num of expected chunks:\t" << cksExp);
-                        download_time_file->find(contentWithoutChunk)->second.rcvNumChunk++;
+                        file->second.rcvNumChunk++;
 
                         // ** The download time of the single chunk is calculated and added to the sum the refers to the respective content
-                        Time incrementTime = Simulator::Now() - download_time->find(cont_ric)->second.sentTimeChunk_New;
-                        //  if(incrementTime > NanoSeconds(100000000)) // vuol dire che la ritrasmissione schedulata non è stata ancora effettuata.
-                        // incrementTime = NanoSeconds(100000000) + download_time->find(cont_ric)->second.incrementalTime;
-                        //  else
-                        // incrementTime = (Simulator::Now() - download_time->find(cont_ric)->second.sentTimeChunk_New)+download_time->find(cont_ric)->second.incrementalTime;
-
-                        //NS_LOG_UNCOND("Incremental Time Last Chunk:\t" << incrementTime);
-
-                        download_time_file->find(contentWithoutChunk)->second.downloadTime+=incrementTime;
-                        download_time_file->find(contentWithoutChunk)->second.distance+=dist;
-                        download_time->erase(cont_ric);
-
-                        //Time temp = download_time_file->find(contentWithoutChunk)->second.downloadTime;
-
-                        //NS_LOG_UNCOND("Partial Download Time of Content: " << contentWithoutChunk << "\t" << temp);
+                        Time incrementTime = Simulator::Now() - request->sentTimeChunk_New;
 
+                        file->second.downloadTime+=incrementTime;
+                        file->second.distance+=dist;
 
-                        Time downloadTimeFinal = download_time_file->find(contentWithoutChunk)->second.downloadTime;
-                        Time firstChunkTime = download_time_file->find(contentWithoutChunk)->second.sentTimeFirst;
-                        uint32_t meanHitDistance = round(download_time_file->find(contentWithoutChunk)->second.distance / totNumChunks);
+                        Time downloadTimeFinal = file->second.downloadTime;
+                        Time firstChunkTime = file->second.sentTimeFirst;
+                        uint32_t meanHitDistance = round(file->second.distance / totNumChunks);
 
                         std::string nodeType = this->GetNode()->GetObject<ForwardingStrategy>()->GetNodeType();
 
-                        //m_downloadTimeFile (&contentWithoutChunk, firstChunkTime.GetMicroSeconds(), downloadTimeFinal.GetMicroSeconds(), meanHitDistance, "FILE", nodeType);
                         m_downloadTime (&contentWithoutChunk, firstChunkTime.GetMicroSeconds(), downloadTimeFinal.GetMicroSeconds(), meanHitDistance, "FILE", nodeType);
 
-                        download_time_file->erase(contentWithoutChunk);
+                        download_time_file.erase(file);
                 }
                 else    // One or more chunks have been not received; so the entire content is marked as LOST
                 {
                         // NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t Content Name:\t" << contentWithoutChunk << "\t one or more stuff are lost");
 
-                        Time firstChunkTime = download_time_file->find(contentWithoutChunk)->second.sentTimeFirst;
-                        download_time_file->erase(contentWithoutChunk);
-                        download_time->erase(cont_ric);
+                        Time firstChunkTime = file->second.sentTimeFirst;
+                        download_time_file.erase(file);
 
                         // APP-LEVEL Tracing of Incomplete Files
                        std::string nodeType = this->GetNode()->GetObject<ForwardingStrategy>()->GetNodeType();
@@ -883,11 +764,9 @@ ConsumerRtxZipf::OnContentObject (const Ptr<const ContentObject> &contentObject,
                 }
         }
   }
-  else
-  {
-          download_time->erase(cont_ric);
-  }
 
+  // The request is completed
+  m_requests.Erase (seqNumRic);
 
   m_seqLifetimes.erase (seqNumRic);
 
@@ -898,9 +777,6 @@ ConsumerRtxZipf::OnContentObject (const Ptr<const ContentObject> &contentObject,
 
   m_retxSeqs.erase (seqNumRic);
 
-  num_rtx->erase(seqNumRic);
-  //num_rtx->erase(contentInfoSeqNum->find(seqNumRic)->second);
-
   m_rtt->AckSeq (SequenceNumber32 (seqNumRic+1));
 }
 
@@ -916,7 +792,7 @@ ConsumerRtxZipf::OnNack (const Ptr<const Interest> &interest, Ptr<Packet> origPa
   // NS_LOG_FUNCTION (interest->GetName ());
 
   // NS_LOG_INFO ("Received NACK: " << boost::cref(*interest));
-  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetComponents ().back ());
+  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetLastComponent ());
   NS_LOG_INFO ("< NACK for " << seq);
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << "NACK for " << seq << "\n";
 
@@ -944,22 +820,17 @@ ConsumerRtxZipf::OnTimeout (uint32_t seqNum)
 	  //NS_LOG_UNCOND("NODONODO:\t" << Application::GetNode()->GetId() << "\tNumero ritrasmissione:\t" << num_rtx->find(sequenceNumber)->second << "\t Num Max:\t" << m_maxNumRtx << "\tTempo:\t" << Simulator::Now ());
 
 	  std::stringstream ss_rto;
-	  std::string seqNumStr;
-	  ss_rto << seqNum;
-	  seqNumStr = ss_rto.str();
-	  ss_rto.str("");
 
-	  //const std::vector<uint32_t>* contentInfo = contentInfoSeqNum->find(seqNumStr)->second;
 	  // Retrieve the correspondent line
-	  uint32_t contentID = contentInfoSeqNum->find(seqNumStr)->second.contentID;
-	  uint32_t chunkNumber = contentInfoSeqNum->find(seqNumStr)->second.chunkNum;
+	  RequestEntry *request = m_requests.Find (seqNum);
+	  NS_ASSERT_MSG (request != 0, "Timeout of a retired request");
+	  uint32_t contentID = request->contentID;
+	  uint32_t chunkNumber = request->chunkNum;
 
 	  //NS_LOG_UNCOND("APP - RTX: Content ID: " << contentID);
 	  //NS_LOG_UNCOND("APP - RTX: Chunk number: " << chunkNumber);
 
-	  GotoLine(request_file, (contentID));
-	  std::string line_rto;
-	  std::getline(request_file,line_rto);
+	  std::string line_rto = request_catalog->GetLine (contentID);
 
 	  // Retrieve the content name
 
@@ -976,7 +847,7 @@ ConsumerRtxZipf::OnTimeout (uint32_t seqNum)
 	  ss_rto.str("");
 
       Ptr<NameComponents> rtoContent = Create<NameComponents> (contentNameRto);
-      uint32_t numComponents = rtoContent->GetComponents().size();
+      uint32_t numComponents = rtoContent->size();
       std::list<std::string> nameRtoContent (numComponents);
       nameRtoContent.assign(rtoContent->begin(), rtoContent->end());
       nameRtoContent.push_back(chunkStr);
@@ -994,31 +865,14 @@ ConsumerRtxZipf::OnTimeout (uint32_t seqNum)
 
 
 	  // ** Calculate and Update the new Incremental Time for the respective chunk
-	  Time new_increment = Simulator::Now() - download_time->find(fullNameRto)->second.sentTimeChunk_New;
-
-	  if(chunkNumber != 0)     // It is the First Chunk.
-		  download_time_first->find(fullNameRto)->second.incrementalTime+=new_increment;
-	  else
-		  download_time->find(fullNameRto)->second.incrementalTime+=new_increment;
+	  Time new_increment = Simulator::Now() - request->sentTimeChunk_New;
+	  request->incrementalTime+=new_increment;
 
 	  // ** Check if another Retransmission is Allowed.
-	  if(num_rtx->find(seqNum)->second < m_maxNumRtx)
-	 //if(num_rtx->find(trial)->second < m_maxNumRtx)
+	  if(request->numRtx < m_maxNumRtx)
 	  {
-	        // Increment the Rtx Counter (with another check of the presence of the element)
-	        std::pair<std::map<uint32_t,uint32_t>::iterator,bool> ret;
-	        ret=num_rtx->insert (std::pair<uint32_t,uint32_t>(seqNum,1) );
-	        if(ret.second==false)
-	        {
-	        	uint32_t counter = num_rtx->find(seqNum)->second;
-	            num_rtx->operator[](seqNum)= counter+1;          // *** NB  VERIFICARE BENE
-	        }
-	        else
-	        {
-	            NS_LOG_UNCOND("ERROR INSIDE THE RTX MAP! ELEMENT NOT FOUND");
-	        }
-
-	        //uint32_t seqNumber = contentInfoSeqNum->find(&seqNum)->second;
+	        // Increment the Rtx Counter
+	        request->numRtx++;
 
 	        //NS_LOG_UNCOND("ON TIMEOUT - CONTENT INFO SEQ NUM: \t" << seqNum << "\t" << Simulator::Now());
 
@@ -1029,23 +883,19 @@ ConsumerRtxZipf::OnTimeout (uint32_t seqNum)
 	  }
 	  else
 	  {
-            uint32_t numChunkTot = download_time_file->find(contentNameRto)->second.expNumChunk;
-	        std::string checkChunk = "s_";
-	        ss_rto << checkChunk << (numChunkTot-1);
-	        checkChunk = ss_rto.str();
-	        ss_rto.str("");
-	        if (chunkStr.compare(checkChunk) == 0)  // I'm eliminating the last chunk of the content; so, the corespondent file is erased
+	        std::map<uint32_t, DownloadEntry>::iterator file = download_time_file.find(contentID);
+	        if (file != download_time_file.end() && chunkNumber == file->second.expNumChunk-1)  // I'm eliminating the last chunk of the content; so, the corespondent file is erased
 	                                                   // too from the structure file_download_time.
-	                download_time_file->erase(contentNameRto);
+	                download_time_file.erase(file);
 
-	        Time firstTxTime = download_time->find(fullNameRto)->second.sentTimeChunk_First;
+	        Time firstTxTime = request->sentTimeChunk_First;
 	     
 	        // APP-LEVEL Tracing for eliminated files
 	     	std::string nodeType = this->GetNode()->GetObject<ForwardingStrategy>()->GetNodeType();
 	        m_numMaxRtx(&fullNameRto, firstTxTime.GetMicroSeconds(), "ELM", nodeType);
 	      
-            download_time->erase(fullNameRto);
-	        num_rtx->erase(seqNum);
+	        // The request is dropped
+	        m_requests.Erase(seqNum);
 	        seq_contenuto->erase(fullNameRto);
 	        m_retxSeqs.erase(seqNum);
 	        m_seqLifetimes.erase (seqNum);
@@ -1054,13 +904,7 @@ ConsumerRtxZipf::OnTimeout (uint32_t seqNum)
 	        m_seqTimeouts.erase (seqNum);
 	        //NS_LOG_UNCOND("ON TIMEOUT - APP: SEQ TIMEOUT SIZE AFTER\t" << m_seqTimeouts.size() << "\t" << Simulator::Now());
 
-
-	        //uint32_t seqNumber = contentInfoSeqNum->find(&seqNum)->second;
-
-
 	        m_rtt->AckSeq (SequenceNumber32 (seqNum));
-	        if(download_time_first->find(fullNameRto)!= download_time_first->end())     /// **** MODIFICA
-	        	download_time_first->erase(fullNameRto);
 	  }
 	  ScheduleNextPacket ();
 }
@@ -1093,7 +937,6 @@ uint32_t
 ConsumerRtxZipf::GetNextSeq()
 {
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_SeqRng.GetValue();
   while (p_random == 0)
@@ -1102,29 +945,12 @@ ConsumerRtxZipf::GetNextSeq()
     }
   //if (p_random == 0)
   NS_LOG_LOGIC("p_random="<<p_random);
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-      if (p_random <= p_sum)
-        {
-          content_index = i;
-          break;
-        } //if
-    } //for
+  content_index = m_zipf->GetContent (p_random);   // smallest i with p_random <= p_cum[i]
   //content_index = 1;
   NS_LOG_DEBUG("RandomNumber="<<content_index);
   return content_index;
 }
 
-
-std::ifstream& ConsumerRtxZipf::GotoLine(std::ifstream& file, uint32_t num) {
-  file.seekg(std::ios::beg);
-  for(uint32_t i=0; i < num - 1; ++i){
-      file.ignore(std::numeric_limits<std::streamsize>::max(),'\n');
-  }
-  return file;
-}
-
 } // namespace ndn
 } // namespace ns3
 
@@ -28,6 +28,9 @@
 #include "ns3/nstime.h"
 #include "ns3/data-rate.h"
 #include "../../internet/model/rtt-estimator.h"
+#include "../utils/ndn-request-catalog.h"
+#include "../utils/ndn-zipf-mandelbrot.h"
+#include "../utils/ndn-seq-window.h"
 
 #include <set>
 #include <map>
@@ -153,54 +156,45 @@ protected:
   double
   GetS () const;
 
-  /**
-   * \brief Allows the positioning in a file at a specified line.
-   */
-  std::ifstream& GotoLine(std::ifstream& file, uint32_t num);
-
 protected:
   //  *** (MT) ***
-  std::ifstream request_file;    ///< @brief ifstream associated to the file containing the requests of the client.
+  Ptr<const RequestCatalog> request_catalog;    ///< @brief indexed file containing the requests of the client (shared by all the clients).
   std::map<std::string, uint32_t > *seq_contenuto;    ///< @brief map the content name to the sequence number.
 
   uint32_t m_maxNumRtx;       ///< @brief maximum number of allowed retransmission.
-  std::map< uint32_t, uint32_t> *num_rtx;  ///< @brief map the sequence number of the content to the relative number of retransmission.
-
-  struct contentInfoEntry
-  {
-	  contentInfoEntry(uint32_t _contentID, uint32_t _chunkNum):contentID(_contentID), chunkNum(_chunkNum) {}
-
-	  uint32_t contentID;
-	  uint32_t chunkNum;
-  };
 
-  std::map<std::string, contentInfoEntry> *contentInfoSeqNum;  ///< @brief map the content info to the sequencial sequence number.
-
-  // *** (MT) Structure used to track the DOWNLOAD TIME of a single chunk; it is needed to eliminate the time elapsed between the  ****
-           // effective retransmission of an Interest and its scheduling.
+  // *** (MT) State of every outstanding request (i.e., chunk); it also tracks the DOWNLOAD TIME of the chunk, and it is needed
+           // to eliminate the time elapsed between the effective retransmission of an Interest and its scheduling.
   /*
-   *  - sentTime_First = time when the Interest is sent.
-   *  - sentTime_New = time updated every time there is a retransmission.
+   *  - contentID = line of the request file of the content.
+   *  - chunkNum = chunk number of the request.
+   *  - numRtx = number of transmissions of the Interest.
+   *  - sentTimeChunk_First = time when the Interest is sent.
+   *  - sentTimeChunk_New = time updated every time there is a retransmission.
    *  - incrementalTime = it is initialized to '0'; when the RTO elapses, the increment is calculated as the current time (i.e., when the RTO elapses) - sending time.
    *  					  this value is added to the old increment.
    *
-   *  When the corresponding Chunk is received, the Download Time is calculated as " (Now - sentTime_New)+incrementalTime.
+   *  When the corresponding Chunk is received, the Download Time is calculated as " (Now - sentTimeChunk_New)+incrementalTime.
+   *  For the first chunk of a content, it is also the SEEK TIME of the content.
    */
 
-  struct DownloadEntry_Chunk
+  struct RequestEntry
   {
-	  DownloadEntry_Chunk (Time _sentTimeChunk_First, Time _sentTimeChunk_New, Time _incrementalTime): sentTimeChunk_First(_sentTimeChunk_First), sentTimeChunk_New(_sentTimeChunk_New), incrementalTime(_incrementalTime) {}
+	  RequestEntry () : contentID (0), chunkNum (0), numRtx (0) {}
+	  RequestEntry (uint32_t _contentID, uint32_t _chunkNum, Time _sentTime) : contentID (_contentID), chunkNum (_chunkNum), numRtx (1), sentTimeChunk_First (_sentTime), sentTimeChunk_New (_sentTime), incrementalTime (Seconds (0)) {}
 
+	  uint32_t contentID;
+	  uint32_t chunkNum;
+	  uint32_t numRtx;
 	  Time sentTimeChunk_First;
 	  Time sentTimeChunk_New;
 	  Time incrementalTime;
   };
 
-  std::map<std::string, DownloadEntry_Chunk> *download_time_first;       ///< @brief map the content name of the first chunk to its download entry. It is needed to calculate the SEEK TIME of a Content.
-  std::map<std::string, DownloadEntry_Chunk> *download_time;		     ///< @brief map the content name of every chunk to their download entry.
+  SeqWindow<RequestEntry> m_requests;     ///< @brief state of the outstanding requests, indexed by sequence number. It is retired when the chunk is received or dropped.
 
   // *** (MT) Structure used to track the DOWNLOAD TIME of an entire content ***
-  /* It is indexed through the content name of the file (i.e., excluding the last chunk component)
+  /* It is indexed through the content ID (i.e., the line of the request file of the content)
    *
    *  - sentTimeFirst = time when the first Interest is sent.
    *  - downloadTime  = download time of the entire file.
@@ -222,7 +216,7 @@ protected:
 
   };
 
-  std::map<std::string, DownloadEntry> *download_time_file;     ///< @brief map the content name of every file to their download entry.
+  std::map<uint32_t, DownloadEntry> download_time_file;     ///< @brief map the content ID of every file being downloaded to its download entry.
 
   UniformVariable m_rand; ///< @brief nonce generator
 
@@ -249,7 +243,7 @@ protected:
   uint32_t m_N;  //number of the contents
   double m_q;  //q in (k+q)^s
   double m_s;  //s in (k+q)^s
-  std::vector<double> m_Pcum;  //cumulative probability
+  Ptr<const ZipfMandelbrot> m_zipf;  //cumulative probability (shared)
   UniformVariable m_SeqRng; //RNG
 
 
@@ -143,8 +143,6 @@ ConsumerRtx::ConsumerRtx ()
   SetRetxTimer(value.Get());
   //SetRetxTimer(Seconds(0.025));
   seq_contenuto = new std::map<std::string, uint32_t> ();
-  num_rtx = new std::map<uint32_t, uint32_t> ();
-  download_time = new std::map<std::string, DownloadEntry_Chunk> ();
   m_maxNumRtx = 100;      // Num Max Rtx
 }
 
@@ -267,8 +265,8 @@ ConsumerRtx::StartApplication () // Called at time specified by Start
 	  std::string PERCORSO = ss.str();
 	  const char *PATH_C = PERCORSO.c_str();
 	  ss.str("");
-	  request_file.open(PATH_C, std::fstream::in);
-	  if(!request_file){
+	  request_catalog = RequestCatalog::Open (PERCORSO);
+	  if(request_catalog == 0){
 	  	  	std::cout << "\nERRORE: Impossibile leggere dal file dei contenuti!\n" << PATH_C << "\t" << sim << "\t" << st.Get();
 	 		exit(0);
 	  }
@@ -282,11 +280,9 @@ ConsumerRtx::StopApplication () // Called at time specified by Stop
   NS_LOG_FUNCTION_NOARGS ();
 
   delete seq_contenuto;
-  delete num_rtx;
-  delete download_time;
+  m_requests.Clear ();
 
-  if(request_file)
-        request_file.close();
+  request_catalog = 0;
 
  NS_LOG_UNCOND("STOP APPLICATION"); 
 
@@ -340,9 +336,7 @@ ConsumerRtx::SendPacket ()
    *       exp_num_chunk = num of chunks of the content, for the first chunk, otherwise is 0.
    */
 
-  GotoLine(request_file,(seq+1));
-  std::string line;
-  std::getline(request_file,line);
+  std::string line = request_catalog->GetLine (seq+1);
 
   if(line.empty())
     return;
@@ -368,16 +362,16 @@ ConsumerRtx::SendPacket ()
      else     // Different content
      {
          //NS_LOG_UNCOND("Content to ask:\t" << contenutChunk << "\t with exp_num_chunks:\t" << expChunk_string);
-         num_rtx->insert(std::pair<uint32_t, uint32_t> (seq,1));
          seq_contenuto->insert(std::pair<std::string,uint32_t>(line,seq));   // Bind the chunk name to the relative sequence number
-     	 download_time->insert(std::pair<std::string,DownloadEntry_Chunk> (line, DownloadEntry_Chunk(Simulator::Now(), Simulator::Now(), MicroSeconds(0))));
+         m_requests.Insert (seq, RequestEntry (Simulator::Now()));
      }
   }
 
   else    //  (MT) It IS a retransmission; in this case, the new "sent_time" must be updated.
   {
-	  if(download_time->find(line)!=download_time->end())
-		  download_time->find(line)->second.sentTimeChunk_New = Simulator::Now();
+	  RequestEntry *request = m_requests.Find (seq);
+	  if(request != 0)
+		  request->sentTimeChunk_New = Simulator::Now();
 	  else
 		  NS_LOG_UNCOND("Impossible to find the retransmitted content in the map!!");
   }
@@ -433,31 +427,36 @@ ConsumerRtx::OnContentObject (const Ptr<const ContentObject> &contentObject,
   ss << contentObject -> GetName();
   const std::string cont_ric = ss.str();
   std::string cont_ric_app = ss.str();
-  uint32_t seq_ric = seq_contenuto->find(cont_ric)->second;   // Retrieve the sequence number associated to the received content
   ss.str("");
 
+  std::map<std::string, uint32_t>::iterator seqEntry = seq_contenuto->find(cont_ric);
+  if(seqEntry == seq_contenuto->end())      // Duplicate chunk, or chunk already dropped after the maximum number of retransmissions
+  {
+	  NS_LOG_DEBUG ("No pending request for " << cont_ric);
+	  return;
+  }
+  uint32_t seq_ric = seqEntry->second;   // Retrieve the sequence number associated to the received content
+
   if((seq_ric % 100) == 0)   // Print a log message every 100 chunks.
 
           NS_LOG_UNCOND("NODE:\t" << Application::GetNode()->GetId() << "\t APP-LAYER RECEIVED DATA:\t" << cont_ric << "\t" << Simulator::Now().GetMicroSeconds());
 
-  seq_contenuto->erase(cont_ric);           // Erase the association content_name <-> seq number
+  seq_contenuto->erase(seqEntry);           // Erase the association content_name <-> seq number
 
-
-  if(download_time->find(cont_ric)!=download_time->end())
+  RequestEntry *request = m_requests.Find (seq_ric);
+  if(request != 0)
   {
-	  //int64_t tempo_invio = download_time_first->find(cont_ric)->second;
-	  Time tempo_primo_invio = download_time->find(cont_ric)->second.sentTimeChunk_First;
+	  Time tempo_primo_invio = request->sentTimeChunk_First;
 
-	  Time tempo_ultimo_invio = download_time->find(cont_ric)->second.sentTimeChunk_New;
+	  Time tempo_ultimo_invio = request->sentTimeChunk_New;
 
-      Time tempo_download = (Simulator::Now() - tempo_ultimo_invio)+download_time->find(cont_ric)->second.incrementalTime;
+      Time tempo_download = (Simulator::Now() - tempo_ultimo_invio)+request->incrementalTime;
 
 	  // LE INFO DEL TEMPO DI DOWNLOAD E DEL HOP COUNT VENGONO INSERITE IN UN UNICO TRACING FILE.
       //m_downloadTime (&cont_ric_app, tempo_primo_invio.GetMicroSeconds(), tempo_download.GetMicroSeconds(), dist);
       m_downloadTime (&cont_ric_app, tempo_primo_invio.GetMicroSeconds(), tempo_download.GetMicroSeconds(), dist, "First");
 
-      download_time->erase(cont_ric);
-	  //download_time->erase(cont_ric);
+      m_requests.Erase (seq_ric);
   }
   else
   {
@@ -470,8 +469,6 @@ ConsumerRtx::OnContentObject (const Ptr<const ContentObject> &contentObject,
   m_seqTimeouts.erase (seq_ric);
   m_retxSeqs.erase (seq_ric);
 
-  num_rtx->erase(seq_ric);
-
   m_rtt->AckSeq (SequenceNumber32 (seq_ric+1));
 }
 
@@ -487,7 +484,7 @@ ConsumerRtx::OnNack (const Ptr<const Interest> &interest, Ptr<Packet> origPacket
   // NS_LOG_FUNCTION (interest->GetName ());
 
   // NS_LOG_INFO ("Received NACK: " << boost::cref(*interest));
-  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetComponents ().back ());
+  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetLastComponent ());
   NS_LOG_INFO ("< NACK for " << seq);
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << "NACK for " << seq << "\n";
 
@@ -510,31 +507,21 @@ ConsumerRtx::OnTimeout (uint32_t sequenceNumber)
 	  //NS_LOG_UNCOND("NODONODO:\t" << Application::GetNode()->GetId() << "\tNumero ritrasmissione:\t" << num_rtx->find(sequenceNumber)->second << "\t Num Max:\t" << m_maxNumRtx << "\tTempo:\t" << Simulator::Now ());
 
 	  // Recupero il nome del contenuto
-	  GotoLine(request_file, (sequenceNumber+1));
-	  std::string line_rto;
-	  std::getline(request_file,line_rto);
+	  std::string line_rto = request_catalog->GetLine (sequenceNumber+1);
+
+	  RequestEntry *request = m_requests.Find (sequenceNumber);
+	  NS_ASSERT_MSG (request != 0, "Timeout of a retired request");
 
 	  // **** Calcolo il nuovo tempo incrementale per il chunk
-	  Time new_increment = Simulator::Now() - download_time->find(line_rto)->second.sentTimeChunk_New;
+	  Time new_increment = Simulator::Now() - request->sentTimeChunk_New;
 
-	  download_time->find(line_rto)->second.incrementalTime+=new_increment;
+	  request->incrementalTime+=new_increment;
 
 	  // Verifico se rientro nel numero max di ritrasmissioni
-	  if(num_rtx->find(sequenceNumber)->second < m_maxNumRtx)
+	  if(request->numRtx < m_maxNumRtx)
 	  {
-	        // Incremento il contatore delle ritrasmissioni (con ulteriore controllo della presenza dell'elemento nella mappa)
-	        std::pair<std::map<uint32_t,uint32_t>::iterator,bool> ret;
-	        ret=num_rtx->insert (std::pair<uint32_t,uint32_t>(sequenceNumber,1) );
-	        if(ret.second==false)
-	        {
-	                // L'elemento è già presente, quindi posso aumentare il contatore
-	                uint32_t counter = num_rtx->find(sequenceNumber)->second;
-	                num_rtx->operator[](sequenceNumber)= counter+1;
-	        }
-	        else
-	        {
-	                NS_LOG_UNCOND("ERRORE NELLA MAPPA DELLE RITRASMISSIONI! ELEMENTO NON PRESENTE");
-	        }
+	        // Incremento il contatore delle ritrasmissioni
+	        request->numRtx++;
 
 	        m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1);                // make sure to disable RTT calculation for this sample
 	        m_retxSeqs.insert (sequenceNumber);
@@ -542,13 +529,11 @@ ConsumerRtx::OnTimeout (uint32_t sequenceNumber)
 	  }
 	  else
 	  {
-	      Time tempo_invio = download_time->find(line_rto)->second.sentTimeChunk_First;
+	      Time tempo_invio = request->sentTimeChunk_First;
 	     
-              //m_numMaxRtx(&line_rto, tempo_invio.GetMicroSeconds());
 	      m_numMaxRtx(&line_rto, tempo_invio.GetMicroSeconds(), "El");
 	      
-              download_time->erase(line_rto);
-	      num_rtx->erase(sequenceNumber);
+	      m_requests.Erase(sequenceNumber);
 	      seq_contenuto->erase(line_rto);     /// **** MODIFICA
 	      m_retxSeqs.erase(sequenceNumber);
 	      m_seqLifetimes.erase (sequenceNumber);
@@ -575,14 +560,6 @@ ConsumerRtx::WillSendOutInterest (uint32_t sequenceNumber)
   m_rtt->SentSeq (SequenceNumber32 (sequenceNumber), 1);
 }
 
-std::ifstream& ConsumerRtx::GotoLine(std::ifstream& file, uint32_t num) {
-  file.seekg(std::ios::beg);
-  for(uint32_t i=0; i < num - 1; ++i){
-      file.ignore(std::numeric_limits<std::streamsize>::max(),'\n');
-  }
-  return file;
-}
-
 } // namespace ndn
 } // namespace ns3
 
@@ -29,6 +29,8 @@
 #include "ns3/data-rate.h"
 #include "../model/bloom-filter/ndn-bloom-filter-base.h"
 #include "../../internet/model/rtt-estimator.h"
+#include "../utils/ndn-request-catalog.h"
+#include "../utils/ndn-seq-window.h"
 
 #include <set>
 #include <map>
@@ -128,22 +130,17 @@ protected:
   Time
   GetRetxTimer () const;
 
-  /**
-   * \brief Allows the positioning in a file at a specified line.
-   */
-  std::ifstream& GotoLine(std::ifstream& file, uint32_t num);
-
 protected:
   //  *** (MT) ***
-  std::ifstream request_file;    ///< @brief ifstream associated to the file containing the requests of the client.
+  Ptr<const RequestCatalog> request_catalog;    ///< @brief indexed file containing the requests of the client.
   std::map<std::string, uint32_t> *seq_contenuto;    ///< @brief map the content name to the sequence number.
 
   uint32_t m_maxNumRtx;       ///< @brief maximum number of allowed retransmission.
-  std::map<uint32_t, uint32_t> *num_rtx;  ///< @brief map the sequence number of the content to the relative number of retransmission.
 
-  // *** (MT) Structure used to track the DOWNLOAD TIME of a single chunk; it is needed to eliminate the time elapsed between the  ****
-           // effective retransmission of an Interest and its scheduling.
+  // *** (MT) State of every outstanding request; it also tracks the DOWNLOAD TIME of the chunk, and it is needed to eliminate the time elapsed
+           // between the effective retransmission of an Interest and its scheduling.
   /*
+   *  - numRtx = number of transmissions of the Interest.
    *  - sentTime_First = time when the Interest is sent.
    *  - sentTime_New = time updated every time there is a retransmission.
    *  - incrementalTime = it is initialized to '0'; when the RTO elapses, the increment is calculated as the current time (i.e., when the RTO elapses) - sending time.
@@ -152,42 +149,18 @@ protected:
    *  When the corresponding Chunk is received, the Download Time is calculated as " (Now - sentTime_New)+incrementalTime.
    */
 
-  struct DownloadEntry_Chunk
+  struct RequestEntry
   {
-	  DownloadEntry_Chunk (Time _sentTimeChunk_First, Time _sentTimeChunk_New, Time _incrementalTime): sentTimeChunk_First(_sentTimeChunk_First), sentTimeChunk_New(_sentTimeChunk_New), incrementalTime(_incrementalTime) {}
+	  RequestEntry () : numRtx (0) {}
+	  RequestEntry (Time _sentTime) : numRtx (1), sentTimeChunk_First (_sentTime), sentTimeChunk_New (_sentTime), incrementalTime (Seconds (0)) {}
 
+	  uint32_t numRtx;
 	  Time sentTimeChunk_First;
 	  Time sentTimeChunk_New;
 	  Time incrementalTime;
   };
 
-  std::map<std::string, DownloadEntry_Chunk> *download_time_first;       ///< @brief map the content name of the first chunk to its download entry. It is needed to calculate the SEEK TIME of a Content.
-  std::map<std::string, DownloadEntry_Chunk> *download_time;		     ///< @brief map the content name of every chunk to their download entry.
-
-  // *** (MT) Structure used to track the DOWNLOAD TIME of an entire content ***
-  /* It is indexed through the content name of the file (i.e., excluding the last chunk component)
-   *
-   *  - sentTimeFirst = time when the first Interest is sent.
-   *  - downloadTime  = download time of the entire file.
-   *  - expNumChunk   = expected number of chunks; it is read from the request file of the client  (from the line corresponding to the first chunk of each file).
-   *  - rcvNumChunk   = received number of chunks.
-   *  - distance      = hit distance of the entire file; it is calculated by averaging the hit distances of each chunk.
-   *
-   */
-
-  struct DownloadEntry
-  {
-	  DownloadEntry (Time _sentTimeFirst, Time _downloadTime, uint32_t _expNumChunk, uint32_t _rcvNumChunk, uint32_t _distance) : sentTimeFirst (_sentTimeFirst), downloadTime (_downloadTime), expNumChunk (_expNumChunk), rcvNumChunk (_rcvNumChunk), distance (_distance) { }
-
-	  Time sentTimeFirst;
-	  Time downloadTime;
-	  uint32_t expNumChunk;
-	  uint32_t rcvNumChunk;
-      uint32_t distance;
-
-  };
-
-  std::map<std::string, DownloadEntry> *download_time_file;     ///< @brief map the content name of every file to their download entry.
+  SeqWindow<RequestEntry> m_requests;     ///< @brief state of the outstanding requests, indexed by sequence number. It is retired when the chunk is received or dropped.
 
   UniformVariable m_rand; ///< @brief nonce generator
 
@@ -84,19 +84,7 @@ ConsumerZipfMandelbrot::SetNumberOfContents (uint32_t numOfContents)
 
   NS_LOG_DEBUG (m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double> (m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i+m_q, m_s);
-    }
-
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  m_zipf = ZipfMandelbrot::Get (m_N, m_q, m_s);
 }
 
 uint32_t
@@ -228,7 +216,6 @@ uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
   uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
 
   double p_random = m_SeqRng.GetValue();
   while (p_random == 0)
@@ -237,15 +224,7 @@ ConsumerZipfMandelbrot::GetNextSeq()
     }
   //if (p_random == 0)
   NS_LOG_LOGIC("p_random="<<p_random);
-  for (uint32_t i=1; i<=m_N; i++)
-    {
-      p_sum = m_Pcum[i];   //m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1], p_cum[2] = p[1] + p[2]
-      if (p_random <= p_sum)
-        {
-          content_index = i;
-          break;
-        } //if
-    } //for
+  content_index = m_zipf->GetContent (p_random);   // smallest i with p_random <= p_cum[i]
   //content_index = 1;
   NS_LOG_DEBUG("RandomNumber="<<content_index);
   return content_index;
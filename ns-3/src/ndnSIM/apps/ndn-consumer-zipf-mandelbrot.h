@@ -33,6 +33,7 @@
 #include "ns3/double.h"
 #include "ndn-consumer-cbr.h"
 #include "ns3/random-variable.h"
+#include "../utils/ndn-zipf-mandelbrot.h"
 
 namespace ns3 {
 namespace ndn {
@@ -87,7 +88,7 @@ private:
   uint32_t m_N;  //number of the contents
   double m_q;  //q in (k+q)^s
   double m_s;  //s in (k+q)^s
-  std::vector<double> m_Pcum;  //cumulative probability
+  Ptr<const ZipfMandelbrot> m_zipf;  //cumulative probability (shared)
 
   UniformVariable m_SeqRng; //RNG
 };
@@ -242,7 +242,7 @@ Consumer::OnContentObject (const Ptr<const ContentObject> &contentObject,
 
   // NS_LOG_INFO ("Received content object: " << boost::cref(*contentObject));
 
-  uint32_t seq = boost::lexical_cast<uint32_t> (contentObject->GetName ().GetComponents ().back ());
+  uint32_t seq = boost::lexical_cast<uint32_t> (contentObject->GetName ().GetLastComponent ());
   NS_LOG_INFO ("< DATA for " << seq);
 
   int hopCount = -1;
@@ -286,7 +286,7 @@ Consumer::OnNack (const Ptr<const Interest> &interest, Ptr<Packet> origPacket)
   // NS_LOG_FUNCTION (interest->GetName ());
 
   // NS_LOG_INFO ("Received NACK: " << boost::cref(*interest));
-  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetComponents ().back ());
+  uint32_t seq = boost::lexical_cast<uint32_t> (interest->GetName ().GetLastComponent ());
   NS_LOG_INFO ("< NACK for " << seq);
   // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << "NACK for " << seq << "\n";
 
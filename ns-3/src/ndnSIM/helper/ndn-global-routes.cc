@@ -0,0 +1,521 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author:  Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-global-routes.h"
+
+#include "ns3/ndn-l3-protocol.h"
+#include "ns3/ndn-face.h"
+#include "../model/ndn-net-device-face.h"
+#include "../model/ndn-global-router.h"
+
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/callback.h"
+#include "ns3/system-thread.h"
+
+#include <boost/foreach.hpp>
+#include <boost/graph/adjacency_list.hpp>
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+
+#include "boost-graph-ndn-global-routing-helper.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#include <sys/stat.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutes");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+// same as NdnGlobalRouterGraph weights and distances, with face index instead of Ptr<Face>
+typedef boost::tuple<int32_t, uint16_t, double> SnapshotWeight;
+typedef boost::tuple<int32_t, uint32_t, double> SnapshotDistance;
+
+typedef boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
+                              boost::no_property, GlobalRoutes::Edge> SnapshotGraph;
+
+struct SnapshotWeights
+{
+  const SnapshotGraph *graph;
+  uint32_t source;
+  const std::vector<uint16_t> *sourceMetrics; ///< @brief if not 0, metrics of the source faces
+};
+
+inline SnapshotWeight
+get (const SnapshotWeights &weights, const boost::graph_traits<SnapshotGraph>::edge_descriptor &edge)
+{
+  const GlobalRoutes::Edge &properties = (*weights.graph)[edge];
+  if (properties.face < 0)
+    return SnapshotWeight (-1, 0, 0.0);
+
+  uint16_t metric = properties.metric;
+  if (weights.sourceMetrics != 0 && boost::source (edge, *weights.graph) == weights.source)
+    metric = (*weights.sourceMetrics)[properties.face];
+
+  return SnapshotWeight (properties.face, metric, properties.delay);
+}
+
+// see boost::WeightCompare
+struct SnapshotCompare
+{
+  template<class A, class B>
+  bool
+  operator () (const A &a, const B &b) const
+  {
+    return a.template get<1> () < b.template get<1> ();
+  }
+};
+
+// see boost::WeightCombine
+struct SnapshotCombine
+{
+  SnapshotDistance
+  operator () (const SnapshotDistance &a, const SnapshotWeight &b) const
+  {
+    return SnapshotDistance (a.get<0> () < 0 ? b.get<0> () : a.get<0> (),
+                             a.get<1> () + b.get<1> (),
+                             a.get<2> () + b.get<2> ());
+  }
+};
+
+// FNV-1a
+void
+Hash (uint64_t &hash, const void *data, size_t size)
+{
+  const uint8_t *bytes = static_cast<const uint8_t *> (data);
+  for (size_t i = 0; i < size; i++)
+    {
+      hash ^= bytes[i];
+      hash *= 1099511628211ULL;
+    }
+}
+
+template<class T>
+void
+Hash (uint64_t &hash, const T &value)
+{
+  Hash (hash, &value, sizeof (value));
+}
+
+const char CACHE_MAGIC[8] = { 'N', 'D', 'N', 'R', 'T', 'S', '0', '1' };
+
+} // namespace
+
+} // namespace ndn
+} // namespace ns3
+
+namespace boost {
+
+template<>
+struct property_traits< ns3::ndn::SnapshotWeights >
+{
+  typedef ns3::ndn::SnapshotWeight value_type;
+  typedef ns3::ndn::SnapshotWeight reference;
+  typedef graph_traits<ns3::ndn::SnapshotGraph>::edge_descriptor key_type;
+  typedef readable_property_map_tag category;
+};
+
+} // namespace boost
+
+namespace ns3 {
+namespace ndn {
+
+struct GlobalRoutes::Graph
+{
+  Graph (uint32_t vertices)
+    : snapshot (vertices)
+  {
+  }
+
+  SnapshotGraph snapshot;
+};
+
+GlobalRoutes::GlobalRoutes (bool allPossibleRoutes)
+  : m_allPossibleRoutes (allPossibleRoutes)
+  , m_graph (0)
+  , m_nextSource (0)
+{
+  // the same order of routers as in NdnGlobalRouterGraph, so ties are resolved in the same way
+  boost::NdnGlobalRouterGraph topology;
+  BOOST_FOREACH (const Ptr<GlobalRouter> &router, topology.GetVertices ())
+    {
+      m_indices[router] = m_routers.size ();
+      m_routers.push_back (router);
+    }
+
+  m_edges.resize (m_routers.size ());
+  m_faces.resize (m_routers.size ());
+  m_sources.resize (m_routers.size (), false);
+
+  for (uint32_t router = 0; router < m_routers.size (); router++)
+    {
+      std::map< Ptr<Face>, int32_t > faceIndices;
+
+      Ptr<L3Protocol> l3 = m_routers[router]->GetL3Protocol ();
+      if (l3 != 0) // not a channel
+        {
+          m_sources[router] = true;
+          for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+            {
+              Ptr<Face> face = l3->GetFace (faceId);
+              faceIndices[face] = faceId;
+              m_faces[router].push_back (DynamicCast<NetDeviceFace> (face) != 0 ? face->GetMetric () : -1);
+            }
+        }
+
+      BOOST_FOREACH (const GlobalRouter::Incidency &incidency, m_routers[router]->GetIncidencies ())
+        {
+          NS_ASSERT (m_indices.find (incidency.get<2> ()) != m_indices.end ());
+
+          Edge edge;
+          edge.target = m_indices[incidency.get<2> ()];
+          edge.face = -1;
+          edge.metric = 0;
+          edge.delay = 0.0;
+
+          Ptr<Face> face = incidency.get<1> ();
+          if (face != 0)
+            {
+              NS_ASSERT (faceIndices.find (face) != faceIndices.end ());
+              edge.face = faceIndices[face];
+              edge.metric = face->GetMetric ();
+
+              Ptr<Limits> limits = face->GetObject<Limits> ();
+              if (limits != 0) // valid limits object
+                edge.delay = limits->GetLinkDelay ();
+            }
+          m_edges[router].push_back (edge);
+        }
+    }
+}
+
+void
+GlobalRoutes::Calculate (uint32_t threads, const std::string &cacheDirectory)
+{
+  std::string cacheFile;
+  if (!cacheDirectory.empty ())
+    {
+      cacheFile = GetCacheFile (cacheDirectory);
+      if (Load (cacheFile))
+        {
+          NS_LOG_DEBUG ("Routes loaded from " << cacheFile);
+          return;
+        }
+    }
+
+  if (threads == 0)
+    threads = std::max<long> (sysconf (_SC_NPROCESSORS_ONLN), 1);
+
+  Graph graph (m_routers.size ());
+  for (uint32_t router = 0; router < m_routers.size (); router++)
+    {
+      BOOST_FOREACH (const Edge &edge, m_edges[router])
+        {
+          boost::add_edge (router, edge.target, edge, graph.snapshot);
+        }
+    }
+
+  m_routes.assign (m_routers.size (), std::vector<Route> ());
+  m_graph = &graph;
+  m_nextSource = 0;
+
+  NS_LOG_DEBUG ("Calculating routes for " << m_routers.size () << " routers with " << threads << " threads");
+  if (threads == 1)
+    {
+      RunThread ();
+    }
+  else
+    {
+      std::vector< Ptr<SystemThread> > workers;
+      for (uint32_t thread = 0; thread < threads; thread++)
+        {
+          workers.push_back (Create<SystemThread> (MakeCallback (&GlobalRoutes::RunThread, this)));
+          workers.back ()->Start ();
+        }
+
+      BOOST_FOREACH (const Ptr<SystemThread> &worker, workers)
+        {
+          worker->Join ();
+        }
+    }
+  m_graph = 0;
+
+  if (!cacheFile.empty ())
+    Save (cacheFile);
+}
+
+void
+GlobalRoutes::RunThread ()
+{
+  // no ns-3 objects (Ptr, logging) are used here
+  while (true)
+    {
+      uint32_t source;
+      {
+        CriticalSection lock (m_mutex);
+        while (m_nextSource < m_routers.size () && !m_sources[m_nextSource])
+          m_nextSource ++;
+
+        if (m_nextSource == m_routers.size ())
+          return;
+
+        source = m_nextSource ++;
+      }
+
+      CalculateSource (*m_graph, source, m_routes[source]);
+    }
+}
+
+void
+GlobalRoutes::CalculateSource (const Graph &graph, uint32_t source, std::vector<Route> &routes) const
+{
+  uint32_t routers = m_routers.size ();
+  uint32_t runs = m_allPossibleRoutes ? m_faces[source].size () : 1;
+
+  Route unreachable;
+  unreachable.face = -1;
+  unreachable.metric = std::numeric_limits<uint32_t>::max ();
+  unreachable.delay = 0.0;
+  routes.assign (runs * routers, unreachable);
+
+  // GlobalRoutingHelper::CalculateAllPossibleRoutes changes metrics of the source faces
+  // before every run: all faces are disabled, then enabled one at a time
+  std::vector<uint16_t> sourceMetrics (m_faces[source].size (), std::numeric_limits<int16_t>::max ()-1);
+
+  SnapshotWeights weights;
+  weights.graph = &graph.snapshot;
+  weights.source = source;
+  weights.sourceMetrics = m_allPossibleRoutes ? &sourceMetrics : 0;
+
+  std::vector<SnapshotDistance> distances (routers);
+  for (uint32_t run = 0; run < runs; run++)
+    {
+      if (m_allPossibleRoutes)
+        {
+          if (m_faces[source][run] < 0) // only NetDeviceFaces are enabled
+            continue;
+          sourceMetrics[run] = m_faces[source][run];
+        }
+
+      boost::dijkstra_shortest_paths (graph.snapshot, source,
+                                      boost::weight_map (weights)
+                                      .
+                                      distance_map (boost::make_iterator_property_map (distances.begin (),
+                                                                                       boost::get (boost::vertex_index, graph.snapshot)))
+                                      .
+                                      distance_inf (SnapshotDistance (-1, std::numeric_limits<uint16_t>::max (), 0.0))
+                                      .
+                                      distance_zero (SnapshotDistance (-1, 0, 0.0))
+                                      .
+                                      distance_compare (SnapshotCompare ())
+                                      .
+                                      distance_combine (SnapshotCombine ())
+                                      );
+
+      for (uint32_t router = 0; router < routers; router++)
+        {
+          Route &route = routes[run * routers + router];
+          route.face = distances[router].get<0> ();
+          route.metric = distances[router].get<1> ();
+          route.delay = distances[router].get<2> ();
+
+          if (m_allPossibleRoutes && route.face >= 0 &&
+              sourceMetrics[route.face] == std::numeric_limits<uint16_t>::max ()-1)
+            route.face = -1; // path through the face which has been disabled again
+        }
+
+      if (m_allPossibleRoutes)
+        sourceMetrics[run] = std::numeric_limits<uint16_t>::max ()-1;
+    }
+}
+
+uint32_t
+GlobalRoutes::GetNRuns (Ptr<GlobalRouter> source) const
+{
+  std::map< Ptr<GlobalRouter>, uint32_t >::const_iterator index = m_indices.find (source);
+  NS_ASSERT (index != m_indices.end ());
+
+  return m_allPossibleRoutes ? m_faces[index->second].size () : 1;
+}
+
+void
+GlobalRoutes::GetDistances (Ptr<GlobalRouter> source, uint32_t run, boost::DistancesMap &distances) const
+{
+  std::map< Ptr<GlobalRouter>, uint32_t >::const_iterator index = m_indices.find (source);
+  NS_ASSERT (index != m_indices.end ());
+
+  uint32_t routers = m_routers.size ();
+  const std::vector<Route> &routes = m_routes[index->second];
+  NS_ASSERT_MSG ((run + 1) * routers <= routes.size (), "Routes have not been calculated");
+
+  Ptr<L3Protocol> l3 = source->GetL3Protocol ();
+  for (uint32_t router = 0; router < routers; router++)
+    {
+      const Route &route = routes[run * routers + router];
+      distances[m_routers[router]] = boost::make_tuple (route.face >= 0 ? l3->GetFace (route.face) : Ptr<Face> (),
+                                                        route.metric, route.delay);
+    }
+}
+
+uint64_t
+GlobalRoutes::GetHash () const
+{
+  uint64_t hash = 14695981039346656037ULL;
+
+  Hash (hash, m_allPossibleRoutes);
+  Hash (hash, static_cast<uint32_t> (m_routers.size ()));
+  for (uint32_t router = 0; router < m_routers.size (); router++)
+    {
+      Hash (hash, m_routers[router]->GetId ());
+      Hash (hash, static_cast<bool> (m_sources[router]));
+
+      Hash (hash, static_cast<uint32_t> (m_faces[router].size ()));
+      BOOST_FOREACH (int32_t metric, m_faces[router])
+        {
+          Hash (hash, metric);
+        }
+
+      Hash (hash, static_cast<uint32_t> (m_edges[router].size ()));
+      BOOST_FOREACH (const Edge &edge, m_edges[router])
+        {
+          Hash (hash, edge.target);
+          Hash (hash, edge.face);
+          Hash (hash, edge.metric);
+          Hash (hash, edge.delay);
+        }
+    }
+
+  return hash;
+}
+
+std::string
+GlobalRoutes::GetCacheFile (const std::string &cacheDirectory) const
+{
+  std::ostringstream os;
+  os << cacheDirectory << "/ndn-routes-" << std::hex << std::setw (16) << std::setfill ('0') << GetHash () << ".bin";
+  return os.str ();
+}
+
+bool
+GlobalRoutes::Load (const std::string &path)
+{
+  std::ifstream is (path.c_str (), std::ios::binary);
+  if (!is.is_open ())
+    return false;
+
+  char magic[sizeof (CACHE_MAGIC)];
+  uint64_t hash = 0;
+  uint32_t routers = 0;
+  is.read (magic, sizeof (magic));
+  is.read (reinterpret_cast<char *> (&hash), sizeof (hash));
+  is.read (reinterpret_cast<char *> (&routers), sizeof (routers));
+  if (!is || memcmp (magic, CACHE_MAGIC, sizeof (magic)) != 0 || hash != GetHash () || routers != m_routers.size ())
+    {
+      NS_LOG_DEBUG ("Cache file " << path << " does not match the topology");
+      return false;
+    }
+
+  std::vector< std::vector<Route> > routes (routers);
+  for (uint32_t router = 0; router < routers; router++)
+    {
+      uint32_t size = 0;
+      is.read (reinterpret_cast<char *> (&size), sizeof (size));
+      uint32_t expected = m_sources[router] ? (m_allPossibleRoutes ? m_faces[router].size () : 1) * routers : 0;
+      if (!is || size != expected)
+        {
+          NS_LOG_DEBUG ("Cache file " << path << " is corrupted");
+          return false;
+        }
+
+      routes[router].resize (size);
+      BOOST_FOREACH (Route &route, routes[router])
+        {
+          is.read (reinterpret_cast<char *> (&route.face), sizeof (route.face));
+          is.read (reinterpret_cast<char *> (&route.metric), sizeof (route.metric));
+          is.read (reinterpret_cast<char *> (&route.delay), sizeof (route.delay));
+        }
+    }
+
+  if (!is)
+    {
+      NS_LOG_DEBUG ("Cache file " << path << " is truncated");
+      return false;
+    }
+
+  m_routes.swap (routes);
+  return true;
+}
+
+void
+GlobalRoutes::Save (const std::string &path) const
+{
+  std::string directory = path.substr (0, path.rfind ('/'));
+  mkdir (directory.c_str (), 0755); // may already exist
+
+  // simulations running at the same time may save the same file: write a private copy, then rename it
+  std::ostringstream tmpPath;
+  tmpPath << path << ".tmp" << getpid ();
+
+  std::ofstream os (tmpPath.str ().c_str (), std::ios::binary | std::ios::trunc);
+  if (!os.is_open ())
+    {
+      NS_LOG_WARN ("Cannot write route cache " << tmpPath.str ());
+      return;
+    }
+
+  uint64_t hash = GetHash ();
+  uint32_t routers = m_routers.size ();
+  os.write (CACHE_MAGIC, sizeof (CACHE_MAGIC));
+  os.write (reinterpret_cast<const char *> (&hash), sizeof (hash));
+  os.write (reinterpret_cast<const char *> (&routers), sizeof (routers));
+  BOOST_FOREACH (const std::vector<Route> &routes, m_routes)
+    {
+      uint32_t size = routes.size ();
+      os.write (reinterpret_cast<const char *> (&size), sizeof (size));
+      BOOST_FOREACH (const Route &route, routes)
+        {
+          os.write (reinterpret_cast<const char *> (&route.face), sizeof (route.face));
+          os.write (reinterpret_cast<const char *> (&route.metric), sizeof (route.metric));
+          os.write (reinterpret_cast<const char *> (&route.delay), sizeof (route.delay));
+        }
+    }
+  os.close ();
+
+  if (!os || rename (tmpPath.str ().c_str (), path.c_str ()) != 0)
+    {
+      NS_LOG_WARN ("Cannot write route cache " << path);
+      std::remove (tmpPath.str ().c_str ());
+      return;
+    }
+  NS_LOG_DEBUG ("Routes saved to " << path);
+}
+
+} // namespace ndn
+} // namespace ns3
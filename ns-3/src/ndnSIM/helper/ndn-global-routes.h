@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author:  Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_GLOBAL_ROUTES_H
+#define NDN_GLOBAL_ROUTES_H
+
+#include "ns3/ptr.h"
+#include "ns3/system-mutex.h"
+
+#include <string>
+#include <vector>
+#include <map>
+
+namespace boost {
+struct DistancesMap;
+}
+
+namespace ns3 {
+namespace ndn {
+
+class GlobalRouter;
+
+/**
+ * @ingroup ndn
+ * @brief Shortest paths from every GlobalRouter, calculated on a snapshot of the topology
+ *
+ * Routers, faces, metrics and link delays are copied once, so Dijkstra for different sources
+ * runs in parallel threads without touching ns-3 objects (reference counting of Ptr is not
+ * thread safe).  Results are exactly those of boost::dijkstra_shortest_paths on
+ * NdnGlobalRouterGraph, including the choice among equal cost paths.
+ *
+ * Results can be cached in a file named after the hash of the snapshot, so simulations
+ * with the same topology (e.g., sweeps of strategy parameters) skip the calculation.
+ */
+class GlobalRoutes
+{
+public:
+  /**
+   * @brief Take snapshot of the current topology
+   * @param allPossibleRoutes if true, calculate routes for every face of the source enabled
+   *        in turn (see GlobalRoutingHelper::CalculateAllPossibleRoutes)
+   */
+  GlobalRoutes (bool allPossibleRoutes);
+
+  /**
+   * @brief Calculate routes (or load them from the cache)
+   * @param threads number of threads (0 for number of cores)
+   * @param cacheDirectory directory of the route cache (empty to disable the cache)
+   */
+  void
+  Calculate (uint32_t threads, const std::string &cacheDirectory);
+
+  /**
+   * @brief Get number of route calculations for the source (one per face if all possible
+   *        routes are calculated, one otherwise)
+   */
+  uint32_t
+  GetNRuns (Ptr<GlobalRouter> source) const;
+
+  /**
+   * @brief Get distances from the source to all routers, as dijkstra_shortest_paths would have
+   *        returned them
+   *
+   * Routers which are not reachable (or, for all possible routes, are reachable only through
+   * a disabled face) get a null face
+   */
+  void
+  GetDistances (Ptr<GlobalRouter> source, uint32_t run, boost::DistancesMap &distances) const;
+
+  /**
+   * @brief Route from source to destination
+   */
+  struct Route
+  {
+    int32_t face;    ///< @brief index of the first hop face in L3Protocol of the source, -1 if none
+    uint32_t metric; ///< @brief routing metric of the path
+    double delay;    ///< @brief propagation delay of the path
+  };
+
+  /**
+   * @brief Edge of the topology snapshot
+   */
+  struct Edge
+  {
+    uint32_t target; ///< @brief index of the router on the other side
+    int32_t face;    ///< @brief index of the face in L3Protocol, -1 if none
+    uint16_t metric; ///< @brief routing metric of the face
+    double delay;    ///< @brief link delay
+  };
+
+private:
+  struct Graph;
+
+  void
+  CalculateSource (const Graph &graph, uint32_t source, std::vector<Route> &routes) const;
+
+  void
+  RunThread ();
+
+  uint64_t
+  GetHash () const;
+
+  std::string
+  GetCacheFile (const std::string &cacheDirectory) const;
+
+  bool
+  Load (const std::string &path);
+
+  void
+  Save (const std::string &path) const;
+
+private:
+  bool m_allPossibleRoutes;
+
+  std::vector< Ptr<GlobalRouter> > m_routers;
+  std::map< Ptr<GlobalRouter>, uint32_t > m_indices;
+
+  std::vector< std::vector<Edge> > m_edges;    ///< @brief out edges of every router, in GetIncidencies () order
+  std::vector< std::vector<int32_t> > m_faces; ///< @brief metric of every face of the router, -1 for non NetDeviceFace
+  std::vector<bool> m_sources;                 ///< @brief routers for which routes are calculated
+
+  std::vector< std::vector<Route> > m_routes;  ///< @brief routes of every source, run after run
+
+  const Graph *m_graph;  ///< @brief graph used by threads
+  uint32_t m_nextSource; ///< @brief next source to be calculated by threads
+  SystemMutex m_mutex;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTES_H
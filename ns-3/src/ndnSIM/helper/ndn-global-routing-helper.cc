@@ -36,6 +36,10 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/mpi-interface.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
@@ -45,8 +49,12 @@
 #include <boost/graph/dijkstra_shortest_paths.hpp>
 
 #include "boost-graph-ndn-global-routing-helper.h"
+#include "ndn-global-routes.h"
 
 #include <math.h>
+#include <map>
+#include <vector>
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE ("ndn.GlobalRoutingHelper");
 
@@ -227,6 +235,90 @@ GlobalRoutingHelper::AddOriginsForAll ()
     }
 }
 
+namespace {
+
+GlobalValue g_routingThreads ("GlobalRoutingThreads",
+                              "Number of threads calculating routes in GlobalRoutingHelper (0 for number of cores)",
+                              UintegerValue (0),
+                              MakeUintegerChecker<uint32_t> ());
+
+GlobalValue g_routingCache ("GlobalRoutingCache",
+                            "Directory where GlobalRoutingHelper caches calculated routes (empty to disable the cache)",
+                            StringValue (""),
+                            MakeStringChecker ());
+
+uint32_t
+GetRoutingThreads ()
+{
+  UintegerValue threads;
+  g_routingThreads.GetValue (threads);
+  return threads.Get ();
+}
+
+std::string
+GetRoutingCache ()
+{
+  StringValue directory;
+  g_routingCache.GetValue (directory);
+  return directory.Get ();
+}
+
+/**
+ * @brief Prefixes grouped by the set of nodes originating them
+ *
+ * From any node, all prefixes of a group have the same routes, so they share one FIB entry
+ */
+typedef std::map< std::vector< Ptr<GlobalRouter> >, std::vector< Ptr<const Name> > > OriginGroups;
+
+OriginGroups
+GetOriginGroups ()
+{
+  typedef std::map< Name, std::pair< Ptr<const Name>, std::vector< Ptr<GlobalRouter> > > > PrefixOrigins;
+  PrefixOrigins prefixes;
+
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
+    {
+      Ptr<GlobalRouter> gr = (*node)->GetObject<GlobalRouter> ();
+      if (gr == 0)
+        continue;
+
+      BOOST_FOREACH (const Ptr<Name> &prefix, gr->GetLocalPrefixes ())
+        {
+          std::pair< Ptr<const Name>, std::vector< Ptr<GlobalRouter> > > &origins = prefixes[*prefix];
+          if (origins.first == 0)
+            origins.first = prefix;
+          origins.second.push_back (gr);
+        }
+    }
+
+  OriginGroups groups;
+  for (PrefixOrigins::iterator prefix = prefixes.begin (); prefix != prefixes.end (); prefix++)
+    {
+      // same order as in DistancesMap, so routes are added to FIB entries in the same order as before
+      std::vector< Ptr<GlobalRouter> > &origins = prefix->second.second;
+      std::sort (origins.begin (), origins.end ());
+      origins.erase (std::unique (origins.begin (), origins.end ()), origins.end ());
+
+      groups[origins].push_back (prefix->second.first);
+    }
+
+  NS_LOG_DEBUG (prefixes.size () << " prefixes, " << groups.size () << " groups of origins");
+  return groups;
+}
+
+/**
+ * @brief Check if the node is simulated by this process
+ *
+ * In distributed simulations (MPI), FIBs are installed only on the nodes of the local rank
+ */
+bool
+IsLocal (Ptr<Node> node)
+{
+  return !MpiInterface::IsEnabled () || node->GetSystemId () == MpiInterface::GetSystemId ();
+}
+
+} // namespace
+
 void
 GlobalRoutingHelper::CalculateRoutes ()
 {
@@ -235,17 +327,17 @@ GlobalRoutingHelper::CalculateRoutes ()
    * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
    */
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
+  OriginGroups groups = GetOriginGroups ();
 
-  NdnGlobalRouterGraph graph;
-//  typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  // Dijkstra for every node, on a snapshot of the topology (see GlobalRoutes)
+  GlobalRoutes routes (false);
+  routes.Calculate (GetRoutingThreads (), GetRoutingCache ());
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
   for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
     {
+      if (!IsLocal (*node))
+        continue;
+
       Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
       if (source == 0)
 	{
@@ -254,66 +346,59 @@ GlobalRoutingHelper::CalculateRoutes ()
 	}
 
       DistancesMap    distances;
-
-      dijkstra_shortest_paths (graph, source,
-			       // predecessor_map (boost::ref(predecessors))
-			       // .
-			       distance_map (boost::ref(distances))
-			       .
-			       distance_inf (WeightInf)
-			       .
-			       distance_zero (WeightZero)
-			       .
-			       distance_compare (boost::WeightCompare ())
-			       .
-			       distance_combine (boost::WeightCombine ())
-			       );
-
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+      routes.GetDistances (source, 0, distances);
 
       Ptr<Fib>  fib  = source->GetObject<Fib> ();
       fib->InvalidateAll ();
       NS_ASSERT (fib != 0);
 
       NS_LOG_UNCOND ("Reachability from Node: " << source->GetObject<Node> ()->GetId ());
-      for (DistancesMap::iterator i = distances.begin ();
-	   i != distances.end ();
-	   i++)
-	{
-	  if (i->first == source)
-	    continue;
-	  else
-	    {
-	      // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-	      if (i->second.get<0> () == 0)
-		{
-		  // cout << " is unreachable" << endl;
-		}
-	      else
-		{
-                  BOOST_FOREACH (const Ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                    {
-                      //NS_LOG_UNCOND(" prefix " << prefix << " reachable via face " << *i->second.get<0> ()
-                      //              << " with distance " << i->second.get<1> ()
-                      //              << " with delay " << i->second.get<2> ());
-
-                      Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                      entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                      Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                      Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                      if (fibLimits != 0)
-                        {
-                          // if it was created by the forwarding strategy via DidAddFibEntry event
-                          fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                          NS_LOG_UNCOND ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                        2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                        }
-                    }
-		}
-	    }
-	}
+      for (OriginGroups::const_iterator group = groups.begin ();
+           group != groups.end ();
+           group++)
+        {
+          Ptr<fib::Entry> entry;
+          BOOST_FOREACH (const Ptr<GlobalRouter> &origin, group->first)
+            {
+              if (origin == source)
+                continue;
+
+              DistancesMap::iterator i = distances.find (origin);
+              if (i == distances.end () || i->second.get<0> () == 0)
+                {
+                  // cout << " is unreachable" << endl;
+                  continue;
+                }
+
+              const Ptr<const Name> &prefix = group->second.front ();
+              //NS_LOG_UNCOND(" prefix " << prefix << " reachable via face " << *i->second.get<0> ()
+              //              << " with distance " << i->second.get<1> ()
+              //              << " with delay " << i->second.get<2> ());
+
+              entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
+              entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
+
+              Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
+
+              Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+              if (fibLimits != 0)
+                {
+                  // if it was created by the forwarding strategy via DidAddFibEntry event
+                  fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
+                  NS_LOG_UNCOND ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
+                                 2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
+                }
+            }
+
+          if (entry == 0)
+            continue;
+
+          // all other prefixes of the group share the entry of the first one
+          for (size_t prefix = 1; prefix < group->second.size (); prefix++)
+            {
+              fib->Add (group->second[prefix], entry);
+            }
+        }
     }
 }
 
@@ -325,17 +410,17 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes ()
    * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
    */
 
-  BOOST_CONCEPT_ASSERT(( VertexListGraphConcept< NdnGlobalRouterGraph > ));
-  BOOST_CONCEPT_ASSERT(( IncidenceGraphConcept< NdnGlobalRouterGraph > ));
+  OriginGroups groups = GetOriginGroups ();
 
-  NdnGlobalRouterGraph graph;
-//  typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  // Dijkstra for every node and every face of the node, on a snapshot of the topology (see GlobalRoutes)
+  GlobalRoutes routes (true);
+  routes.Calculate (GetRoutingThreads (), GetRoutingCache ());
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by the graph, which
-  // is not obviously how implement in an efficient manner
   for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); node++)
     {
+      if (!IsLocal (*node))
+        continue;
+
       Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter> ();
       if (source == 0)
 	{
@@ -353,92 +438,64 @@ GlobalRoutingHelper::CalculateAllPossibleRoutes ()
       Ptr<L3Protocol> l3 = source->GetObject<L3Protocol> ();
       NS_ASSERT (l3 != 0);
 
-      // remember interface statuses
-      std::vector<uint16_t> originalMetric (l3->GetNFaces ());
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
-        {
-          originalMetric[faceId] = l3->GetFace (faceId)->GetMetric ();
-          l3->GetFace (faceId)->SetMetric (std::numeric_limits<int16_t>::max ()-1); // value std::numeric_limits<int16_t>::max () MUST NOT be used (reserved)
-        }
-
+      // faces are enabled one at a time by GlobalRoutes, metrics of the real faces are not changed
       for (uint32_t enabledFaceId = 0; enabledFaceId < l3->GetNFaces (); enabledFaceId++)
         {
           if (DynamicCast<ndn::NetDeviceFace> (l3->GetFace (enabledFaceId)) == 0)
             continue;
 
-          // enabling only faceId
-          l3->GetFace (enabledFaceId)->SetMetric (originalMetric[enabledFaceId]);
-
           DistancesMap    distances;
 
           NS_LOG_DEBUG ("-----------");
 
-          dijkstra_shortest_paths (graph, source,
-                                   // predecessor_map (boost::ref(predecessors))
-                                   // .
-                                   distance_map (boost::ref(distances))
-                                   .
-                                   distance_inf (WeightInf)
-                                   .
-                                   distance_zero (WeightZero)
-                                   .
-                                   distance_compare (boost::WeightCompare ())
-                                   .
-                                   distance_combine (boost::WeightCombine ())
-                                   );
-
-          // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
-
-          for (DistancesMap::iterator i = distances.begin ();
-               i != distances.end ();
-               i++)
+          routes.GetDistances (source, enabledFaceId, distances);
+
+          for (OriginGroups::const_iterator group = groups.begin ();
+               group != groups.end ();
+               group++)
             {
-              if (i->first == source)
-                continue;
-              else
+              Ptr<fib::Entry> entry;
+              BOOST_FOREACH (const Ptr<GlobalRouter> &origin, group->first)
                 {
-                  // cout << "  Node " << i->first->GetObject<Node> ()->GetId ();
-                  if (i->second.get<0> () == 0)
+                  if (origin == source)
+                    continue;
+
+                  DistancesMap::iterator i = distances.find (origin);
+                  if (i == distances.end () || i->second.get<0> () == 0)
                     {
-                      // cout << " is unreachable" << endl;
+                      // cout << " is unreachable (or reachable only through a disabled face)" << endl;
+                      continue;
                     }
-                  else
+
+                  const Ptr<const Name> &prefix = group->second.front ();
+                  NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *i->second.get<0> ()
+                                << " with distance " << i->second.get<1> ()
+                                << " with delay " << i->second.get<2> ());
+
+                  entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
+                  entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
+
+                  Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
+
+                  Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
+                  if (fibLimits != 0)
                     {
-                      BOOST_FOREACH (const Ptr<const Name> &prefix, i->first->GetLocalPrefixes ())
-                        {
-                          NS_LOG_DEBUG (" prefix " << *prefix << " reachable via face " << *i->second.get<0> ()
-                                        << " with distance " << i->second.get<1> ()
-                                        << " with delay " << i->second.get<2> ());
-
-                          if (i->second.get<0> ()->GetMetric () == std::numeric_limits<uint16_t>::max ()-1)
-                            continue;
-
-                          Ptr<fib::Entry> entry = fib->Add (prefix, i->second.get<0> (), i->second.get<1> ());
-                          entry->SetRealDelayToProducer (i->second.get<0> (), Seconds (i->second.get<2> ()));
-
-                          Ptr<Limits> faceLimits = i->second.get<0> ()->GetObject<Limits> ();
-
-                          Ptr<Limits> fibLimits = entry->GetObject<Limits> ();
-                          if (fibLimits != 0)
-                            {
-                              // if it was created by the forwarding strategy via DidAddFibEntry event
-                              fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
-                              NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
-                                            2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
-                            }
-                        }
+                      // if it was created by the forwarding strategy via DidAddFibEntry event
+                      fibLimits->SetLimits (faceLimits->GetMaxRate (), 2 * i->second.get<2> () /*exact RTT*/);
+                      NS_LOG_DEBUG ("Set limit for prefix " << *prefix << " " << faceLimits->GetMaxRate () << " / " <<
+                                    2*i->second.get<2> () << "s (" << faceLimits->GetMaxRate () * 2 * i->second.get<2> () << ")");
                     }
                 }
-            }
 
-          // disabling the face again
-          l3->GetFace (enabledFaceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1);
-        }
+              if (entry == 0)
+                continue;
 
-      // recover original interface statuses
-      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
-        {
-          l3->GetFace (faceId)->SetMetric (originalMetric[faceId]);
+              // all other prefixes of the group share the entry of the first one
+              for (size_t prefix = 1; prefix < group->second.size (); prefix++)
+                {
+                  fib->Add (group->second[prefix], entry);
+                }
+            }
         }
     }
 }
@@ -97,6 +97,10 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest paths are calculated in parallel by GlobalRoutingThreads threads (global value, 0 for
+   * number of cores).  If GlobalRoutingCache global value is set (e.g., --GlobalRoutingCache=routes),
+   * they are saved in that directory and reused by simulations with the same topology.
    */
   static void
   CalculateRoutes ();
@@ -107,6 +111,7 @@ public:
    * Refer to the implementation for more details.
    *
    * Note that this method is highly experimental and should be used with caution (very time consuming).
+   * Routes are calculated in parallel and cached in the same way as in CalculateRoutes.
    */
   static void
   CalculateAllPossibleRoutes ();
@@ -46,6 +46,7 @@
 #include "ns3/ndn-content-store.h"
 #include "ns3/ndn-repo.h"
 #include "../model/qtab/ndn-qtab.h"
+#include "../utils/ndn-expiry-wheel.h"
 
 #include "ns3/node-list.h"
 // #include "ns3/loopback-net-device.h"
@@ -269,6 +270,9 @@ StackHelper::Install (Ptr<Node> node) const
   Ptr<Fib> fib = m_fibFactory.Create<Fib> ();
   ndn->AggregateObject (fib);
 
+  // Create and aggregate the wheel that expires QTAB and PIT entries (should be there before them)
+  ndn->AggregateObject (CreateObject<ExpiryWheel> ());
+
   // ** [MT] ** Create and aggregate QTAB
   ndn->AggregateObject (m_qtabFactory.Create<Qtab> ());
 
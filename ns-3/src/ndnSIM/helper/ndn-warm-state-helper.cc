@@ -0,0 +1,431 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndn-warm-state-helper.h"
+
+#include "ns3/ndn-l3-protocol.h"
+#include "ns3/ndn-face.h"
+#include "ns3/ndn-name.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+#include "ns3/ndn-content-store.h"
+#include "ns3/ndn-fib.h"
+#include "ns3/ndn-fib-entry.h"
+#include "../model/qtab/ndn-qtab.h"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/buffer.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+
+#include <boost/foreach.hpp>
+
+#include <fstream>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <cstring>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.WarmStateHelper");
+
+namespace ns3 {
+namespace ndn {
+
+namespace {
+
+const char WARM_STATE_MAGIC[8] = { 'N', 'D', 'N', 'W', 'A', 'R', 'M', '1' };
+
+const uint8_t EXPLORATION = 1;
+const uint8_t FIRST_EXPLORATION = 2;
+
+template<class T>
+void
+Write (std::ostream &os, const T &value)
+{
+  os.write (reinterpret_cast<const char *> (&value), sizeof (value));
+}
+
+template<class T>
+T
+Read (std::istream &is)
+{
+  T value = T ();
+  is.read (reinterpret_cast<char *> (&value), sizeof (value));
+  return value;
+}
+
+void
+WriteTime (std::ostream &os, const Time &time)
+{
+  Write<int64_t> (os, time.GetNanoSeconds ());
+}
+
+Time
+ReadTime (std::istream &is)
+{
+  return NanoSeconds (Read<int64_t> (is));
+}
+
+void
+WriteName (std::ostream &os, const Name &name)
+{
+  Write<uint32_t> (os, name.size ());
+  for (size_t i = 0; i < name.size (); i++)
+    {
+      Write<uint32_t> (os, name.GetComponentSize (i));
+      os.write (name.GetComponentData (i), name.GetComponentSize (i));
+    }
+}
+
+Ptr<Name>
+ReadName (std::istream &is)
+{
+  Ptr<Name> name = Create<Name> ();
+  uint32_t components = Read<uint32_t> (is);
+  for (uint32_t i = 0; i < components && is; i++)
+    {
+      std::string component (Read<uint32_t> (is), '\0');
+      is.read (&component[0], component.size ());
+      name->Add (component);
+    }
+  return name;
+}
+
+void
+SaveContentStore (std::ostream &os, Ptr<ContentStore> cs)
+{
+  std::vector< std::pair<Ptr<cs::Entry>, uint8_t> > entries;
+  if (cs != 0)
+    cs->Snapshot (entries);
+
+  Write<uint32_t> (os, entries.size ());
+  for (std::vector< std::pair<Ptr<cs::Entry>, uint8_t> >::const_iterator item = entries.begin ();
+       item != entries.end ();
+       item++)
+    {
+      Ptr<const ContentObject> header = item->first->GetHeader ();
+
+      Buffer buffer;
+      buffer.AddAtStart (header->GetSerializedSize ());
+      header->Serialize (buffer.Begin ());
+
+      Write<uint8_t> (os, item->second);
+      Write<uint32_t> (os, buffer.GetSize ());
+      buffer.CopyData (&os, buffer.GetSize ());
+      Write<uint32_t> (os, item->first->GetPacket ()->GetSize ());
+    }
+}
+
+void
+SaveQtab (std::ostream &os, Ptr<Qtab> qtab)
+{
+  Write<uint32_t> (os, (qtab != 0) ? qtab->GetSizeQtab () : 0);
+  if (qtab == 0)
+    return;
+
+  for (Ptr<qtab::Entry> entry = qtab->BeginQtab (); entry != qtab->EndQtab (); entry = qtab->NextQtab (entry))
+    {
+      WriteName (os, entry->GetInterest ()->GetName ());
+
+      Write<uint32_t> (os, entry->GetNQvalues ());
+      for (uint32_t face = 0; face < entry->GetNQvalues (); face++)
+        WriteTime (os, entry->GetQvalue (face));
+
+      WriteTime (os, entry->GetqMin ().qValueMin);
+      Write<uint32_t> (os, entry->GetqMin ().interfId);
+      Write<uint8_t> (os, (entry->GetExplorationFlag () ? EXPLORATION : 0) |
+                          (entry->GetIsFirstExplorationFlag () ? FIRST_EXPLORATION : 0));
+      Write<uint32_t> (os, entry->GetExplorationChunks ());
+      Write<uint32_t> (os, entry->GetExploitationChunks ());
+      WriteTime (os, entry->GetExpireTime () - Simulator::Now ());
+    }
+}
+
+void
+SaveFib (std::ostream &os, Ptr<Fib> fib)
+{
+  // only entries reported by Begin ()/Next (): prefixes sharing an entry are created by routing
+  std::vector< Ptr<const fib::Entry> > entries;
+  if (fib != 0)
+    {
+      for (Ptr<const fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+        entries.push_back (entry);
+    }
+
+  Write<uint32_t> (os, entries.size ());
+  BOOST_FOREACH (Ptr<const fib::Entry> entry, entries)
+    {
+      WriteName (os, entry->GetPrefix ());
+
+      Write<uint32_t> (os, entry->m_faces.size ());
+      BOOST_FOREACH (const fib::FaceMetric &metric, entry->m_faces)
+        {
+          Write<uint32_t> (os, metric.GetFace ()->GetId ());
+          Write<int32_t> (os, metric.GetRoutingCost ());
+          Write<uint8_t> (os, metric.GetStatus ());
+          WriteTime (os, metric.GetSRtt ());
+          WriteTime (os, metric.GetRttVar ());
+          WriteTime (os, metric.GetRealDelay ());
+        }
+    }
+}
+
+bool
+RestoreContentStore (std::istream &is, Ptr<ContentStore> cs)
+{
+  uint32_t entries = Read<uint32_t> (is);
+  if (entries > 0 && cs == 0)
+    return false;
+
+  std::vector<uint8_t> data;
+  for (uint32_t i = 0; i < entries && is; i++)
+    {
+      uint8_t state = Read<uint8_t> (is);
+      data.resize (Read<uint32_t> (is));
+      is.read (reinterpret_cast<char *> (&data[0]), data.size ());
+      uint32_t payloadSize = Read<uint32_t> (is);
+      if (!is)
+        break;
+
+      Buffer buffer;
+      buffer.AddAtStart (data.size ());
+      buffer.Begin ().Write (&data[0], data.size ());
+
+      Ptr<ContentObject> header = Create<ContentObject> ();
+      header->Deserialize (buffer.Begin ());
+
+      cs->Restore (header, Create<Packet> (payloadSize), state);
+    }
+  return !is.fail ();
+}
+
+bool
+RestoreQtab (std::istream &is, Ptr<Node> node, Ptr<Qtab> qtab, Ptr<Fib> fib)
+{
+  uint32_t entries = Read<uint32_t> (is);
+  if (entries > 0 && (qtab == 0 || fib == 0))
+    return false;
+
+  for (uint32_t i = 0; i < entries && is; i++)
+    {
+      Ptr<Interest> interest = Create<Interest> ();
+      interest->SetName (ReadName (is));
+
+      std::vector<Time> qValues (Read<uint32_t> (is));
+      for (uint32_t face = 0; face < qValues.size (); face++)
+        qValues[face] = ReadTime (is);
+
+      Time qValueMin = ReadTime (is);
+      uint32_t interfId = Read<uint32_t> (is);
+      uint8_t flags = Read<uint8_t> (is);
+      uint32_t numR = Read<uint32_t> (is);
+      uint32_t numT = Read<uint32_t> (is);
+      Time lifetime = ReadTime (is);
+      if (!is)
+        break;
+
+      Ptr<qtab::Entry> entry = qtab->FindQtab (interest->GetContentName ());
+      if (entry == 0)
+        {
+          Ptr<fib::Entry> fibEntry = fib->LongestPrefixMatch (*interest);
+          if (fibEntry == 0)
+            {
+              NS_LOG_DEBUG ("Node " << node->GetId () << ": no route for " << interest->GetContentName ());
+              continue;
+            }
+
+          entry = qtab->CreateQtab (interest, fibEntry, qValues.size ());
+          if (entry == 0)
+            {
+              NS_LOG_DEBUG ("Node " << node->GetId () << ": QTAB is full");
+              continue;
+            }
+        }
+
+      for (uint32_t face = 0; face < qValues.size () && face < entry->GetNQvalues (); face++)
+        entry->SetQvalue (face, qValues[face]);
+
+      entry->GetqMin ().qValueMin = qValueMin;
+      entry->GetqMin ().interfId = interfId;
+      entry->SetExplorationFlag (flags & EXPLORATION);
+      entry->SetIsFirstExplorationFlag (flags & FIRST_EXPLORATION);
+      entry->SetExplorationChunks (numR);
+      entry->SetExploitationChunks (numT);
+      entry->SetExpireTime (Simulator::Now () + lifetime);
+    }
+  return !is.fail ();
+}
+
+bool
+RestoreFib (std::istream &is, Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<Fib> fib)
+{
+  uint32_t entries = Read<uint32_t> (is);
+  if (entries > 0 && (ndn == 0 || fib == 0))
+    return false;
+
+  for (uint32_t i = 0; i < entries && is; i++)
+    {
+      Ptr<const Name> prefix = ReadName (is);
+      uint32_t faces = Read<uint32_t> (is);
+
+      Ptr<fib::Entry> entry = fib->Find (*prefix);
+      for (uint32_t j = 0; j < faces && is; j++)
+        {
+          uint32_t faceId = Read<uint32_t> (is);
+          int32_t cost = Read<int32_t> (is);
+          uint8_t status = Read<uint8_t> (is);
+          Time sRtt = ReadTime (is);
+          Time rttVar = ReadTime (is);
+          Time realDelay = ReadTime (is);
+          if (!is)
+            break;
+
+          Ptr<Face> face = ndn->GetFaceById (faceId);
+          if (face == 0)
+            {
+              NS_LOG_WARN ("Node " << node->GetId () << " has no face " << faceId);
+              return false;
+            }
+
+          if (entry == 0)
+            entry = fib->Add (prefix, face, cost);
+          else
+            entry->AddOrUpdateRoutingMetric (face, cost);
+
+          entry->UpdateStatus (face, static_cast<fib::FaceMetric::Status> (status));
+          entry->SetFaceRtt (face, sRtt, rttVar);
+          entry->SetRealDelayToProducer (face, realDelay);
+        }
+    }
+  return !is.fail ();
+}
+
+} // namespace
+
+void
+WarmStateHelper::Save (const std::string &file)
+{
+  Save (NodeContainer::GetGlobal (), file);
+}
+
+void
+WarmStateHelper::Save (const NodeContainer &nodes, const std::string &file)
+{
+  SaveNodes (nodes, file);
+}
+
+void
+WarmStateHelper::SaveAt (const Time &time, const std::string &file)
+{
+  SaveAt (time, NodeContainer::GetGlobal (), file);
+}
+
+void
+WarmStateHelper::SaveAt (const Time &time, const NodeContainer &nodes, const std::string &file)
+{
+  Simulator::Schedule (time - Simulator::Now (), &WarmStateHelper::SaveNodes, nodes, file);
+}
+
+void
+WarmStateHelper::SaveNodes (NodeContainer nodes, std::string file)
+{
+  std::ofstream os (file.c_str (), std::ios::binary | std::ios::trunc);
+  if (!os.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot write warm state file " << file);
+    }
+
+  os.write (WARM_STATE_MAGIC, sizeof (WARM_STATE_MAGIC));
+  Write<uint32_t> (os, nodes.GetN ());
+  for (NodeContainer::Iterator node = nodes.Begin (); node != nodes.End (); node++)
+    {
+      Ptr<L3Protocol> ndn = (*node)->GetObject<L3Protocol> ();
+
+      Write<uint32_t> (os, (*node)->GetId ());
+      Write<uint32_t> (os, (ndn != 0) ? ndn->GetNFaces () : 0);
+
+      // FIB first: QTAB entries are created with the FIB entries of their contents
+      SaveFib (os, (*node)->GetObject<Fib> ());
+      SaveQtab (os, (*node)->GetObject<Qtab> ());
+      SaveContentStore (os, (*node)->GetObject<ContentStore> ());
+    }
+  os.close ();
+
+  if (!os)
+    {
+      NS_FATAL_ERROR ("Cannot write warm state file " << file);
+    }
+  NS_LOG_INFO ("Warm state of " << nodes.GetN () << " nodes saved to " << file << " at " << Simulator::Now ().GetSeconds () << "s");
+}
+
+void
+WarmStateHelper::Restore (const std::string &file)
+{
+  std::ifstream is (file.c_str (), std::ios::binary);
+  if (!is.is_open ())
+    {
+      NS_FATAL_ERROR ("Cannot read warm state file " << file);
+    }
+
+  char magic[sizeof (WARM_STATE_MAGIC)];
+  is.read (magic, sizeof (magic));
+  uint32_t nodes = Read<uint32_t> (is);
+  if (!is || memcmp (magic, WARM_STATE_MAGIC, sizeof (magic)) != 0)
+    {
+      NS_FATAL_ERROR ("File " << file << " is not a warm state file");
+    }
+
+  for (uint32_t i = 0; i < nodes; i++)
+    {
+      uint32_t id = Read<uint32_t> (is);
+      uint32_t faces = Read<uint32_t> (is);
+      if (!is)
+        break;
+
+      Ptr<Node> node = (id < NodeList::GetNNodes ()) ? NodeList::GetNode (id) : 0;
+      Ptr<L3Protocol> ndn = (node != 0) ? node->GetObject<L3Protocol> () : 0;
+      if (node == 0 || faces != ((ndn != 0) ? ndn->GetNFaces () : 0))
+        {
+          NS_FATAL_ERROR ("Warm state file " << file << " does not match the topology (node " << id << ")");
+        }
+
+      Ptr<Fib> fib = node->GetObject<Fib> ();
+      if (!RestoreFib (is, node, ndn, fib) ||
+          !RestoreQtab (is, node, node->GetObject<Qtab> (), fib) ||
+          !RestoreContentStore (is, node->GetObject<ContentStore> ()))
+        {
+          NS_FATAL_ERROR ("Warm state file " << file << " does not match the topology (node " << id << ")");
+        }
+    }
+
+  if (!is)
+    {
+      NS_FATAL_ERROR ("Warm state file " << file << " is truncated");
+    }
+  NS_LOG_INFO ("Warm state of " << nodes << " nodes restored from " << file);
+}
+
+} // namespace ndn
+} // namespace ns3
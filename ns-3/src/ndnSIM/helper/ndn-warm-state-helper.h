@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDN_WARM_STATE_HELPER_H
+#define NDN_WARM_STATE_HELPER_H
+
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+
+#include <string>
+
+namespace ns3 {
+
+class Node;
+class NodeContainer;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn
+ * @brief Helper to save the warm state of NDN nodes into a file and to restore it
+ *
+ * Simulations which differ only in the parameters of the measurement phase go through the
+ * same warm-up transient.  The state reached at the end of the warm-up can be saved once
+ * and restored at the beginning of these simulations, which can then start measuring
+ * immediately.  Nodes and faces are matched by their ids, so the simulation restoring the
+ * state should build the same topology in the same order.
+ *
+ * Saved state of every node:
+ * - content store: ContentObject header and payload size of the cached contents, in the
+ *   order that rebuilds the replacement state of the store (see ContentStore::Snapshot)
+ * - QTAB: per-face Q-values, minimum Q-value, exploration state, chunk counters and
+ *   remaining lifetime of the entries
+ * - FIB: routing cost, status, RTT estimation and real delay of the next hops
+ *
+ * Lifetimes of QTAB entries are saved relative to the time of Save () and restored relative
+ * to the time of Restore ().  Contents are restored with a zero-filled payload of the same size.
+ */
+class WarmStateHelper
+{
+public:
+  /**
+   * @brief Save the state of all nodes to the file
+   */
+  static void
+  Save (const std::string &file);
+
+  /**
+   * @brief Save the state of the nodes to the file
+   */
+  static void
+  Save (const NodeContainer &nodes, const std::string &file);
+
+  /**
+   * @brief Schedule Save () of all nodes at the given (absolute) simulation time
+   */
+  static void
+  SaveAt (const Time &time, const std::string &file);
+
+  /**
+   * @brief Schedule Save () of the nodes at the given (absolute) simulation time
+   */
+  static void
+  SaveAt (const Time &time, const NodeContainer &nodes, const std::string &file);
+
+  /**
+   * @brief Restore the state saved in the file into the nodes with the same ids
+   *
+   * Content stores and QTABs should be empty (e.g., Restore () is called before the
+   * simulation starts); FIB entries are updated if they exist, created otherwise.
+   * Stops the simulation with an error if the file cannot be read or does not
+   * match the topology.
+   */
+  static void
+  Restore (const std::string &file);
+
+private:
+  static void
+  SaveNodes (NodeContainer nodes, std::string file);
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_WARM_STATE_HELPER_H
@@ -38,6 +38,7 @@
 #include <deque>
 #include <set>
 #include <string>
+#include <cstring>
 
 #include "ndn-bloom-filter-base.h"
 #include "ns3/log.h"
@@ -117,7 +118,7 @@ BloomFilterBase::GetTypeId (void)
 
 BloomFilterBase::BloomFilterBase()
 {
-	bloomFilter = new std::vector<boost::dynamic_bitset<> > ();
+	bloomFilter = new BloomFilterCells ();
 	bfSeeds = new std::vector<uint32_t> ();
 	bfInsertedElements = new std::vector<uint32_t> ();
 	bfDeletedElements = new std::vector<uint32_t> ();
@@ -216,16 +217,11 @@ void BloomFilterBase::InsertFootprint(const InputIterator begin, const InputIter
 void BloomFilterBase::ResetFootprintCells(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
 {
 
-      std::size_t bit_index = 0;
-      std::size_t bit = 0;
+      PrefixHash hash = HashKey(key_begin, length);
 
       for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
       {
-
-    	  //ComputeIndicesStableFib(hash_ap(key_begin,length,bfStableCacheSeeds[i]),bit_index,bit);
-    	  ComputeIndicesFilter(MurmurHash3(key_begin,length,bfSeeds->operator [](i)),bit_index,bit);
-    	  SetZeroFilterCell(bit_index, interface);
-
+    	  SetZeroFilterCell(GetFilterIndex(hash, i), interface);
       }
 
       ++bfDeletedElements->operator [](interface);
@@ -257,19 +253,14 @@ template<typename InputIterator>
 
 // DECREMENT FOOTPRINT CELLS
 
-inline void BloomFilterBase::DecrementFootprintCells(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
+void BloomFilterBase::DecrementFootprintCells(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
 {
 
-      std::size_t bit_index = 0;
-      std::size_t bit = 0;
+      PrefixHash hash = HashKey(key_begin, length);
 
       for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
       {
-
-    	  //ComputeIndicesStableFib(hash_ap(key_begin,length,bfStableCacheSeeds[i]),bit_index,bit);
-    	  ComputeIndicesFilter(MurmurHash3(key_begin,length,bfSeeds->operator [](i)),bit_index,bit);
-    	  DecrementFilterCell(bit_index, interface);
-
+    	  DecrementFilterCell(GetFilterIndex(hash, i), interface);
       }
 
       ++bfDeletedElements->operator [](interface);
@@ -277,19 +268,19 @@ inline void BloomFilterBase::DecrementFootprintCells(const unsigned char* key_be
 }
 
 template<typename T>
-   inline void BloomFilterBase::DecrementFootprintCells(const T& t, const std::size_t interface)
+   void BloomFilterBase::DecrementFootprintCells(const T& t, const std::size_t interface)
    {
       // Note: T must be a C++ POD type.
 	BloomFilterBase::DecrementFootprintCells(reinterpret_cast<const unsigned char*>(&t),sizeof(T), interface);
    }
 
-inline void BloomFilterBase::DecrementFootprintCells(const std::string& key, const std::size_t interface)
+void BloomFilterBase::DecrementFootprintCells(const std::string& key, const std::size_t interface)
    {
 	BloomFilterBase::DecrementFootprintCells(reinterpret_cast<const unsigned char*>(key.c_str()),key.size(), interface);
    }
 
 template<typename InputIterator>
-   inline void BloomFilterBase::DecrementFootprintCells(const InputIterator begin, const InputIterator end, const std::size_t interface)
+   void BloomFilterBase::DecrementFootprintCells(const InputIterator begin, const InputIterator end, const std::size_t interface)
    {
       InputIterator itr = begin;
       while (end != itr)
@@ -309,23 +300,7 @@ bool BloomFilterBase::IncrementFilterCell (std::size_t cell, std::size_t interfa
        exit(1);
    }
 
-   std::size_t msb = bloomFilter->operator [](interface).size() - (cell * bfParam->bfCellWidth) - 1;
-   std::size_t lsb = msb - (bfParam->bfCellWidth - 1);
-   std::size_t i;
-
-   for (i=lsb; i<=msb; i++)
-   {
-	   if(!bloomFilter->operator [](interface)[i])
-	   {
-		   bloomFilter->operator [](interface)[i] = true;
-		   while (i && i>lsb)
-		   {
-			   bloomFilter->operator [](interface)[--i] = false;
-		   }
-		   return true;
-	   }
-   }
-   return false;
+   return bloomFilter->Increment(cell, interface);
 }
 
 
@@ -338,23 +313,7 @@ bool BloomFilterBase::DecrementFilterCell (std::size_t cell, std::size_t interfa
 		   exit(1);
 	   }
 
-	   std::size_t msb = bloomFilter->operator [](interface).size() - (cell * bfParam->bfCellWidth) - 1;
-	   std::size_t lsb = msb - (bfParam->bfCellWidth - 1);
-	   std::size_t i;
-
-	   for (i = lsb; i <= msb; i++)
-	   {
-		  if (bloomFilter->operator [](interface)[i])
-		  {
-			  bloomFilter->operator [](interface)[i] = false;
-			  while (i && i > lsb)
-			  {
-				  bloomFilter->operator [](interface)[--i] = true;
-			  }
-			return true;
-		  }
-	   }
-	   return false;
+	   return bloomFilter->Decrement(cell, interface);
 }
 
 
@@ -366,49 +325,33 @@ bool BloomFilterBase::SetMaxFilterCell(std::size_t cell, std::size_t interface)
    	   exit(1);
    }
 
-   std::size_t msb = bloomFilter->operator [](interface).size() - (cell * bfParam->bfCellWidth) - 1;
-   std::size_t lsb = msb - (bfParam->bfCellWidth - 1);
-   std::size_t i;
-
-   for (i = lsb; i <= msb; i++) {
-	   bloomFilter->operator [](interface)[i] = true;
-   }
+   bloomFilter->Set(cell, interface, bloomFilter->GetMax());
    return true;
 }
 
 
 // SET ZERO FILTER CELL
-inline bool BloomFilterBase::SetZeroFilterCell(std::size_t cell, std::size_t interface)
+bool BloomFilterBase::SetZeroFilterCell(std::size_t cell, std::size_t interface)
 {
 	if (cell > bfParam->bfRawLengthBit) {
 	       std::cout << "Cell number greater than the filter size! Impossible to insert the element!";
 	   	   exit(1);
 	}
 
-	std::size_t msb = bloomFilter->operator [](interface).size() - (cell * bfParam->bfCellWidth) - 1;
-	std::size_t lsb = msb - (bfParam->bfCellWidth - 1);
-	std::size_t i;
-
-	for (i = lsb; i <= msb; i++) {
-	   bloomFilter->operator [](interface)[i] = false;
-	}
+	bloomFilter->Set(cell, interface, 0);
 	return true;
 }
 
 
 // LOOKUP
 
-inline bool BloomFilterBase::LookupFilter(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
+bool BloomFilterBase::LookupFilter(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
 {
-	std::size_t bit_index = 0;
-    std::size_t bit = 0;
+	PrefixHash hash = HashKey(key_begin, length);
 
 	for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
 	{
-	    //ComputeIndicesStableFib(hash_ap(key_begin, length, bfStableFibSeeds[i]),bit_index,bit);
-	    ComputeIndicesFilter(MurmurHash3(key_begin, length, bfSeeds->operator [](i)),bit_index,bit);
-
-	    uint32_t counter = CountCell(bit_index, interface);
+	    uint32_t counter = CountCell(GetFilterIndex(hash, i), interface);
 		if (counter==0)
 		{
 			  return false;
@@ -419,17 +362,17 @@ inline bool BloomFilterBase::LookupFilter(const unsigned char* key_begin, const
 
 
 template<typename T>
-   inline bool BloomFilterBase::LookupFilter(const T& t, const std::size_t interface)
+   bool BloomFilterBase::LookupFilter(const T& t, const std::size_t interface)
    {
       return BloomFilterBase::LookupFilter(reinterpret_cast<const unsigned char*>(&t),static_cast<std::size_t>(sizeof(T)), interface);
    }
-   inline bool BloomFilterBase::LookupFilter(const std::string& key, const std::size_t interface)
+   bool BloomFilterBase::LookupFilter(const std::string& key, const std::size_t interface)
    {
       return BloomFilterBase::LookupFilter(reinterpret_cast<const unsigned char*>(key.c_str()),key.size(), interface);
    }
 
 template<typename InputIterator>
-   inline bool BloomFilterBase::LookupFilter(const InputIterator begin, const InputIterator end, const std::size_t interface)
+   bool BloomFilterBase::LookupFilter(const InputIterator begin, const InputIterator end, const std::size_t interface)
    {
       InputIterator itr = begin;
       while (end != itr)
@@ -441,7 +384,7 @@ template<typename InputIterator>
 
 // COUNT
 
-inline uint32_t BloomFilterBase::CountCell(std::size_t cell, std::size_t interface) const
+uint32_t BloomFilterBase::CountCell(std::size_t cell, std::size_t interface) const
 {
 
 	if (cell > bfParam->bfRawLengthBit) {
@@ -449,21 +392,7 @@ inline uint32_t BloomFilterBase::CountCell(std::size_t cell, std::size_t interfa
 	   	   exit(1);
 	}
 
-	uint32_t counter = 0;
-	uint32_t numPos = 0;
-
-	std::size_t msb = bloomFilter->operator [](interface).size() - (cell * bfParam->bfCellWidth) - 1;
-	std::size_t lsb = msb - (bfParam->bfCellWidth - 1);
-	std::size_t i;
-
-	for (i=lsb; i<=msb; i++)
-	{
-       if (bloomFilter->operator [](interface)[i]) {
-    	   counter = counter + std::pow(2,numPos);
-    	   numPos++;
-       }
-	}
-    return counter;
+    return BloomFilterCells::Weight(bloomFilter->Get(cell, interface));
 }
 
 
@@ -543,7 +472,7 @@ BloomFilterBase::bestFibEntry& BloomFilterBase::LookupOrderedBloomFilters (Ptr<c
  */
 
 
-inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const unsigned char* key_begin, const std::size_t length, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
+std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const unsigned char* key_begin, const std::size_t length, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
 {
 
 	//NS_LOG_UNCOND("Interest incoming interface:\t" << inc_interface);
@@ -583,7 +512,6 @@ inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBl
 	// ** [MT] ** Searching in the SBFs
 
 	std::size_t bitIndex = 0;
-    std::size_t bit = 0;
 
     std::vector<uint32_t> countersInterf (nodeInterfaces, 0);    	// ** [MT] ** Vector containing the counters associated with each interface.
 
@@ -594,18 +522,19 @@ inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBl
 	if (evict)
        present[idIncInterface] = false;
 
+	// ** If the cells of all the interfaces fit in one word, every hash index is checked on all the interfaces
+	//    with a single read of the filters.
+	bool packed = bloomFilter->IsGroupPacked() && nodeInterfaces <= bloomFilter->GetNInterfaces();
+	uint32_t cellWidth = bloomFilter->GetCellWidth();
+	uint32_t cellMax = bloomFilter->GetMax();
 
-	// ** [MT] ** The content name is extracted from the header; each name component will be inserted in a separate
-	//            component of the string list.
 
-	uint32_t numNameComponents = header->GetNamePtr()->GetComponents().size();
-	bool first = true;
-	std::list<std::string> interestName (numNameComponents);
-	interestName.assign(header->GetNamePtr()->GetComponents().begin(), header->GetNamePtr()->GetComponents().end());
-    std::list<std::string>::iterator it;
-    it = interestName.begin();                 // The iterator points to the first component.
-    std::stringstream ss;
-    std::string prefixName;
+	// ** The hashes of all the prefixes of the content name are computed at once: every component is hashed
+	//    only once, instead of hashing again every prefix for each of the 'k' hash functions.
+
+	std::vector<PrefixHash> prefixHashes;
+	HashKey(*header->GetNamePtr(), &prefixHashes);
+	uint32_t numNameComponents = prefixHashes.size() - 1;
 
 
 	// ** [MT] ** FOR cycle for every component of the name
@@ -628,34 +557,20 @@ inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBl
 			return orderedInterfaces;
 		}
 
-    	if(!first)
-    		interestName.pop_back();         // ** [MT] ** Evict the last component of the name.
-
-    	for(uint32_t d=1; d <=t; d++ )
-    	{
-    		ss << "/" << (*it);
-    		it++;
-    	}
-    	prefixName = ss.str();
-    	first = false;
-    	//NS_LOG_UNCOND("Searching for Interest name: \t" << composed_name);
-    	it = interestName.begin();
-    	ss.str("");
-
-        const unsigned char* prefName = reinterpret_cast<const unsigned char*>(prefixName.c_str());
-		const std::size_t prefixSize = prefixName.size();
+    	const PrefixHash &prefixHash = prefixHashes[t];    // ** Prefix with the first 't' components of the name.
 
         // ** [MT] ** Searching for a match for each of the 'k' hash function.
 		for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
 		{
-		    //ComputeIndicesSimpleFib(hash_ap(prefName,prefixSize,bfSimpleFibSeeds[i]),bitIndexSimple,bitSimple);
-		    ComputeIndicesFilter(MurmurHash3(prefName,prefixSize,bfSeeds->operator [](i)),bitIndex,bit);
+		    bitIndex = GetFilterIndex(prefixHash, i);
+
+		    uint64_t group = packed ? bloomFilter->GetGroup(bitIndex) : 0;
 
 			for (std::size_t j = 0; j < nodeInterfaces; j++)
 			{
 			   if (present[j])
 			   {
-				  uint32_t counter = CountCell(bitIndex, j);
+				  uint32_t counter = packed ? BloomFilterCells::Weight((group >> (j * cellWidth)) & cellMax) : CountCell(bitIndex, j);
 				  if (counter!=0)
 				  {
 					  countersInterf[j] += counter;
@@ -767,15 +682,15 @@ inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBl
 }
 
 template<typename T>
-inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const T& t, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
+std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const T& t, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
 {
    return MakeCustomLookupBloomFilters(reinterpret_cast<const unsigned char*>(&t),static_cast<std::size_t>(sizeof(T)), header, idIncInterface, nodeInterfaces, evict);
 }
-inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const std::string& key, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
+std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const std::string& key, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
 {
    return MakeCustomLookupBloomFilters(reinterpret_cast<const unsigned char*>(key.c_str()),key.size(), header, idIncInterface, nodeInterfaces, evict);
 }
-inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const char* data, const std::size_t& length, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
+std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBloomFilters(const char* data, const std::size_t& length, Ptr<const Interest> header, uint32_t idIncInterface, uint32_t nodeInterfaces, bool evict) const
 {
    return MakeCustomLookupBloomFilters(reinterpret_cast<const unsigned char*>(data),length, header, idIncInterface, nodeInterfaces, evict);
 }
@@ -783,12 +698,12 @@ inline std::vector<std::vector<uint32_t> > * BloomFilterBase::MakeCustomLookupBl
 
 void BloomFilterBase::ClearFilter(uint32_t interface)
 {
-	bloomFilter->operator [](interface).reset();
+	bloomFilter->Reset(interface);
 }
 
 void BloomFilterBase::SetFilter(uint32_t interface)
 {
-	bloomFilter->operator [](interface).set();
+	bloomFilter->Fill(interface);
 }
 
 void BloomFilterBase::SetBloomFilterFlag(bool value)
@@ -827,10 +742,109 @@ BloomFilterBase::GetL3Protocol() const
 
 
 
-inline void BloomFilterBase::ComputeIndicesFilter(const uint32_t& hash, std::size_t& bit_index, std::size_t& bit) const
+namespace {
+
+uint32_t Rotl32(uint32_t x, int r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+// ** Body step of MurmurHash3: the hash of a component is mixed into the state of the prefix, as a 4-byte block.
+uint32_t MixComponent(uint32_t state, uint32_t component)
+{
+    component *= 0xcc9e2d51;
+    component = Rotl32(component, 15);
+    component *= 0x1b873593;
+
+    state ^= component;
+    state = Rotl32(state, 13);
+    return state * 5 + 0xe6546b64;
+}
+
+// ** Finalization of MurmurHash3, with the number of components as length.
+uint32_t FinalizePrefix(uint32_t state, uint32_t components)
+{
+    state ^= components;
+    state ^= state >> 16;
+    state *= 0x85ebca6b;
+    state ^= state >> 13;
+    state *= 0xc2b2ae35;
+    state ^= state >> 16;
+    return state;
+}
+
+BloomFilterBase::PrefixHash MakePrefixHash(uint32_t state1, uint32_t state2, uint32_t components)
+{
+    // h2 is odd, so it is never a multiple of an even filter length (all the 'k' indices would be the same)
+    BloomFilterBase::PrefixHash hash = { FinalizePrefix(state1, components), FinalizePrefix(state2, components) | 1 };
+    return hash;
+}
+
+}
+
+void BloomFilterBase::AddPrefixComponent(const unsigned char* component, std::size_t length, uint32_t& state1, uint32_t& state2,
+                                         std::vector<PrefixHash>* prefixes, uint32_t& components) const
+{
+    state1 = MixComponent(state1, MurmurHash3(component, length, bfSeeds->operator [](0)));
+    state2 = MixComponent(state2, MurmurHash3(component, length, bfSeeds->operator [](1)));
+    ++components;
+
+    if (prefixes)
+    	prefixes->push_back(MakePrefixHash(state1, state2, components));
+}
+
+BloomFilterBase::PrefixHash BloomFilterBase::HashKey(const unsigned char* key_begin, std::size_t length, std::vector<PrefixHash>* prefixes) const
+{
+    uint32_t state1 = bfSeeds->operator [](0);
+    uint32_t state2 = bfSeeds->operator [](1);
+    uint32_t components = 0;
+
+    if (prefixes)
+    {
+    	prefixes->clear();
+    	prefixes->push_back(MakePrefixHash(state1, state2, 0));
+    }
+
+    const unsigned char* end = key_begin + length;
+    for (const unsigned char* component = key_begin; component < end; )
+    {
+    	const unsigned char* next = static_cast<const unsigned char*>(memchr(component, '/', end - component));
+    	if (next == 0)
+    		next = end;
+
+    	if (next > component)    // Empty components (leading or repeated '/') are skipped.
+    		AddPrefixComponent(component, next - component, state1, state2, prefixes, components);
+    	component = next + 1;
+    }
+
+    return MakePrefixHash(state1, state2, components);
+}
+
+BloomFilterBase::PrefixHash BloomFilterBase::HashKey(const Name& name, std::vector<PrefixHash>* prefixes) const
+{
+    uint32_t state1 = bfSeeds->operator [](0);
+    uint32_t state2 = bfSeeds->operator [](1);
+    uint32_t components = 0;
+
+    if (prefixes)
+    {
+    	prefixes->clear();
+    	prefixes->push_back(MakePrefixHash(state1, state2, 0));
+    }
+
+    for (std::size_t i = 0; i < name.size(); ++i)
+    {
+    	if (name.GetComponentSize(i) > 0)    // Same prefixes as the string "/first/second/...".
+    		AddPrefixComponent(reinterpret_cast<const unsigned char*>(name.GetComponentData(i)), name.GetComponentSize(i),
+    		                   state1, state2, prefixes, components);
+    }
+
+    return MakePrefixHash(state1, state2, components);
+}
+
+std::size_t BloomFilterBase::GetFilterIndex(const PrefixHash& hash, uint32_t i) const
 {
-    bit_index = hash % bfParam->bfRawLengthBit;
-    bit = bit_index % bits_per_char;
+    return (static_cast<uint64_t>(hash.h1) + i * static_cast<uint64_t>(hash.h2)) % bfParam->bfRawLengthBit;
 }
 
 
@@ -839,7 +853,8 @@ void BloomFilterBase::GenerateSeedsHash()
    // To obtain different hash functions, the same function is seeded with different seeds.
 
    srand(static_cast<uint32_t>(randomSeed));
-   while (bfSeeds->size() < bfParam->bfNumHashFunctions)
+   // Double hashing of the keys (see HashKey) needs two seeds, even with a single hash function.
+   while (bfSeeds->size() < std::max<uint32_t>(bfParam->bfNumHashFunctions, 2))
    {
        uint32_t currentSeed = static_cast<uint32_t>(rand()) * static_cast<uint32_t>(rand());
        if (currentSeed == 0) continue;
@@ -853,7 +868,7 @@ void BloomFilterBase::GenerateSeedsHash()
 
 // ** Implementation of the Arash Partow hash function.
 
-inline uint32_t BloomFilterBase::hash_ap(const unsigned char* begin, std::size_t remaining_length, uint32_t hash) const
+uint32_t BloomFilterBase::hash_ap(const unsigned char* begin, std::size_t remaining_length, uint32_t hash) const
 {
     const unsigned char* itr = begin;
     unsigned int loop = 0;
@@ -894,7 +909,7 @@ inline uint32_t BloomFilterBase::hash_ap(const unsigned char* begin, std::size_t
 }
 
 // ** Implementation of the Murmur3 hash function
-inline uint32_t BloomFilterBase::MurmurHash3 (const unsigned char * key, std::size_t len, uint32_t seed) const
+uint32_t BloomFilterBase::MurmurHash3 (const unsigned char * key, std::size_t len, uint32_t seed) const
 {
   const uint8_t * data = (const uint8_t*)key;
   const int nblocks = len / 4;
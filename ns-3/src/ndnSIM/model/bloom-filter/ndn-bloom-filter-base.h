@@ -39,13 +39,13 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <ctime>
-#include <boost/dynamic_bitset.hpp>
 
 #include "ns3/simple-ref-count.h"
 #include "ns3/node.h"
 #include "ns3/ndnSIM-module.h"
 #include "ns3/core-module.h"
 #include "ns3/log.h"
+#include "ns3/ndnSIM/model/bloom-filter/ndn-bloom-filter-cells.h"
 
 namespace ns3 {
 namespace ndn {
@@ -75,6 +75,15 @@ public:
      bool found;
    };
 
+   /** ** Hash of a key (name prefix) for the double hashing scheme: the 'k' indices of the key are
+    *       (h1 + i * h2) % length, with 0 <= i < k.
+    */
+   struct PrefixHash
+   {
+     uint32_t h1;
+     uint32_t h2;
+   };
+
    struct bfParameters
    {
 	   bfParameters (uint64_t _bfRawLengthBit, uint64_t _bfLengthBit, uint64_t _bfRawLengthByte,
@@ -128,7 +137,7 @@ public:
    *
    */
 
-   std::size_t GetBloomFilterSize(uint32_t interface) {return bloomFilter->operator [](interface).size(); }
+   std::size_t GetBloomFilterSize(uint32_t interface) {return bloomFilter->GetNCells() * bloomFilter->GetCellWidth(); }
 
 
    // ** [MT] ** Function used to insert an element in the SBF. At every insertion, 'p' random cells are decremented by one.
@@ -237,14 +246,29 @@ protected:
    virtual void ExtractOptimum(uint64_t M, double pfp) = 0;
 
 
-   void ComputeIndicesFilter(const uint32_t& hash, std::size_t& bit_index, std::size_t& bit) const;
+   /** ** Hash of a key, whose components are separated by '/' (e.g., "/first/second").
+    *
+    *       Every component is hashed only once, and the hash of a prefix is derived from the hash of the prefix
+    *       without its last component, so the hashes of all the prefixes of a name cost as much as the hash of the name.
+    *       If 'prefixes' is given, it is filled with the hashes of all the prefixes: prefixes[t] is the hash of the
+    *       first 't' components (prefixes[0] is the hash of the empty name).
+    */
+   PrefixHash HashKey(const unsigned char* key_begin, std::size_t length, std::vector<PrefixHash>* prefixes = 0) const;
+
+   PrefixHash HashKey(const Name& name, std::vector<PrefixHash>* prefixes = 0) const;
+
+   // ** Index of the cell for the i-th hash function.
+   std::size_t GetFilterIndex(const PrefixHash& hash, uint32_t i) const;
 
    void GenerateSeedsHash();
 
    uint32_t hash_ap(const unsigned char* begin, std::size_t remaining_length, uint32_t hash) const;
    uint32_t MurmurHash3 (const unsigned char * key, std::size_t len, uint32_t seed) const;
 
-   std::vector<boost::dynamic_bitset<> >*  bloomFilter;       			   // There are as many SBFs as the number of interfaces.
+   void AddPrefixComponent(const unsigned char* component, std::size_t length, uint32_t& state1, uint32_t& state2,
+                           std::vector<PrefixHash>* prefixes, uint32_t& components) const;
+
+   BloomFilterCells*  bloomFilter;       			   // Counters of the SBFs of all the interfaces (one SBF per interface).
 
    std::vector<uint32_t>* 				bfSeeds;
 
@@ -0,0 +1,108 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Polytechnic of Bari, Italy
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-bloom-filter-cells.h"
+
+#include "ns3/log.h"
+#include "ns3/fatal-error.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.bf.Cells");
+
+namespace ns3 {
+namespace ndn {
+
+BloomFilterCells::BloomFilterCells ()
+  : m_words (1, 0)
+  , m_cells (0)
+  , m_cellWidth (1)
+  , m_interfaces (0)
+  , m_groupWidth (0)
+  , m_mask (1)
+{
+}
+
+void
+BloomFilterCells::Init (uint64_t cells, uint32_t cellWidth, uint32_t interfaces)
+{
+  if (cellWidth == 0 || cellWidth > 32)
+    NS_FATAL_ERROR ("Cell width of the Bloom filter must be from 1 to 32 bits, not " << cellWidth);
+
+  m_cells = cells;
+  m_cellWidth = cellWidth;
+  m_interfaces = interfaces;
+  m_groupWidth = cellWidth * interfaces;
+  m_mask = (static_cast<uint64_t> (1) << cellWidth) - 1;
+
+  m_words.assign ((cells * m_groupWidth + 63) / 64 + 1, 0);
+
+  NS_LOG_DEBUG (cells << " cells x " << interfaces << " interfaces, " << m_words.size () * 8 << " bytes");
+}
+
+void
+BloomFilterCells::Write (uint64_t bit, uint32_t width, uint64_t value)
+{
+  uint64_t word = bit >> 6;
+  uint32_t offset = bit & 63;
+  uint64_t mask = (width == 64) ? ~static_cast<uint64_t> (0) : (static_cast<uint64_t> (1) << width) - 1;
+
+  m_words[word] = (m_words[word] & ~(mask << offset)) | (value << offset);
+  if (offset + width > 64)
+    {
+      uint32_t shift = 64 - offset;
+      m_words[word + 1] = (m_words[word + 1] & ~(mask >> shift)) | (value >> shift);
+    }
+}
+
+bool
+BloomFilterCells::Increment (uint64_t cell, uint32_t interface)
+{
+  uint32_t value = Get (cell, interface);
+  if (value == m_mask)
+    return false;
+
+  Set (cell, interface, value + 1);
+  return true;
+}
+
+bool
+BloomFilterCells::Decrement (uint64_t cell, uint32_t interface)
+{
+  uint32_t value = Get (cell, interface);
+  if (value == 0)
+    return false;
+
+  Set (cell, interface, value - 1);
+  return true;
+}
+
+void
+BloomFilterCells::Reset (uint32_t interface)
+{
+  for (uint64_t cell = 0; cell < m_cells; cell ++)
+    Set (cell, interface, 0);
+}
+
+void
+BloomFilterCells::Fill (uint32_t interface)
+{
+  for (uint64_t cell = 0; cell < m_cells; cell ++)
+    Set (cell, interface, static_cast<uint32_t> (m_mask));
+}
+
+} // namespace ndn
+} // namespace ns3
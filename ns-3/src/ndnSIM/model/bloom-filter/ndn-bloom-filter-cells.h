@@ -0,0 +1,169 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2013 Polytechnic of Bari, Italy
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_BLOOM_FILTER_CELLS_H
+#define NDN_BLOOM_FILTER_CELLS_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Counters of the Bloom filters of all the interfaces of a node
+ *
+ * Every counter is cellWidth bits wide, and counters are packed in 64-bit words. The counters of
+ * the same cell of all the interfaces are stored next to each other (cell 0 of interfaces
+ * 0..n-1, then cell 1, ...), so a lookup reads the cell of every interface with a single
+ * GetGroup () instead of one bitset access per bit and per interface.
+ */
+class BloomFilterCells
+{
+public:
+  BloomFilterCells ();
+
+  /**
+   * \brief Allocate zeroed counters (previous content is discarded)
+   * \param cells number of cells of every filter
+   * \param cellWidth width of a counter [bit], from 1 to 32
+   * \param interfaces number of filters
+   */
+  void
+  Init (uint64_t cells, uint32_t cellWidth, uint32_t interfaces);
+
+  uint64_t
+  GetNCells () const { return m_cells; }
+
+  uint32_t
+  GetCellWidth () const { return m_cellWidth; }
+
+  uint32_t
+  GetNInterfaces () const { return m_interfaces; }
+
+  /**
+   * \brief Maximum value of a counter (all bits set)
+   */
+  uint32_t
+  GetMax () const { return static_cast<uint32_t> (m_mask); }
+
+  uint32_t
+  Get (uint64_t cell, uint32_t interface) const
+  {
+    return static_cast<uint32_t> (Read (Position (cell, interface), m_cellWidth));
+  }
+
+  void
+  Set (uint64_t cell, uint32_t interface, uint32_t value)
+  {
+    Write (Position (cell, interface), m_cellWidth, value & m_mask);
+  }
+
+  /**
+   * \brief Increment the counter
+   * \returns false if the counter is already at maximum (it is not changed)
+   */
+  bool
+  Increment (uint64_t cell, uint32_t interface);
+
+  /**
+   * \brief Decrement the counter
+   * \returns false if the counter is already zero
+   */
+  bool
+  Decrement (uint64_t cell, uint32_t interface);
+
+  /**
+   * \brief Set all counters of the interface to zero
+   */
+  void
+  Reset (uint32_t interface);
+
+  /**
+   * \brief Set all counters of the interface to maximum
+   */
+  void
+  Fill (uint32_t interface);
+
+  /**
+   * \brief Check if the cells of all the interfaces fit in the value returned by GetGroup ()
+   */
+  bool
+  IsGroupPacked () const { return m_groupWidth <= 64; }
+
+  /**
+   * \brief Get the counters of the cell of all the interfaces
+   *
+   * The counter of interface i is (group >> (i * GetCellWidth ())) & GetMax ().
+   * Can be used only if IsGroupPacked ()
+   */
+  uint64_t
+  GetGroup (uint64_t cell) const
+  {
+    return Read (cell * m_groupWidth, m_groupWidth);
+  }
+
+  /**
+   * \brief Weight of a counter in the lookups of BloomFilterBase: 2^(number of bits set) - 1
+   *
+   * This is the value the bitset implementation has always summed, and it is kept so
+   * the ordering of the interfaces does not change.
+   */
+  static uint32_t
+  Weight (uint32_t value)
+  {
+    return static_cast<uint32_t> ((static_cast<uint64_t> (1) << __builtin_popcount (value)) - 1);
+  }
+
+private:
+  uint64_t
+  Position (uint64_t cell, uint32_t interface) const
+  {
+    return cell * m_groupWidth + interface * m_cellWidth;
+  }
+
+  uint64_t
+  Read (uint64_t bit, uint32_t width) const
+  {
+    uint64_t word = bit >> 6;
+    uint32_t offset = bit & 63;
+
+    uint64_t value = m_words[word] >> offset;
+    if (offset + width > 64)
+      value |= m_words[word + 1] << (64 - offset);
+
+    return (width == 64) ? value : value & ((static_cast<uint64_t> (1) << width) - 1);
+  }
+
+  void
+  Write (uint64_t bit, uint32_t width, uint64_t value);
+
+private:
+  std::vector<uint64_t> m_words; ///< @brief counters, plus one word so reads never go past the end
+  uint64_t m_cells;
+  uint32_t m_cellWidth;
+  uint32_t m_interfaces;
+  uint32_t m_groupWidth;         ///< @brief bits used by one cell of all the interfaces
+  uint64_t m_mask;               ///< @brief mask of one counter
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BLOOM_FILTER_CELLS_H
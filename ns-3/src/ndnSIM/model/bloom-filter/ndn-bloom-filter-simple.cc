@@ -83,12 +83,10 @@ void BloomFilterSimple::InitBloomFilterOptimal (uint64_t M, double pfp, uint32_t
 
     GenerateSeedsHash();
 
+    bloomFilter->Init(bfParam->bfRawLengthBit, cW, interfaces);
+
     for (uint32_t i = 0; i < interfaces; ++i)
     {
-    	boost::dynamic_bitset<> bf;
-    	bf.resize(bfParam->bfLengthBit,false);
-    	bloomFilter->push_back(bf);
-
     	bfInsertedElements->push_back((uint32_t)0);
     	bfDeletedElements->push_back((uint32_t)0);
     }
@@ -117,12 +115,10 @@ void BloomFilterSimple::InitBloomFilterCustom (uint64_t M, double pfp, uint32_t
 
     GenerateSeedsHash();
 
+    bloomFilter->Init(bfParam->bfRawLengthBit, cW, interfaces);
+
     for (uint32_t i = 0; i < interfaces; ++i)
     {
-    	boost::dynamic_bitset<> bf;
-    	bf.resize(bfParam->bfLengthBit,false);
-    	bloomFilter->push_back(bf);
-
     	bfInsertedElements->push_back((uint32_t)0);
     	bfDeletedElements->push_back((uint32_t)0);
     }
@@ -157,14 +153,11 @@ void BloomFilterSimple::ExtractOptimum(uint64_t M, double pfp)
 // INSERT FOOTPRINT
 void BloomFilterSimple::InsertFootprint(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
 {
-    std::size_t bit_index = 0;
-    std::size_t bit = 0;
+    PrefixHash hash = HashKey(key_begin, length);
 
     for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
     {
-       ComputeIndicesFilter(MurmurHash3(key_begin,length,bfSeeds->operator [](i)),bit_index,bit);
-
-       IncrementFilterCell(bit_index, interface);
+       IncrementFilterCell(GetFilterIndex(hash, i), interface);
     }
     ++bfInsertedElements->operator [](interface);
 }
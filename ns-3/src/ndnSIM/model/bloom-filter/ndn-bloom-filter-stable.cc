@@ -84,12 +84,10 @@ void BloomFilterStable::InitBloomFilterOptimal (uint64_t M, double pfp, uint32_t
 
     GenerateSeedsHash();
 
+    bloomFilter->Init(bfParam->bfRawLengthBit, cW, interfaces);
+
     for (uint32_t i = 0; i < interfaces; ++i)
     {
-    	boost::dynamic_bitset<> bf;
-    	bf.resize(bfParam->bfLengthBit,false);
-    	bloomFilter->push_back(bf);
-
     	bfInsertedElements->push_back((uint32_t)0);
     	bfDeletedElements->push_back((uint32_t)0);
     }
@@ -121,12 +119,10 @@ void BloomFilterStable::InitBloomFilterCustom (uint64_t M, double pfp, uint32_t
 
     GenerateSeedsHash();
 
+    bloomFilter->Init(bfParam->bfRawLengthBit, cW, interfaces);
+
     for (uint32_t i = 0; i < interfaces; ++i)
     {
-    	boost::dynamic_bitset<> bf;
-    	bf.resize(bfParam->bfLengthBit,false);
-    	bloomFilter->push_back(bf);
-
     	bfInsertedElements->push_back((uint32_t)0);
     	bfDeletedElements->push_back((uint32_t)0);
     }
@@ -171,9 +167,6 @@ void BloomFilterStable::ExtractOptimum(uint64_t M, double pfp)
 // INSERT FOOTPRINT
 void BloomFilterStable::InsertFootprint(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
 {
-    std::size_t bit_index = 0;
-    std::size_t bit = 0;
-
     // ** Determine the 'p' random cells to be decremented.
     for (size_t i = 0; i < bfStableP; ++i)
     {
@@ -181,18 +174,14 @@ void BloomFilterStable::InsertFootprint(const unsigned char* key_begin, const st
    	  DecrementFilterCell(decCell, interface);
     }
 
-    // ** The "k" different hash functions are obtained by changing the seed of the same hash function.
+    // ** The "k" different hash functions are obtained from the two hashes of the key (double hashing).
+    PrefixHash hash = HashKey(key_begin, length);
 
     for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
     {
-    	// ** The indexes are evaluated using the Arash Partow hash function.
-    	//ComputeIndicesStableFib(hash_ap(key_begin,length,bfStableFibSeeds[i]),bit_index,bit);
-    	ComputeIndicesFilter(MurmurHash3(key_begin,length,bfSeeds->operator [](i)),bit_index,bit);
-
-    	// ** The evaluated 'bit_index' is passed to the function 'set_max', which determines the position of the specified cell in the SBF
+    	// ** The evaluated index is passed to the function 'set_max', which determines the position of the specified cell in the SBF
     	// and sets to 'Max' the respective counter.
-    	SetMaxFilterCell(bit_index, interface);
-
+    	SetMaxFilterCell(GetFilterIndex(hash, i), interface);
     }
     ++bfInsertedElements->operator [](interface);
 }
@@ -204,36 +193,31 @@ void BloomFilterStable::InsertFootprint(const std::string& key, const std::size_
 }
 
 // ** [MT] ** Insert elements without decrementing the 'p' random cells.
-inline void BloomFilterStable::InsertFootprintStableNoDecrement(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
+void BloomFilterStable::InsertFootprintStableNoDecrement(const unsigned char* key_begin, const std::size_t& length, const std::size_t interface)
 {
-   std::size_t bitIndex = 0;
-   std::size_t bit = 0;
-
-   // ** The "k" different hash functions are obtained by changing the seed of the same hash function.
+   // ** The "k" different hash functions are obtained from the two hashes of the key (double hashing).
+   PrefixHash hash = HashKey(key_begin, length);
 
    for (std::size_t i = 0; i < bfParam->bfNumHashFunctions; ++i)
    {
-	   //ComputeIndicesStableFib(hash_ap(key_begin,length,bfStableFibSeeds[i]),bitIndex,bit);
-	   ComputeIndicesFilter(MurmurHash3(key_begin,length,bfSeeds->operator [](i)),bitIndex,bit);
-       SetMaxFilterCell(bitIndex, interface);
-
+       SetMaxFilterCell(GetFilterIndex(hash, i), interface);
    }
    ++bfInsertedElements->operator [](interface);
 }
 
 template<typename T>
-inline void BloomFilterStable::InsertFootprintStableNoDecrement(const T& t, const std::size_t interface)
+void BloomFilterStable::InsertFootprintStableNoDecrement(const T& t, const std::size_t interface)
 {
    BloomFilterStable::InsertFootprintStableNoDecrement(reinterpret_cast<const unsigned char*>(&t),sizeof(T), interface);
 }
 
-inline void BloomFilterStable::InsertFootprintStableNoDecrement(const std::string& key, const std::size_t interface)
+void BloomFilterStable::InsertFootprintStableNoDecrement(const std::string& key, const std::size_t interface)
 {
    BloomFilterStable::InsertFootprintStableNoDecrement(reinterpret_cast<const unsigned char*>(key.c_str()),key.size(), interface);
 }
 
 template<typename InputIterator>
-inline void BloomFilterStable::InsertFootprintStableNoDecrement(const InputIterator begin, const InputIterator end, const std::size_t interface)
+void BloomFilterStable::InsertFootprintStableNoDecrement(const InputIterator begin, const InputIterator end, const std::size_t interface)
 {
    InputIterator itr = begin;
    while (end != itr)
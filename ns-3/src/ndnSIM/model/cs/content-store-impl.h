@@ -98,6 +98,9 @@ public:
   virtual inline void
   Print (std::ostream &os) const;
 
+  virtual inline void
+  Snapshot (std::vector< std::pair<Ptr<Entry>, uint8_t> > &entries);
+
   virtual uint32_t
   GetSize () const;
 
@@ -222,6 +225,21 @@ ContentStoreImpl<Policy>::Print (std::ostream &os) const
     }
 }
 
+template<class Policy>
+void
+ContentStoreImpl<Policy>::Snapshot (std::vector< std::pair<Ptr<Entry>, uint8_t> > &entries)
+{
+  // from the next victim to the last one: adding them in this order rebuilds LRU and FIFO
+  // orders (LFU access counts are not kept)
+  entries.clear ();
+  for (typename super::policy_container::iterator item = this->getPolicy ().begin ();
+       item != this->getPolicy ().end ();
+       item++)
+    {
+      entries.push_back (std::make_pair (item->payload (), 0));
+    }
+}
+
 template<class Policy>
 void
 ContentStoreImpl<Policy>::SetMaxSize (uint32_t maxSize)
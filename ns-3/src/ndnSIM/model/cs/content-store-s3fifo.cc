@@ -0,0 +1,424 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "content-store-s3fifo.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/ndn-name.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/string.h"
+
+#include <boost/tuple/tuple.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.cs.S3Fifo");
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+NS_OBJECT_ENSURE_REGISTERED (S3Fifo);
+
+static const uint8_t MAX_FREQUENCY = 3;
+
+TypeId
+S3Fifo::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::cs::S3Fifo")
+    .SetGroupName ("Ndn")
+    .SetParent<ContentStore> ()
+    .AddConstructor< S3Fifo > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in ContentStore. If 0, limit is not enforced",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&S3Fifo::m_maxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("MaxBytes",
+                   "Set maximum number of bytes of the cached contents (payload and ContentObject header). If 0, limit is not enforced",
+                   StringValue ("0"),
+                   MakeUintegerAccessor (&S3Fifo::m_maxBytes),
+                   MakeUintegerChecker<uint64_t> ())
+    .AddAttribute ("SmallQueueRatio",
+                   "Share of the capacity used by the small FIFO queue, where new contents are inserted",
+                   DoubleValue (0.1),
+                   MakeDoubleAccessor (&S3Fifo::m_smallRatio),
+                   MakeDoubleChecker<double> (0.0, 1.0))
+
+    .AddTraceSource ("DidAddEntry", "Trace fired every time entry is successfully added to the cache",
+                     MakeTraceSourceAccessor (&S3Fifo::m_didAddEntry))
+    ;
+
+  return tid;
+}
+
+S3Fifo::S3Fifo ()
+  : m_index (16, 0)
+  , m_smallBytes (0)
+  , m_bytes (0)
+{
+}
+
+S3Fifo::~S3Fifo ()
+{
+}
+
+int32_t
+S3Fifo::Find (const Name &name, std::size_t hash) const
+{
+  uint32_t mask = m_index.size () - 1;
+  for (uint32_t bucket = hash & mask; m_index[bucket] != 0; bucket = (bucket + 1) & mask)
+    {
+      const Slot &slot = m_slots[m_index[bucket] - 1];
+      if (slot.m_hash == hash && slot.m_entry->GetName () == name)
+        return m_index[bucket] - 1;
+    }
+
+  return -1;
+}
+
+void
+S3Fifo::Insert (uint32_t slot)
+{
+  // load factor is kept at most 1/2, so the probe sequences stay short
+  if (2 * GetSize () > m_index.size ())
+    Resize (2 * m_index.size ());
+
+  uint32_t mask = m_index.size () - 1;
+  uint32_t bucket = m_slots[slot].m_hash & mask;
+  while (m_index[bucket] != 0)
+    bucket = (bucket + 1) & mask;
+
+  m_index[bucket] = slot + 1;
+}
+
+void
+S3Fifo::Remove (uint32_t slot)
+{
+  uint32_t mask = m_index.size () - 1;
+  uint32_t bucket = m_slots[slot].m_hash & mask;
+  while (m_index[bucket] != slot + 1)
+    bucket = (bucket + 1) & mask;
+
+  // shift back the following entries that would not be found anymore after the bucket is emptied
+  for (uint32_t next = (bucket + 1) & mask; m_index[next] != 0; next = (next + 1) & mask)
+    {
+      uint32_t home = m_slots[m_index[next] - 1].m_hash & mask;
+      if (((next - home) & mask) >= ((next - bucket) & mask))
+        {
+          m_index[bucket] = m_index[next];
+          bucket = next;
+        }
+    }
+  m_index[bucket] = 0;
+
+  Slot &item = m_slots[slot];
+  m_bytes -= item.m_bytes;
+  if (!item.m_main)
+    m_smallBytes -= item.m_bytes;
+
+  item.m_entry = 0;
+  m_freeSlots.push_back (slot);
+}
+
+void
+S3Fifo::Resize (uint32_t buckets)
+{
+  NS_LOG_DEBUG ("Resize index to " << buckets << " buckets");
+
+  m_index.assign (buckets, 0);
+  uint32_t mask = buckets - 1;
+  for (uint32_t slot = 0; slot < m_slots.size (); slot++)
+    {
+      if (m_slots[slot].m_entry == 0)
+        continue;
+
+      uint32_t bucket = m_slots[slot].m_hash & mask;
+      while (m_index[bucket] != 0)
+        bucket = (bucket + 1) & mask;
+      m_index[bucket] = slot + 1;
+    }
+}
+
+bool
+S3Fifo::IsFull (uint32_t bytes) const
+{
+  return (m_maxSize != 0 && GetSize () >= m_maxSize) ||
+    (m_maxBytes != 0 && m_bytes + bytes > m_maxBytes);
+}
+
+bool
+S3Fifo::IsSmallFull () const
+{
+  return (m_maxSize != 0 && m_small.size () >= m_smallRatio * m_maxSize) ||
+    (m_maxBytes != 0 && m_smallBytes >= m_smallRatio * m_maxBytes);
+}
+
+void
+S3Fifo::Evict ()
+{
+  while (true)
+    {
+      if (!m_small.empty () && (IsSmallFull () || m_main.empty ()))
+        {
+          uint32_t slot = m_small.back ();
+          m_small.pop_back ();
+
+          Slot &item = m_slots[slot];
+          if (item.m_frequency > 0)
+            {
+              // requested again while in the small queue
+              item.m_frequency = 0;
+              item.m_main = true;
+              m_smallBytes -= item.m_bytes;
+              m_main.push_front (slot);
+              continue;
+            }
+
+          NS_LOG_DEBUG ("Evict " << item.m_entry->GetName () << " from the small queue");
+          AddGhost (item.m_hash);
+          Remove (slot);
+          return;
+        }
+      else
+        {
+          uint32_t slot = m_main.back ();
+          m_main.pop_back ();
+
+          Slot &item = m_slots[slot];
+          if (item.m_frequency > 0)
+            {
+              item.m_frequency --;
+              m_main.push_front (slot);
+              continue;
+            }
+
+          NS_LOG_DEBUG ("Evict " << item.m_entry->GetName () << " from the main queue");
+          Remove (slot);
+          return;
+        }
+    }
+}
+
+void
+S3Fifo::AddGhost (std::size_t hash)
+{
+  m_ghost.push_back (hash);
+  m_ghostCount[hash] ++;
+
+  // the ghost queue remembers as many contents as the cache holds
+  while (m_ghost.size () > std::max<std::size_t> (GetSize (), 1))
+    {
+      boost::unordered_map<std::size_t, uint32_t>::iterator item = m_ghostCount.find (m_ghost.front ());
+      if (-- item->second == 0)
+        m_ghostCount.erase (item);
+
+      m_ghost.pop_front ();
+    }
+}
+
+bool
+S3Fifo::IsGhost (std::size_t hash) const
+{
+  return m_ghostCount.find (hash) != m_ghostCount.end ();
+}
+
+boost::tuple<Ptr<Packet>, Ptr<const ContentObject>, Ptr<const Packet> >
+S3Fifo::Lookup (Ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION (this << interest->GetName ());
+
+  int32_t slot = Find (interest->GetName (), hash_value (interest->GetName ()));
+  if (slot >= 0)
+    {
+      Slot &item = m_slots[slot];
+      if (item.m_frequency < MAX_FREQUENCY)
+        item.m_frequency ++;
+
+      this->m_cacheHitsTrace (interest, item.m_entry->GetHeader ());
+      return boost::make_tuple (item.m_entry->GetFullyFormedNdnPacket (),
+                                item.m_entry->GetHeader (),
+                                item.m_entry->GetPacket ());
+    }
+  else
+    {
+      this->m_cacheMissesTrace (interest);
+      return boost::tuple<Ptr<Packet>, Ptr<ContentObject>, Ptr<Packet> > (0, 0, 0);
+    }
+}
+
+bool
+S3Fifo::Add (Ptr<const ContentObject> header, Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << header->GetName ());
+
+  std::size_t hash = hash_value (header->GetName ());
+  if (Find (header->GetName (), hash) >= 0)
+    return false;
+
+  uint32_t bytes = packet->GetSize () + header->GetSerializedSize ();
+  if (m_maxBytes != 0 && bytes > m_maxBytes)
+    return false; // cannot insert entry
+
+  while (GetSize () > 0 && IsFull (bytes))
+    {
+      Evict ();
+    }
+
+  uint32_t slot;
+  if (m_freeSlots.empty ())
+    {
+      slot = m_slots.size ();
+      m_slots.push_back (Slot ());
+    }
+  else
+    {
+      slot = m_freeSlots.back ();
+      m_freeSlots.pop_back ();
+    }
+
+  Slot &item = m_slots[slot];
+  item.m_entry = Create<Entry> (this, header, packet);
+  item.m_hash = hash;
+  item.m_bytes = bytes;
+  item.m_frequency = 0;
+  item.m_main = IsGhost (hash); // evicted too early from the small queue
+
+  if (item.m_main)
+    m_main.push_front (slot);
+  else
+    {
+      m_small.push_front (slot);
+      m_smallBytes += bytes;
+    }
+  m_bytes += bytes;
+  Insert (slot);
+
+  m_didAddEntry (item.m_entry);
+  return true;
+}
+
+void
+S3Fifo::Print (std::ostream &os) const
+{
+  for (std::deque<uint32_t>::const_iterator slot = m_small.begin (); slot != m_small.end (); slot++)
+    {
+      os << m_slots[*slot].m_entry->GetName () << std::endl;
+    }
+  for (std::deque<uint32_t>::const_iterator slot = m_main.begin (); slot != m_main.end (); slot++)
+    {
+      os << m_slots[*slot].m_entry->GetName () << std::endl;
+    }
+}
+
+uint32_t
+S3Fifo::GetSize () const
+{
+  return m_slots.size () - m_freeSlots.size ();
+}
+
+uint64_t
+S3Fifo::GetBytes () const
+{
+  return m_bytes;
+}
+
+void
+S3Fifo::Snapshot (std::vector< std::pair<Ptr<Entry>, uint8_t> > &entries)
+{
+  // Add () and Restore () push contents at the front of the queues
+  entries.clear ();
+  for (std::deque<uint32_t>::const_reverse_iterator slot = m_main.rbegin (); slot != m_main.rend (); slot++)
+    {
+      entries.push_back (std::make_pair (m_slots[*slot].m_entry, MAIN_QUEUE | m_slots[*slot].m_frequency));
+    }
+  for (std::deque<uint32_t>::const_reverse_iterator slot = m_small.rbegin (); slot != m_small.rend (); slot++)
+    {
+      entries.push_back (std::make_pair (m_slots[*slot].m_entry, m_slots[*slot].m_frequency));
+    }
+}
+
+bool
+S3Fifo::Restore (Ptr<const ContentObject> header, Ptr<const Packet> packet, uint8_t state)
+{
+  if (!Add (header, packet))
+    return false;
+
+  // Add () has just pushed the content at the front of one of the queues
+  bool main = (state & MAIN_QUEUE) != 0;
+  uint32_t slot = Find (header->GetName (), hash_value (header->GetName ()));
+  Slot &item = m_slots[slot];
+  if (item.m_main != main)
+    {
+      if (main)
+        {
+          m_small.pop_front ();
+          m_smallBytes -= item.m_bytes;
+          m_main.push_front (slot);
+        }
+      else
+        {
+          m_main.pop_front ();
+          m_small.push_front (slot);
+          m_smallBytes += item.m_bytes;
+        }
+      item.m_main = main;
+    }
+  item.m_frequency = std::min<uint8_t> (state & ~MAIN_QUEUE, MAX_FREQUENCY);
+  return true;
+}
+
+Ptr<Entry>
+S3Fifo::Begin ()
+{
+  for (uint32_t slot = 0; slot < m_slots.size (); slot++)
+    {
+      if (m_slots[slot].m_entry != 0)
+        return m_slots[slot].m_entry;
+    }
+
+  return End ();
+}
+
+Ptr<Entry>
+S3Fifo::End ()
+{
+  return 0;
+}
+
+Ptr<Entry>
+S3Fifo::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  int32_t current = Find (from->GetName (), hash_value (from->GetName ()));
+  if (current < 0) return 0;
+
+  for (uint32_t slot = current + 1; slot < m_slots.size (); slot++)
+    {
+      if (m_slots[slot].m_entry != 0)
+        return m_slots[slot].m_entry;
+    }
+
+  return End ();
+}
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
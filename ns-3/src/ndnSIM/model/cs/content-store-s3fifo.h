@@ -0,0 +1,179 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_CONTENT_STORE_S3FIFO_H
+#define	NDN_CONTENT_STORE_S3FIFO_H
+
+#include "ns3/ndn-content-store.h"
+#include "ns3/traced-callback.h"
+
+#include <vector>
+#include <deque>
+#include <boost/unordered_map.hpp>
+
+namespace ns3 {
+namespace ndn {
+namespace cs {
+
+/**
+ * \ingroup ndn
+ * \brief Content store with a flat hash index and S3-FIFO cache replacement policy
+ *
+ * Entries are kept in a vector of slots, indexed by an open addressing hash table on the name hash
+ * (hash_value (Name), cached by the names).  New contents enter a small FIFO queue; contents requested
+ * again while in the small queue are moved to the main queue, the other ones are evicted and only their
+ * hashes are remembered in a ghost queue.  Contents in the ghost queue are inserted directly in the main
+ * queue, which evicts as a CLOCK (entries requested since the last pass get another round).  One-shot
+ * requests therefore only churn the small queue and do not evict popular contents.
+ *
+ * Capacity is limited by the number of entries (MaxSize) and/or by the bytes of the cached
+ * contents (MaxBytes: payload plus ContentObject header).
+ *
+ * Unlike the trie-based content stores, only Data whose name is equal to the Interest name is matched.
+ */
+class S3Fifo : public ContentStore
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static
+  TypeId GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  S3Fifo ();
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual
+  ~S3Fifo ();
+
+  virtual boost::tuple<Ptr<Packet>, Ptr<const ContentObject>, Ptr<const Packet> >
+  Lookup (Ptr<const Interest> interest);
+
+  virtual bool
+  Add (Ptr<const ContentObject> header, Ptr<const Packet> packet);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual Ptr<cs::Entry>
+  Begin ();
+
+  virtual Ptr<cs::Entry>
+  End ();
+
+  virtual Ptr<cs::Entry>
+  Next (Ptr<cs::Entry>);
+
+  /**
+   * @brief Get entries of the main queue, then of the small queue, each from the back to
+   * the front; state is the frequency of the entry, plus MAIN_QUEUE for the main queue
+   */
+  virtual void
+  Snapshot (std::vector< std::pair<Ptr<cs::Entry>, uint8_t> > &entries);
+
+  /**
+   * @brief Add content to the front of the queue given by the state, with the frequency
+   * given by the state (ghost queue is not restored)
+   */
+  virtual bool
+  Restore (Ptr<const ContentObject> header, Ptr<const Packet> packet, uint8_t state);
+
+  /**
+   * @brief Flag of the Snapshot () state of the contents in the main queue
+   */
+  static const uint8_t MAIN_QUEUE = 0x80;
+
+  /**
+   * @brief Get number of bytes of the cached contents (payload plus ContentObject header)
+   */
+  uint64_t
+  GetBytes () const;
+
+private:
+  struct Slot
+  {
+    Ptr<Entry> m_entry;    ///< @brief cached content, 0 if the slot is free
+    std::size_t m_hash;    ///< @brief hash of the name
+    uint32_t m_bytes;      ///< @brief bytes accounted for the content
+    uint8_t m_frequency;   ///< @brief number of hits since the content entered the queue (max 3)
+    bool m_main;           ///< @brief whether the content is in the main queue
+  };
+
+  int32_t
+  Find (const Name &name, std::size_t hash) const;
+
+  void
+  Insert (uint32_t slot);
+
+  void
+  Remove (uint32_t slot);
+
+  void
+  Resize (uint32_t buckets);
+
+  bool
+  IsFull (uint32_t bytes) const;
+
+  bool
+  IsSmallFull () const;
+
+  void
+  Evict ();
+
+  void
+  AddGhost (std::size_t hash);
+
+  bool
+  IsGhost (std::size_t hash) const;
+
+private:
+  uint32_t m_maxSize;           ///< @brief maximum number of entries, 0 if not limited
+  uint64_t m_maxBytes;          ///< @brief maximum number of bytes, 0 if not limited
+  double m_smallRatio;          ///< @brief share of the capacity for the small queue
+
+  std::vector<Slot> m_slots;          ///< @brief entries
+  std::vector<uint32_t> m_freeSlots;  ///< @brief indices of the free slots
+  std::vector<uint32_t> m_index;      ///< @brief open addressing hash table: slot index + 1, 0 if the bucket is empty
+
+  std::deque<uint32_t> m_small;       ///< @brief small FIFO queue (new contents are pushed at front)
+  std::deque<uint32_t> m_main;        ///< @brief main FIFO queue
+  uint64_t m_smallBytes;              ///< @brief bytes of the contents in the small queue
+  uint64_t m_bytes;                   ///< @brief bytes of all the contents
+
+  std::deque<std::size_t> m_ghost;                       ///< @brief hashes of the contents evicted from the small queue
+  boost::unordered_map<std::size_t, uint32_t> m_ghostCount; ///< @brief number of times every hash is in m_ghost
+
+  /// @brief trace of for entry additions (fired every time entry is successfully added to the cache): first parameter is pointer to the CS entry
+  TracedCallback< Ptr<const Entry> > m_didAddEntry;
+};
+
+} // namespace cs
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_CONTENT_STORE_S3FIFO_H
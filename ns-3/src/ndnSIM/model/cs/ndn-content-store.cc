@@ -56,6 +56,22 @@ ContentStore::~ContentStore ()
 {
 }
 
+void
+ContentStore::Snapshot (std::vector< std::pair<Ptr<cs::Entry>, uint8_t> > &entries)
+{
+  entries.clear ();
+  for (Ptr<cs::Entry> entry = Begin (); entry != End (); entry = Next (entry))
+    {
+      entries.push_back (std::make_pair (entry, 0));
+    }
+}
+
+bool
+ContentStore::Restore (Ptr<const ContentObject> header, Ptr<const Packet> packet, uint8_t state)
+{
+  return Add (header, packet);
+}
+
 namespace cs {
 
 //////////////////////////////////////////////////////////////////////
@@ -27,6 +27,8 @@
 #include "ns3/traced-callback.h"
 
 #include <boost/tuple/tuple.hpp>
+#include <vector>
+#include <utility>
 
 namespace ns3 {
 
@@ -201,6 +203,25 @@ public:
   virtual Ptr<cs::Entry>
   Next (Ptr<cs::Entry>) = 0;
 
+  /**
+   * @brief Get cached entries, together with their replacement state, in the order in which
+   * Restore () should add them to an empty content store of the same type to rebuild it
+   * (used by WarmStateHelper)
+   *
+   * Default implementation returns the entries in Begin ()/Next () order with state 0
+   */
+  virtual void
+  Snapshot (std::vector< std::pair<Ptr<cs::Entry>, uint8_t> > &entries);
+
+  /**
+   * @brief Add content of a Snapshot () with its replacement state
+   *
+   * Default implementation ignores the state and calls Add ()
+   * @returns true if content has been added
+   */
+  virtual bool
+  Restore (Ptr<const ContentObject> header, Ptr<const Packet> packet, uint8_t state);
+
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
   ////////////////////////////////////////////////////////////////////////////
@@ -88,6 +88,17 @@ Entry::UpdateFaceRtt (Ptr<Face> face, const Time &sample)
   m_faces.get<i_nth> ().rearrange (m_faces.get<i_metric> ().begin ());
 }
 
+void
+Entry::SetFaceRtt (Ptr<Face> face, const Time &sRtt, const Time &rttVar)
+{
+  FaceMetricByFace::type::iterator record = m_faces.get<i_face> ().find (face);
+  NS_ASSERT_MSG (record != m_faces.get<i_face> ().end (),
+                 "Update of RTT can be performed only on existing faces of CcxnFibEntry");
+
+  m_faces.modify (record,
+                  ll::bind (&FaceMetric::SetRtt, ll::_1, sRtt, rttVar));
+}
+
 void
 Entry::UpdateStatus (Ptr<Face> face, FaceMetric::Status status)
 {
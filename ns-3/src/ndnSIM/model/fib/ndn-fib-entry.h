@@ -119,6 +119,34 @@ public:
     m_status.Set (status);
   }
 
+  /**
+   * @brief Get smoothed round-trip time
+   */
+  const Time &
+  GetSRtt () const
+  {
+    return m_sRtt;
+  }
+
+  /**
+   * @brief Get round-trip time variation
+   */
+  const Time &
+  GetRttVar () const
+  {
+    return m_rttVar;
+  }
+
+  /**
+   * @brief Set smoothed round-trip time and its variation (e.g., when FIB is restored by WarmStateHelper)
+   */
+  void
+  SetRtt (const Time &sRtt, const Time &rttVar)
+  {
+    m_sRtt = sRtt;
+    m_rttVar = rttVar;
+  }
+
   /**
    * @brief Get current routing cost
    */
@@ -288,6 +316,12 @@ public:
   void
   UpdateFaceRtt (Ptr<Face> face, const Time &sample);
 
+  /**
+   * @brief Set smoothed RTT and RTT variation of the face
+   */
+  void
+  SetFaceRtt (Ptr<Face> face, const Time &sRtt, const Time &rttVar);
+
   /**
    * \brief Get prefix for the FIB entry
    */
@@ -30,6 +30,7 @@
 #include "ns3/log.h"
 
 #include <boost/ref.hpp>
+#include <boost/foreach.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/lambda/bind.hpp>
 namespace ll = boost::lambda;
@@ -147,6 +148,35 @@ FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric)
     return 0;
 }
 
+Ptr<Entry>
+FibImpl::Add (const Ptr<const Name> &prefix, Ptr<Entry> entry)
+{
+  NS_ASSERT (entry != 0);
+  NS_LOG_FUNCTION (this->GetObject<Node> ()->GetId () << boost::cref(*prefix) << boost::cref(entry->GetPrefix ()));
+
+  Ptr<EntryImpl> sharedEntry = StaticCast<EntryImpl> (entry);
+  std::pair< super::iterator, bool > result = super::insert (*prefix, sharedEntry);
+  if (result.first == super::end ())
+    return 0;
+
+  if (result.second)
+    {
+      sharedEntry->shared () ++;
+    }
+  else if (result.first->payload () != sharedEntry)
+    {
+      // prefix has its own entry, which keeps its next hops
+      Ptr<EntryImpl> existingEntry = result.first->payload ();
+      BOOST_FOREACH (const FaceMetric &faceMetric, sharedEntry->m_faces)
+        {
+          existingEntry->AddOrUpdateRoutingMetric (faceMetric.GetFace (), faceMetric.GetRoutingCost ());
+          existingEntry->SetRealDelayToProducer (faceMetric.GetFace (), faceMetric.GetRealDelay ());
+        }
+    }
+
+  return result.first->payload ();
+}
+
 void
 FibImpl::Remove (const Ptr<const Name> &prefix)
 {
@@ -155,15 +185,50 @@ FibImpl::Remove (const Ptr<const Name> &prefix)
   super::iterator fibEntry = super::find_exact (*prefix);
   if (fibEntry != super::end ())
     {
+      Ptr<EntryImpl> entry = fibEntry->payload ();
+      if (!entry->is_owner (fibEntry))
+        {
+          // prefix only shares the entry, which stays in FIB
+          entry->shared () --;
+          super::erase (fibEntry);
+          return;
+        }
+
       // notify forwarding strategy about soon be removed FIB entry
       NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
-      this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (fibEntry->payload ());
+      this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
 
-      super::erase (fibEntry);
+      EraseEntry (entry);
     }
   // else do nothing
 }
 
+void
+FibImpl::EraseEntry (Ptr<EntryImpl> entry)
+{
+  if (entry->shared () > 0)
+    {
+      // prefixes sharing the entry are not linked from it, so whole trie has to be checked
+      std::vector<super::iterator> sharing;
+      super::parent_trie::recursive_iterator item (super::getTrie ());
+      super::parent_trie::recursive_iterator end (0);
+      for (; item != end; item++)
+        {
+          if (item->payload () == entry && !entry->is_owner (&(*item)))
+            sharing.push_back (&(*item));
+        }
+
+      // nodes with payload are never pruned, so all collected nodes stay valid
+      BOOST_FOREACH (super::iterator sharingItem, sharing)
+        {
+          super::erase (sharingItem);
+        }
+      entry->shared () = 0;
+    }
+
+  super::erase (entry->to_iterator ());
+}
+
 // void
 // FibImpl::Invalidate (const Ptr<const Name> &prefix)
 // {
@@ -189,7 +254,7 @@ FibImpl::InvalidateAll ()
   super::parent_trie::recursive_iterator end (0);
   for (; item != end; item++)
     {
-      if (item->payload () == 0) continue;
+      if (item->payload () == 0 || !item->payload ()->is_owner (&(*item))) continue;
 
       super::modify (&(*item),
                      ll::bind (&Entry::Invalidate, ll::_1));
@@ -223,7 +288,7 @@ FibImpl::RemoveFromAll (Ptr<Face> face)
           NS_ASSERT (this->GetObject<ForwardingStrategy> () != 0);
           this->GetObject<ForwardingStrategy> ()->WillRemoveFibEntry (entry);
 
-          super::erase (StaticCast<EntryImpl> (entry)->to_iterator ());
+          EraseEntry (StaticCast<EntryImpl> (entry));
           entry = nextEntry;
         }
       else
@@ -237,11 +302,12 @@ void
 FibImpl::Print (std::ostream &os) const
 {
   // !!! unordered_set imposes "random" order of item in the same level !!!
+  // prefixes sharing an entry are printed once, as the prefix the entry has been created for
   super::parent_trie::const_recursive_iterator item (super::getTrie ());
   super::parent_trie::const_recursive_iterator end (0);
   for (; item != end; item++)
     {
-      if (item->payload () == 0) continue;
+      if (item->payload () == 0 || !item->payload ()->is_owner (&(*item))) continue;
 
       os << item->payload ()->GetPrefix () << "\t" << *item->payload () << "\n";
     }
@@ -260,7 +326,7 @@ FibImpl::Begin () const
   super::parent_trie::const_recursive_iterator end (0);
   for (; item != end; item++)
     {
-      if (item->payload () == 0) continue;
+      if (item->payload () == 0 || !item->payload ()->is_owner (&(*item))) continue;
       break;
     }
 
@@ -285,7 +351,7 @@ FibImpl::Next (Ptr<const Entry> from) const
   super::parent_trie::const_recursive_iterator end (0);
   for (item++; item != end; item++)
     {
-      if (item->payload () == 0) continue;
+      if (item->payload () == 0 || !item->payload ()->is_owner (&(*item))) continue;
       break;
     }
 
@@ -302,7 +368,7 @@ FibImpl::Begin ()
   super::parent_trie::recursive_iterator end (0);
   for (; item != end; item++)
     {
-      if (item->payload () == 0) continue;
+      if (item->payload () == 0 || !item->payload ()->is_owner (&(*item))) continue;
       break;
     }
 
@@ -327,7 +393,7 @@ FibImpl::Next (Ptr<Entry> from)
   super::parent_trie::recursive_iterator end (0);
   for (item++; item != end; item++)
     {
-      if (item->payload () == 0) continue;
+      if (item->payload () == 0 || !item->payload ()->is_owner (&(*item))) continue;
       break;
     }
 
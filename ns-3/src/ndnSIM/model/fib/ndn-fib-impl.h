@@ -43,6 +43,7 @@ public:
   EntryImpl (Ptr<Fib> fib, const Ptr<const Name> &prefix)
     : Entry (fib, prefix)
     , item_ (0)
+    , shared_ (0)
   {
   }
 
@@ -54,9 +55,20 @@ public:
 
   trie::iterator to_iterator () { return item_; }
   trie::const_iterator to_iterator () const { return item_; }
+
+  /**
+   * @brief Check if the entry has been created for the trie node (other nodes only share the entry)
+   */
+  bool is_owner (trie::const_iterator item) const { return item_ == item; }
+
+  /**
+   * @brief Number of other trie nodes sharing the entry
+   */
+  uint32_t &shared () { return shared_; }
   
 private:
   trie::iterator item_;
+  uint32_t shared_;
 };
 
 /**
@@ -100,6 +112,9 @@ public:
   virtual Ptr<Entry>
   Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric);
 
+  virtual Ptr<Entry>
+  Add (const Ptr<const Name> &prefix, Ptr<Entry> entry);
+
   virtual void
   Remove (const Ptr<const Name> &prefix);
 
@@ -145,6 +160,12 @@ private:
    */
   void
   RemoveFace (super::parent_trie &item, Ptr<Face> face);
+
+  /**
+   * @brief Remove the entry, together with all prefixes sharing it
+   */
+  void
+  EraseEntry (Ptr<EntryImpl> entry);
 };
 
 } // namespace fib
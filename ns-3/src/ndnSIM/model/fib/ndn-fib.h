@@ -107,12 +107,31 @@ public:
   virtual Ptr<fib::Entry>
   Add (const Ptr<const Name> &prefix, Ptr<Face> face, int32_t metric) = 0;
 
+  /**
+   * \brief Add FIB entry for the prefix, which shares the next hops of an existing entry
+   *
+   * Used when many prefixes have exactly the same routes (e.g., all contents served by the same
+   * producer): only one entry (faces, metrics, status, limits) is kept, and lookups for any
+   * of the prefixes return it.  Updates of the shared entry apply to all of its prefixes,
+   * and GetPrefix () of the shared entry returns the prefix it has been created for.
+   *
+   * Only the shared entry is reported by Begin ()/Next () and to the forwarding strategy.
+   * If the prefix already has its own entry, next hops of the shared entry are added to it instead.
+   *
+   * @param name	Smart pointer to prefix
+   * @param entry	Existing FIB entry (returned by Add () or Find ())
+   */
+  virtual Ptr<fib::Entry>
+  Add (const Ptr<const Name> &prefix, Ptr<fib::Entry> entry) = 0;
+
   /**
    * @brief Remove FIB entry
    *
    * ! ATTENTION ! Use with caution.  All PIT entries referencing the corresponding FIB entry will become invalid.
    * So, simulation may crash.
    *
+   * If other prefixes share the entry of the prefix (see Add (prefix, entry)), they are removed as well.
+   *
    * @param name	Smart pointer to prefix
    */
   virtual void
@@ -107,7 +107,8 @@ FloodingInform::DoPropagateInterestQtab (Ptr<Face> inFace,
 	  {
 		  if(qtabEntry->GetIsFirstExplorationFlag())      // FIRST EXPLORATION PHASE  (MinDelay Face + Random)
 		  {
-			  NS_LOG_UNCOND("FloodINFORM - NODE:\t" << inFace->GetNode()->GetId() << "\t forwarding Interest:\t" << header->GetName() << "\tin FIRST EXPLORATION PHASE...");
+			  NDN_INFORM_COUNT (explorationInterests);
+			  NS_LOG_DEBUG ("Node " << inFace->GetNode()->GetId() << " forwarding Interest " << header->GetName() << " in FIRST EXPLORATION PHASE");
 			  BOOST_FOREACH (const fib::FaceMetric &metricFace, pitEntry->GetFibEntry ()->m_faces.get<fib::i_metric> ())
 		      {
 				  if (metricFace.GetStatus () == fib::FaceMetric::NDN_FIB_RED) // all non-read faces are in the front of the list
@@ -120,7 +121,7 @@ FloodingInform::DoPropagateInterestQtab (Ptr<Face> inFace,
 				  propagatedCount++;
 
 				  minDelayFace = metricFace.GetFace()->GetId();
-				  NS_LOG_UNCOND("FloodINFORM - MinDelayFace:\t" << minDelayFace);
+				  NS_LOG_DEBUG ("MinDelayFace: " << minDelayFace);
 		      }
 
 			  // Select Random Face different from the MinDelayOne.   // With only two interfaces, the Interest is forwarder toward the interface different fro the incoming one.
@@ -141,7 +142,8 @@ FloodingInform::DoPropagateInterestQtab (Ptr<Face> inFace,
 
 			  if (randFace != minDelayFace)
 			  {
-				  NS_LOG_UNCOND("FloodINFORM - RandomFace:\t" << randFace);
+				  NDN_INFORM_COUNT (randomFaces);
+				  NS_LOG_DEBUG ("RandomFace: " << randFace);
 
 				  Ptr<Face> randFacePtr = inFace->GetNode()->GetObject<L3Protocol>()->GetFace(randFace);
 
@@ -155,11 +157,12 @@ FloodingInform::DoPropagateInterestQtab (Ptr<Face> inFace,
 		  }
 		  else				  // Successive EXPLORATION Phases  (MinQValue Face Precedente + Random)
 		  {
-			  NS_LOG_UNCOND("FloodINFORM - NODE:\t" << inFace->GetNode()->GetId() << "\t forwarding Interest:\t" << header->GetName() << "\tin EXPLORATION PHASE...");
+			  NDN_INFORM_COUNT (explorationInterests);
+			  NS_LOG_DEBUG ("Node " << inFace->GetNode()->GetId() << " forwarding Interest " << header->GetName() << " in EXPLORATION PHASE");
 
 			  minQFace = qtabEntry->GetqMin().interfId;
 
-			  NS_LOG_UNCOND("FloodINFORM - MinQvalueFace:\t" << minQFace);
+			  NS_LOG_DEBUG ("MinQvalueFace: " << minQFace);
 
 			  // Select a different random face.
 			  while(!different)
@@ -187,7 +190,8 @@ FloodingInform::DoPropagateInterestQtab (Ptr<Face> inFace,
 
 			  if (randFace != minQFace)
 			  {
-				  NS_LOG_UNCOND("FloodINFORM - RandomFace:\t" << randFace);
+				  NDN_INFORM_COUNT (randomFaces);
+				  NS_LOG_DEBUG ("RandomFace: " << randFace);
 
 				  Ptr<Face> randFacePtr = inFace->GetNode()->GetObject<ns3::ndn::L3Protocol>()->GetFace(randFace);
 
@@ -202,11 +206,12 @@ FloodingInform::DoPropagateInterestQtab (Ptr<Face> inFace,
 	  }
 	  else		// EXPLOITATION PHASE   (MinQValue Face)
 	  {
-		  NS_LOG_UNCOND("FloodINFORM - NODE:\t" << inFace->GetNode()->GetId() << "\t forwarding Interest:\t" << header->GetName() << "\tin EXPLOITATION PHASE...");
+		  NDN_INFORM_COUNT (exploitationInterests);
+		  NS_LOG_DEBUG ("Node " << inFace->GetNode()->GetId() << " forwarding Interest " << header->GetName() << " in EXPLOITATION PHASE");
 
 		  minQFace = qtabEntry->GetqMin().interfId;
 
-		  NS_LOG_UNCOND("FloodINFORM - MinQvalueFace:\t" << minQFace);
+		  NS_LOG_DEBUG ("MinQvalueFace: " << minQFace);
 
 		  Ptr<Face> minQFacePtr = inFace->GetNode()->GetObject<ns3::ndn::L3Protocol>()->GetFace(minQFace);
 		  if (SendOutInterestInform (inFace, minQFacePtr, header, origPacket, pitEntry))
@@ -182,6 +182,14 @@ ForwardingStrategy::GetNodeType() const
 	return nodeType;
 }
 
+#ifdef NDNSIM_INFORM_COUNTERS
+const InformCounters &
+ForwardingStrategy::GetInformCounters () const
+{
+  return m_informCounters;
+}
+#endif
+
 
 void
 ForwardingStrategy::OnInterest (Ptr<Face> inFace,
@@ -199,32 +207,8 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
 
   //Rimettere NS_LOG_UNCOND("FS/OnInterest - NODE:\t" << inFace->GetNode()->GetId() << "\t RX INTEREST:\t" << header->GetName() << "\ton interface:\t" << inFace->GetId() <<  "\tTime:\t" << Simulator::Now().GetMicroSeconds() << "\n");
 
-  // *** The chunk part of the Interest must be removed for the lookup inside the QTAB
-  std::stringstream ss;
-  ss << header->GetName();
-  std::string interest_ric = ss.str();
-  ss.str("");
-
-  Ptr<NameComponents> receivedInterest = Create<NameComponents> (interest_ric);
-  uint32_t numComponents = receivedInterest->GetComponents().size();
-  std::list<std::string> nome_int_ric (numComponents);
-  nome_int_ric.assign(receivedInterest->begin(), receivedInterest->end());
-  std::list<std::string>::iterator it = nome_int_ric.begin();
-  nome_int_ric.pop_back();
-  --numComponents;
-
-  for(uint32_t t = 0; t < numComponents; t++)
-  {
-  ss << "/" << *it;
-  it++;
-  }
-  std::string interestNoChunk = ss.str();
-  ss.str("");
-
-  nome_int_ric.clear();
-
-  Ptr<Interest> header_new = Create<Interest>();
-  header_new->SetName(Create<NameComponents> (interestNoChunk));
+  // *** The Qtab and the Repo are looked up with the content-level name of the Interest (i.e., without the chunk part),
+  //     which is computed once, when the Interest is deserialized (Interest::GetContentName)
 
   uint32_t numInterfaces = inFace->GetNode()->GetNDevices();   // Number of Interfaces of the considered node
 
@@ -236,7 +220,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
   // NS_LOG_UNCOND("FINE PIT LOOKUP");
 
   //  Check if a QTAB Entry is already present.
-  Ptr<qtab::Entry> qtabEntry = m_qtab->LookupQtab(*header_new);
+  Ptr<qtab::Entry> qtabEntry = m_qtab->LookupQtab(*header);
 
   // NS_LOG_UNCOND("FINE QTAB LOOKUP");
 
@@ -246,7 +230,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
   {
     similarInterest = false;
 
-    pitEntry = m_pit->Create (header, header_new);
+    pitEntry = m_pit->Create (header);
 
   // NS_LOG_UNCOND("FINE CREAZIONE PIT");
 
@@ -257,9 +241,9 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     	//NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " Created PIT Entry");
     	if (qtabEntry == 0)
     	{
-    		//Rimettere NS_LOG_UNCOND ("NODE:\t" << inFace->GetNode()->GetId() << "FS-OnInterest - QTAB ENTRY:\t" << header_new->GetName() << "\t NON PRESENTE!\tCreazione...\n" );
+    		//Rimettere NS_LOG_UNCOND ("NODE:\t" << inFace->GetNode()->GetId() << "FS-OnInterest - QTAB ENTRY:\t" << header->GetContentName() << "\t NON PRESENTE!\tCreazione...\n" );
     		Ptr<fib::Entry> fibEntry = pitEntry->GetFibEntry();
-    		qtabEntry = m_qtab->CreateQtab(header_new, fibEntry, numInterfaces);
+    		qtabEntry = m_qtab->CreateQtab(header, fibEntry, numInterfaces);
 
 		//NS_LOG_UNCOND("FINE CREAZIONE QTAB ENTRY");
     	}
@@ -270,7 +254,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     }
     else
     {
-		// NS_LOG_UNCOND ("NODE:\t" << inFace->GetNode()->GetId() << "FAILED TO CREATE PIT ENTRY\t" << header_new->GetName());
+		// NS_LOG_UNCOND ("NODE:\t" << inFace->GetNode()->GetId() << "FAILED TO CREATE PIT ENTRY\t" << header->GetContentName());
 
       FailedToCreatePitEntry (inFace, header, origPacket);
       return;
@@ -310,26 +294,26 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
         repo = true;
         //NS_LOG_UNCOND("REPOSITORY:\t" << inFace->GetNode()->GetId() << "\tRicevuto Interest" << "\t" << header->GetName() <<  "\t" << Simulator::Now().GetNanoSeconds());
 
-       //NS_LOG_UNCOND("REPOSITORY:\t" << incomingFace->GetNode()->GetId() << "\tInterest senza chunk:\t" << interestNoChunk <<  "\t" << Simulator::Now().GetNanoSeconds());
+       //NS_LOG_UNCOND("REPOSITORY:\t" << incomingFace->GetNode()->GetId() << "\tInterest senza chunk:\t" << header->GetContentName() <<  "\t" << Simulator::Now().GetNanoSeconds());
 
-        //  **** Lookup nel repository
-        boost::tie (contentObject, contentObjectHeader, payload) = m_repository->Lookup (header_new);
+        //  **** Lookup nel repository (done on the content-level name of the Interest)
+        boost::tie (contentObject, contentObjectHeader, payload) = m_repository->Lookup (header);
 
         if(contentObject != 0)   // The REPO has the content
         {
-              // NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " CONTENT IN REPO: " << interestNoChunk);
+              // NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " CONTENT IN REPO: " << header->GetContentName());
 
               header_repo = Create<ContentObject> ();
               contentObject->RemoveHeader (*header_repo);
-              header_repo->SetName(Create<NameComponents>(interest_ric));
+              header_repo->SetName(header->GetName());
               contentObject->AddHeader(*header_repo);
         }
-        else
-            // NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " CONTENT NOT IN REPO: " << interestNoChunk);
+        // else
+            // NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " CONTENT NOT IN REPO: " << header->GetContentName());
   }
   else    // It is NOT a REPO, so the lookup is done on the entire name.
   {
-      //Rimettere NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " CHECK CONTENT IN CACHE: " << interestNoChunk);
+      //Rimettere NS_LOG_UNCOND("NODE:\t" << inFace->GetNode()->GetId() << " CHECK CONTENT IN CACHE: " << header->GetContentName());
 
         boost::tie (contentObject, contentObjectHeader, payload) = m_contentStore->Lookup (header);
   }
@@ -337,7 +321,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
 
 /*  if(rp_size!=0)
   {
-      //NS_LOG_UNCOND("REPO:\t" << inFace->GetNode()->GetId() << "\tInterest without chunk part:\t" << interestNoChunk <<  "\t" << Simulator::Now().GetNanoSeconds());
+      //NS_LOG_UNCOND("REPO:\t" << inFace->GetNode()->GetId() << "\tInterest without chunk part:\t" << header->GetContentName() <<  "\t" << Simulator::Now().GetNanoSeconds());
 
       //  ** Lookup inside the Repo
       boost::tie (contentObject, contentObjectHeader, payload) = m_repository->Lookup (header);
@@ -356,14 +340,9 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
       //NS_LOG_UNCOND ("NODONODO:\t" << incomingFace->GetNode()->GetId() << "\t CO TROVATO IN CACHE O REPO:\t" << contentObjectHeader->GetName());
 
       // Old method for hot count tracing. The value is initialized to '0'
-      Ptr<ContentObject> header_cont = Create<ContentObject> ();
-      contentObject->RemoveHeader (*header_cont);
-
       // *** Setting both the HopCount and the Qvalue (if the content is in cache, is the Qvalue equal to zero?)
-      header_cont->GetAdditionalInfo().SetHopCount(0);
-      header_cont->GetAdditionalInfo().SetQvalue(MicroSeconds(0));
-
-      contentObject->AddHeader(*header_cont);
+      ContentObject::PatchHopCount (contentObject, 0);
+      ContentObject::PatchQvalue (contentObject, MicroSeconds (0));
 
       pitEntry->AddIncoming (inFace);
 
@@ -381,17 +360,18 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     		  if (qtabEntry->GetExplorationChunks() == 0)
     			  qtabEntry->IncrementExplorationChunks();
     		  else
-    			  NS_LOG_UNCOND("qTabEntry present, but no received DATA to update the estimates!!");
+    			  NS_LOG_DEBUG ("qtabEntry present, but no received DATA to update the estimates");
     	  }
 
         //Rimettere NS_LOG_UNCOND ("FS-OnInterest - Requested content present!\n"
-        	//	<< "Algorithm for the entry:\t" << header_new->GetName()
+        	//	<< "Algorithm for the entry:\t" << header->GetContentName()
         	//	<< "\tis in Exploration phase, with a number of sent chunks equal to:\t" << qtabEntry->GetExplorationChunks() << "\n"
         	//	<< "Piggyback of the local QVALUE equal to:" << header_cont->GetAdditionalInfo().GetQvalue() << "\n");
 
       	if(qtabEntry->GetExplorationChunks() > inFace->GetNode()->GetObject<Qtab>()->GetMaxChunksExploration())
       	{
       		qtabEntry->SetExplorationFlag(false);    // Switch to Exploitation phase.
+      		NDN_INFORM_COUNT (exploitationEntries);
       		qtabEntry->SetIsFirstExplorationFlag(false);
 
       		qtabEntry->SetExploitationChunks(0);
@@ -411,7 +391,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
       	qtabEntry->IncrementExploitationChunks();
 
         //Rimettere NS_LOG_UNCOND ("FS-OnInterest - Requested content present!\n"
-        	//	<< "Algorithm for the entry:\t" << header_new->GetName()
+        	//	<< "Algorithm for the entry:\t" << header->GetContentName()
         	//	<< "\tis in fase Exploitation, with a number of chunks equal to:\t" << qtabEntry->GetExploitationChunks() << "\n"
         	//	<< "Piggyback of the local QVALUE equal to:" << header_cont->GetAdditionalInfo().GetQvalue() << "\n");
 
@@ -419,6 +399,7 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
       	if(qtabEntry->GetExploitationChunks() > inFace->GetNode()->GetObject<Qtab>()->GetMaxChunksExploitation())
       	{
       		qtabEntry->SetExplorationFlag(true);    // Ritorno alla fase Exploration.
+      		NDN_INFORM_COUNT (explorationEntries);
       		qtabEntry->SetIsFirstExplorationFlag(false);
 
       		qtabEntry->SetExplorationChunks(0);
@@ -497,17 +478,18 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     		  if (qtabEntry->GetExplorationChunks() == 0)
     			  qtabEntry->IncrementExplorationChunks();
     		  else
-    			  NS_LOG_UNCOND("qTabEntry present, but no received DATA to update the estimates!!");
+    			  NS_LOG_DEBUG ("qtabEntry present, but no received DATA to update the estimates");
     	  }
 
          //Rimettere  NS_LOG_UNCOND ("FS-OnInterest - Interest Aggregated for:\t" << header->GetName() << "\n"
-          	//	<< "Algorithm for the entry:\t" << header_new->GetName()
+          	//	<< "Algorithm for the entry:\t" << header->GetContentName()
           	//	<< "\tis in Exploration phase, with a number of sent chunks equal to:\t" << qtabEntry->GetExplorationChunks() << "\n");
 
 
     	if(qtabEntry->GetExplorationChunks() > inFace->GetNode()->GetObject<Qtab>()->GetMaxChunksExploration())
     	{
     		qtabEntry->SetExplorationFlag(false);    // Switch to Exploitation.
+    		NDN_INFORM_COUNT (exploitationEntries);
     		qtabEntry->SetIsFirstExplorationFlag(false);
 
     		qtabEntry->SetExploitationChunks(0);
@@ -527,12 +509,13 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     	qtabEntry->IncrementExploitationChunks();
 
         //Rimettere NS_LOG_UNCOND ("FS/OnInterest - Interest aggregated for:\t" << header->GetName() << "\n"
-        	//	<< "Algorithm for the entry:\t" << header_new->GetName()
+        	//	<< "Algorithm for the entry:\t" << header->GetContentName()
         	//	<< "\tis in Exploitation Phase, with a number of chunks equal to:\t" << qtabEntry->GetExplorationChunks() << "\n");
 
     	if(qtabEntry->GetExploitationChunks() > inFace->GetNode()->GetObject<Qtab>()->GetMaxChunksExploitation())
     	{
     		qtabEntry->SetExplorationFlag(true);    // Swith back to Exploration.
+    		NDN_INFORM_COUNT (explorationEntries);
     		qtabEntry->SetIsFirstExplorationFlag(false);
 
     		qtabEntry->SetExplorationChunks(0);
@@ -575,16 +558,17 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
     		  if (qtabEntry->GetExplorationChunks() == 0)
     			  qtabEntry->IncrementExplorationChunks();
     		  else
-    			  NS_LOG_UNCOND("qtabEntry present, but no received DATA to update the estimates!!");
+    			  NS_LOG_DEBUG ("qtabEntry present, but no received DATA to update the estimates");
     	  }
 
         //Rimettere NS_LOG_UNCOND ("FS-OnInterest - Interest forwarded for:\t" << header->GetName() << "\n"
-    		// << "Algorithm for the entry:\t" << header_new->GetName()
+    		// << "Algorithm for the entry:\t" << header->GetContentName()
     		// << "\tis in Exploration phase, with a number of chunks equal to:\t" << qtabEntry->GetExplorationChunks() << "\n");
 
   	if(qtabEntry->GetExplorationChunks() > inFace->GetNode()->GetObject<Qtab>()->GetMaxChunksExploration())
   	{
   		qtabEntry->SetExplorationFlag(false);    // Switch to Exploitation.
+  		NDN_INFORM_COUNT (exploitationEntries);
   		qtabEntry->SetIsFirstExplorationFlag(false);
 
   		qtabEntry->SetExploitationChunks(0);
@@ -603,13 +587,14 @@ ForwardingStrategy::OnInterest (Ptr<Face> inFace,
   {
   	qtabEntry->IncrementExploitationChunks();
 
-    NS_LOG_UNCOND ("FS-OnInterest - Interest forwarded for:\t" << header->GetName() << "\n"
-    		<< "Algorithm for the entry:\t" << header_new->GetName()
-    		<< "\tis in Exploitation phase, with a number of chunks equal to:\t" << qtabEntry->GetExplorationChunks() << "\n");
+    NS_LOG_DEBUG ("Interest forwarded for " << header->GetName()
+    		<< ", entry " << header->GetContentName()
+    		<< " is in Exploitation phase, with a number of chunks equal to " << qtabEntry->GetExploitationChunks());
 
   	if(qtabEntry->GetExploitationChunks() > inFace->GetNode()->GetObject<Qtab>()->GetMaxChunksExploitation())
   	{
   		qtabEntry->SetExplorationFlag(true);    // Switch back to Exploration.
+  		NDN_INFORM_COUNT (explorationEntries);
   		qtabEntry->SetIsFirstExplorationFlag(false);
 
   		qtabEntry->SetExplorationChunks(0);
@@ -667,94 +652,66 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
 	  * 			2) Calculate the best qValue assoiated to the entry and insert that inside the forwarded Data.
 	  */
 
-	  // *******  Cut the chunk part of the retrieved Data  *****
-
-	  std::stringstream ss;
-	  ss << header->GetName();
-	  std::string dataRic = ss.str();
-	  ss.str("");
-
-	  Ptr<Name> receivedData = Create<Name> (dataRic);
-	  uint32_t numComponents = receivedData->GetComponents().size();
-
-	  std::list<std::string> nameDataRec (numComponents);
-	  nameDataRec.assign(receivedData->begin(), receivedData->end());
-	  std::list<std::string>::iterator it = nameDataRec.begin();
-	  nameDataRec.pop_back();
-	  --numComponents;
+	  // *******  The Qtab is looked up with the content-level name of the Data (i.e., without the chunk part)  *****
 
-	  for(uint32_t t = 0; t < numComponents; t++)    // Reconstruct the name without the chunk part
-	  {
-		    ss << "/" << *it;
-		    it++;
-	  }
-	  std::string dataNoChunk = ss.str();
-	  ss.str("");
-
-	  nameDataRec.clear();
+	  // The forwarded Data differs from the received one only in the piggybacked qValue, which is updated in place
+	  Ptr<Packet> packetCopy = origPacket->Copy ();
 
-
-	  Ptr<Packet> packetCopy = Create<Packet> ();
-	  Ptr<ContentObject> headerNew = Create<ContentObject>();
-	  packetCopy = origPacket->Copy();
-	  packetCopy->RemoveHeader(*headerNew);
-
-	  headerNew->SetName(Create<Name> (dataNoChunk));
-	  Ptr<qtab::Entry> qtabEntry = m_qtab->LookupQtab(*headerNew);
+	  Ptr<qtab::Entry> qtabEntry = m_qtab->LookupQtab(*header);
 
 	  if(qtabEntry == 0)
 	  {
-		  NS_LOG_UNCOND("FS-OnData - ** ERROR ** QtabEntry:\t" << headerNew->GetName() << "\tnot present when receiving the DATA!");
+		  // The Data is forwarded with the piggybacked qValue
+		  NDN_INFORM_COUNT (qtabMisses);
+		  NS_LOG_DEBUG ("QtabEntry " << header->GetContentName() << " not present when receiving the DATA");
 	  }
+	  else
+	  {
+		  // Exctract the piggybacked qValue and update the correspondent one inside the local Tab.
+		  Time piggyQvalue = header->GetAdditionalInfo().GetQvalue();
+		  //Rimettere NS_LOG_UNCOND("FS-OnData - Piggybacked Qvalue:\t" << piggyQvalue.GetMicroSeconds() << " us\n");
+		  //Rimettere NS_LOG_UNCOND("FS-OnData - Qvalue befor the update:\t" << qtabEntry->GetqValuesInterf().operator [](inFace->GetId()).GetMicroSeconds() << " us\n");
 
-	  // Exctract the piggybacked qValue and update the correspondent one inside the local Tab.
-	  Time piggyQvalue = headerNew->GetAdditionalInfo().GetQvalue();
-	  //Rimettere NS_LOG_UNCOND("FS-OnData - Piggybacked Qvalue:\t" << piggyQvalue.GetMicroSeconds() << " us\n");
-	  //Rimettere NS_LOG_UNCOND("FS-OnData - Qvalue befor the update:\t" << qtabEntry->GetqValuesInterf().operator [](inFace->GetId()).GetMicroSeconds() << " us\n");
-
-	  qtabEntry->UpdateQvalue(inFace->GetId(), piggyQvalue);
+		  qtabEntry->UpdateQvalue(inFace->GetId(), piggyQvalue);
 
-	  //Rimettere NS_LOG_UNCOND("FS/OnData - Qvalue after the update:\t" << qtabEntry->GetqValuesInterf().operator [](inFace->GetId()).GetMicroSeconds() << " us\n");
+		  //Rimettere NS_LOG_UNCOND("FS/OnData - Qvalue after the update:\t" << qtabEntry->GetqValuesInterf().operator [](inFace->GetId()).GetMicroSeconds() << " us\n");
 
-	  Time tempMinQvalue;
+		  Time tempMinQvalue;
 
-	  bool explorePhase = qtabEntry->GetExplorationFlag();
+		  bool explorePhase = qtabEntry->GetExplorationFlag();
 
-	  if(!explorePhase) // Sono nella Exploitation Phase
-	  {
-		  // Check con il valore assoluto per vedere se permanere nella exploitation phase
-		  bool continueExploit = qtabEntry->CheckContinueExploit(incInterfId);
-
-		  if(continueExploit)
+		  if(!explorePhase) // Sono nella Exploitation Phase
 		  {
-			  //Rimettere NS_LOG_UNCOND("FS-OnData - EXPLOITATION PHASE - The variation of the MinQvalue is UNDER the DELTA...Go ahead with Exploitation...\n");
-			  tempMinQvalue = qtabEntry->minQValue->qValueMin;
-			  headerNew->GetAdditionalInfo().SetQvalue(tempMinQvalue);
+			  // Check con il valore assoluto per vedere se permanere nella exploitation phase
+			  bool continueExploit = qtabEntry->CheckContinueExploit(incInterfId);
+
+			  if(continueExploit)
+			  {
+				  //Rimettere NS_LOG_UNCOND("FS-OnData - EXPLOITATION PHASE - The variation of the MinQvalue is UNDER the DELTA...Go ahead with Exploitation...\n");
+				  tempMinQvalue = qtabEntry->GetqMin ().qValueMin;
+			  }
+			  else
+			  {
+				  //Rimettere NS_LOG_UNCOND("FS-OnData - EXPLOITATION PHASE - The variation of the MinQvalue is OVER the DELTA...Switch back to Exploration...\n");
+				  qtabEntry->SetExplorationFlag(true);
+				  NDN_INFORM_COUNT (explorationEntries);
+				  NDN_INFORM_COUNT (deltaSwitchBacks);
+				  qtabEntry->SetIsFirstExplorationFlag(false);
+
+				  qtabEntry->SetExplorationChunks(0);
+				  qtabEntry->SetExploitationChunks(0);
+
+				  tempMinQvalue = qtabEntry->GetqMin ().qValueMin;
+			  }
 		  }
 		  else
 		  {
-			  //Rimettere NS_LOG_UNCOND("FS-OnData - EXPLOITATION PHASE - The variation of the MinQvalue is OVER the DELTA...Switch back to Exploration...\n");
-			  qtabEntry->SetExplorationFlag(true);
-			  qtabEntry->SetIsFirstExplorationFlag(false);
-
-			  qtabEntry->SetExplorationChunks(0);
-			  qtabEntry->SetExploitationChunks(0);
-
-			  tempMinQvalue = qtabEntry->minQValue->qValueMin;
-			  headerNew->GetAdditionalInfo().SetQvalue(tempMinQvalue);
+			  tempMinQvalue = qtabEntry->ExtractTempMinQvalue();
+			  //Rimettere NS_LOG_UNCOND("FS-OnData - EXPLORATION PHASE - Calculate the qMinValue that should be piggybacked...\tThe result is:\t" << tempMinQvalue.GetMicroSeconds() << " us");
 		  }
-	  }
-	  else
-	  {
-		  tempMinQvalue = qtabEntry->ExtractTempMinQvalue();
-		  //Rimettere NS_LOG_UNCOND("FS-OnData - EXPLORATION PHASE - Calculate the qMinValue that should be piggybacked...\tThe result is:\t" << tempMinQvalue.GetMicroSeconds() << " us");
-		  headerNew->GetAdditionalInfo().SetQvalue(tempMinQvalue);
-	  }
-
-	  // Reinsert the full name
-	  headerNew->SetName(Create<Name> (dataRic));
 
-	  packetCopy->AddHeader(*headerNew);
+		  ContentObject::PatchQvalue (packetCopy, tempMinQvalue);
+	  }
 
 	  //////////////////////////////////////////////////////////////////////
 
@@ -766,7 +723,7 @@ ForwardingStrategy::OnData (Ptr<Face> inFace,
 	     //WillSatisfyPendingInterest (inFace, pitEntry);
 
 	     // Actually satisfy pending interest
-	     SatisfyPendingInterest (inFace, header, payload, origPacket, pitEntry);
+	     SatisfyPendingInterest (inFace, header, payload, packetCopy, pitEntry);
 
 	     // Lookup another PIT entry
 	     pitEntry = m_pit->Lookup (*header);    // ** [MT] ** In this implementation, the lookup in the PIT when receiving a Data is an exact match;
@@ -1315,16 +1272,6 @@ ForwardingStrategy::WillRemoveFibEntry (Ptr<fib::Entry> fibEntry)
   // do nothing here
 }
 
-std::ifstream& ForwardingStrategy::GotoLine(std::ifstream& file, uint32_t num)
-{
-   file.seekg(std::ios::beg);
-   for(uint32_t i=0; i < num - 1; ++i)
-   {
-       file.ignore(std::numeric_limits<std::streamsize>::max(),'\n');
-   }
-   return file;
-}
-
 
 } // namespace ndn
 } // namespace ns3
@@ -27,6 +27,7 @@
 #include "ns3/traced-callback.h"
 #include "/media/DATI/tortelli/INFORM/ns-3/src/ndnSIM/model/repo/ndn-repo.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/ndnSIM/utils/ndn-inform-counters.h"
 #include <map>
 
 
@@ -142,6 +143,14 @@ public:
   std::string
   GetNodeType() const;
 
+#ifdef NDNSIM_INFORM_COUNTERS
+  /**
+   * @brief Get counters of the INFORM decisions taken by the strategy
+   */
+  const InformCounters &
+  GetInformCounters () const;
+#endif
+
 
 protected:
   /**
@@ -522,11 +531,6 @@ protected:
 
 
 
-  /**
-   * \brief It lets the positioning at the specified line inside the considered file.
-   */
-  std::ifstream& GotoLine(std::ifstream& file, uint32_t num);
-
 protected:
   // inherited from Object class
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
@@ -613,6 +617,9 @@ protected:
 
   std::string nodeType;
 
+#ifdef NDNSIM_INFORM_COUNTERS
+  InformCounters m_informCounters; ///< @brief see NDN_INFORM_COUNT
+#endif
 };
 
 } // namespace ndn
@@ -22,6 +22,7 @@
 #include "ndn-content-object.h"
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 
 #include <boost/foreach.hpp>
 
@@ -33,6 +34,63 @@ namespace ndn {
 NS_OBJECT_ENSURE_REGISTERED (ContentObject);
 NS_OBJECT_ENSURE_REGISTERED (ContentObjectTail);
 
+/**
+ * @brief Fixed-size beginning of ndnSIM-encoded ContentObject (Version, PacketType and AdditionalInfo)
+ *
+ * Used to read and update AdditionalInfo fields without (de)serializing the whole ContentObject
+ */
+class ContentObjectFixedPart : public Header
+{
+public:
+  static TypeId
+  GetTypeId (void)
+  {
+    static TypeId tid = TypeId ("ns3::ndn::ContentObjectFixedPart")
+      .SetGroupName ("Ndn")
+      .SetParent<Header> ()
+      ;
+    return tid;
+  }
+
+  virtual TypeId
+  GetInstanceTypeId (void) const { return GetTypeId (); }
+
+  virtual void
+  Print (std::ostream &os) const { os << "<HopCount>" << m_hopCount << "</HopCount><Qvalue>" << m_qValue << "</Qvalue>"; }
+
+  virtual uint32_t
+  GetSerializedSize (void) const { return 2 + 4 + 4; }
+
+  virtual void
+  Serialize (Buffer::Iterator start) const
+  {
+    start.WriteU8 (0x80); // version
+    start.WriteU8 (0x01); // packet type
+    start.WriteU32 (m_hopCount);
+    start.WriteU32 (m_qValue);
+  }
+
+  virtual uint32_t
+  Deserialize (Buffer::Iterator start)
+  {
+    Buffer::Iterator i = start;
+    if (i.ReadU8 () != 0x80)
+      throw new ContentObjectException ();
+
+    if (i.ReadU8 () != 0x01)
+      throw new ContentObjectException ();
+
+    m_hopCount = i.ReadU32 ();
+    m_qValue = i.ReadU32 ();
+    return i.GetDistanceFrom (start);
+  }
+
+  uint32_t m_hopCount;
+  uint32_t m_qValue; ///< @brief Q-value in nanoseconds
+};
+
+NS_OBJECT_ENSURE_REGISTERED (ContentObjectFixedPart);
+
 TypeId
 ContentObject::GetTypeId (void)
 {
@@ -45,7 +103,8 @@ ContentObject::GetTypeId (void)
 }
 
 ContentObject::ContentObject ()
-  : m_signature (0)
+  : m_contentKey (0)
+  , m_signature (0)
 {
 }
 
@@ -53,12 +112,14 @@ void
 ContentObject::SetName (Ptr<Name> name)
 {
   m_name = name;
+  UpdateContentName ();
 }
 
 void
 ContentObject::SetName (const Name &name)
 {
   m_name = Create<Name> (name);
+  UpdateContentName ();
 }
 
 const Name&
@@ -74,6 +135,33 @@ ContentObject::GetNamePtr () const
   return m_name;
 }
 
+const Name&
+ContentObject::GetContentName () const
+{
+  if (m_contentName==0) throw ContentObjectException();
+  return *m_contentName;
+}
+
+std::size_t
+ContentObject::GetContentKey () const
+{
+  return m_contentKey;
+}
+
+void
+ContentObject::UpdateContentName ()
+{
+  if (m_name == 0)
+    {
+      m_contentName = 0;
+      m_contentKey = 0;
+      return;
+    }
+
+  m_contentName = (m_name->size () > 0) ? Create<Name> (m_name->cut (1)) : m_name;
+  m_contentKey = hash_value (*m_contentName);
+}
+
 
 void
 ContentObject::SetTimestamp (const Time &timestamp)
@@ -128,6 +216,10 @@ ContentObject::Serialize (Buffer::Iterator start) const
   start.WriteU8 (0x80); // version
   start.WriteU8 (0x01); // packet type
 
+  // ** [MT] ** Additional Info, at fixed offset (see PatchHopCount, PatchQvalue)
+  start.WriteU32 (GetAdditionalInfo ().GetHopCount ());
+  start.WriteU32 (static_cast<uint32_t> (GetAdditionalInfo ().GetQvalue ().ToInteger (Time::NS)));
+
   if (m_signature != 0)
     {
       start.WriteU16 (6); // signature length
@@ -140,18 +232,6 @@ ContentObject::Serialize (Buffer::Iterator start) const
       start.WriteU16 (0); // empty signature
     }
 
-  // Additional Info
-  if (GetAdditionalInfo ().GetHopCount () != 100000)
-  {
-	  start.WriteU32 (GetAdditionalInfo ().GetHopCount());
-  }
-
-  // Additional Info - qValue
-  if (!GetAdditionalInfo ().GetQvalue ().IsStrictlyNegative())
-  {
-	  start.WriteU32 (static_cast<uint32_t> (GetAdditionalInfo ().GetQvalue().ToInteger(Time::NS)));
-  }
-
   // name
   uint32_t offset = m_name->Serialize (start);
   NS_LOG_DEBUG ("Offset: " << offset);
@@ -181,6 +261,10 @@ ContentObject::Deserialize (Buffer::Iterator start)
   if (i.ReadU8 () != 0x01)
     throw new ContentObjectException ();
 
+  // ** [MT] ** Additional Info
+  GetAdditionalInfo ().SetHopCount (i.ReadU32 ());
+  GetAdditionalInfo ().SetQvalue (NanoSeconds (i.ReadU32 ()));
+
   uint32_t signatureLength = i.ReadU16 ();
   if (signatureLength == 6)
     {
@@ -197,14 +281,10 @@ ContentObject::Deserialize (Buffer::Iterator start)
   else
     throw new ContentObjectException ();
 
-  // ** [MT] ** Additional Info
-  GetAdditionalInfo ().SetHopCount(i.ReadU32 ());
-
-  GetAdditionalInfo ().SetQvalue(NanoSeconds(i.ReadU32 ()));
-
   m_name = Create<Name> ();
   uint32_t offset = m_name->Deserialize (i);
   i.Next (offset);
+  UpdateContentName ();
 
   if (i.ReadU16 () != (2 + 4 + 2 + 2 + (2 + 0))) // content length
     throw new ContentObjectException ();
@@ -239,6 +319,40 @@ ContentObject::Print (std::ostream &os) const
   // os << "<ContentObject><Name>" << GetName () << "</Name><Content>";
 }
 
+uint32_t
+ContentObject::PeekHopCount (Ptr<const Packet> packet)
+{
+  ContentObjectFixedPart fixedPart;
+  packet->PeekHeader (fixedPart);
+  return fixedPart.m_hopCount;
+}
+
+void
+ContentObject::PatchHopCount (Ptr<Packet> packet, uint32_t hopCount)
+{
+  ContentObjectFixedPart fixedPart;
+  packet->RemoveHeader (fixedPart);
+  fixedPart.m_hopCount = hopCount;
+  packet->AddHeader (fixedPart);
+}
+
+Time
+ContentObject::PeekQvalue (Ptr<const Packet> packet)
+{
+  ContentObjectFixedPart fixedPart;
+  packet->PeekHeader (fixedPart);
+  return NanoSeconds (fixedPart.m_qValue);
+}
+
+void
+ContentObject::PatchQvalue (Ptr<Packet> packet, const Time &qValue)
+{
+  ContentObjectFixedPart fixedPart;
+  packet->RemoveHeader (fixedPart);
+  fixedPart.m_qValue = static_cast<uint32_t> (qValue.ToInteger (Time::NS));
+  packet->AddHeader (fixedPart);
+}
+
 ContentObject::AdditionalInfo::AdditionalInfo ()
   : m_hopCount(50000)
 {
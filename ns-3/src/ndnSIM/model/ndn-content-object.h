@@ -35,6 +35,8 @@
 #include "ndn-name.h"
 
 namespace ns3 {
+
+class Packet;
 namespace ndn {
 
 /**
@@ -46,13 +48,21 @@ namespace ndn {
  *
  * Optimized and simplified formatting of Interest packets
  *
- *	ContentObject ::= Signature
+ *	ContentObject ::= AdditionalInfo
+ *                    Signature
  *                	  Name
  *                    Content
  *
+ * AdditionalInfo (hop count and piggybacked Q-value in nanoseconds) immediately follows
+ * Version and PacketType, so it can be updated in place (see PatchHopCount, PatchQvalue)
+ *
  *      0                   1                   2                   3
  *      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
  *      +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *      |                           Hop count                           |
+ *      +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *      |                            Q-value                            |
+ *      +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
  *      |            Length             |                               |
  *      |-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+                               +
  *      ~                                                               ~
@@ -168,6 +178,20 @@ public:
   Ptr<const Name>
   GetNamePtr () const;
 
+  /**
+   * @brief Get content-level name of the content object (name without the last, chunk, component)
+   *
+   * Computed once when the name is set or the header is deserialized
+   */
+  const Name&
+  GetContentName () const;
+
+  /**
+   * @brief Get hash of the content-level name (see GetContentName)
+   */
+  std::size_t
+  GetContentKey () const;
+
   /**
    * @brief Set content object timestamp
    * @param timestamp timestamp
@@ -223,6 +247,36 @@ public:
   inline const AdditionalInfo &
   GetAdditionalInfo () const;
 
+  /**
+   * @brief Get hop count of the serialized ContentObject, without deserializing the header
+   * @param packet packet that starts with ndnSIM-encoded ContentObject
+   */
+  static uint32_t
+  PeekHopCount (Ptr<const Packet> packet);
+
+  /**
+   * @brief Update hop count of the serialized ContentObject, without deserializing the header
+   * @param packet packet that starts with ndnSIM-encoded ContentObject
+   * @param hopCount new hop count
+   */
+  static void
+  PatchHopCount (Ptr<Packet> packet, uint32_t hopCount);
+
+  /**
+   * @brief Get piggybacked Q-value of the serialized ContentObject, without deserializing the header
+   * @param packet packet that starts with ndnSIM-encoded ContentObject
+   */
+  static Time
+  PeekQvalue (Ptr<const Packet> packet);
+
+  /**
+   * @brief Update piggybacked Q-value of the serialized ContentObject, without deserializing the header
+   * @param packet packet that starts with ndnSIM-encoded ContentObject
+   * @param qValue new Q-value
+   */
+  static void
+  PatchQvalue (Ptr<Packet> packet, const Time &qValue);
+
   //////////////////////////////////////////////////////////////////
 
   static TypeId GetTypeId (void); ///< @brief Get TypeId
@@ -232,8 +286,14 @@ public:
   virtual void Serialize (Buffer::Iterator start) const; ///< @brief Serialize the Header
   virtual uint32_t Deserialize (Buffer::Iterator start); ///< @brief Deserialize the Header
 
+private:
+  void
+  UpdateContentName ();
+
 private:
   Ptr<Name> m_name;
+  Ptr<Name> m_contentName;      ///< Name without the chunk component
+  std::size_t m_contentKey;     ///< Hash of m_contentName
   Time m_freshness;
   Time m_timestamp;
   uint32_t m_signature; 			// 0, means no signature, any other value application dependent (not a real signature)
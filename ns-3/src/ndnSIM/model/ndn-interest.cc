@@ -45,6 +45,8 @@ Interest::GetTypeId (void)
 
 Interest::Interest ()
   : m_name ()
+  , m_contentName ()
+  , m_contentKey (0)
   , m_scope (0xFF)
   , m_interestLifetime (Seconds (0))
   , m_nonce (0)
@@ -54,6 +56,8 @@ Interest::Interest ()
 
 Interest::Interest (const Interest &interest)
   : m_name                (Create<Name> (interest.GetName ()))
+  , m_contentName         (interest.m_contentName)
+  , m_contentKey          (interest.m_contentKey)
   , m_scope               (interest.m_scope)
   , m_interestLifetime    (interest.m_interestLifetime)
   , m_nonce               (interest.m_nonce)
@@ -74,12 +78,14 @@ void
 Interest::SetName (Ptr<Name> name)
 {
   m_name = name;
+  UpdateContentName ();
 }
 
 void
 Interest::SetName (const Name &name)
 {
   m_name = Create<Name> (name);
+  UpdateContentName ();
 }
 
 const Name&
@@ -95,6 +101,33 @@ Interest::GetNamePtr () const
   return m_name;
 }
 
+const Name&
+Interest::GetContentName () const
+{
+  if (m_contentName==0) throw InterestException();
+  return *m_contentName;
+}
+
+std::size_t
+Interest::GetContentKey () const
+{
+  return m_contentKey;
+}
+
+void
+Interest::UpdateContentName ()
+{
+  if (m_name == 0)
+    {
+      m_contentName = 0;
+      m_contentKey = 0;
+      return;
+    }
+
+  m_contentName = (m_name->size () > 0) ? Create<Name> (m_name->cut (1)) : m_name;
+  m_contentKey = hash_value (*m_contentName);
+}
+
 void
 Interest::SetScope (int8_t scope)
 {
@@ -195,6 +228,7 @@ Interest::Deserialize (Buffer::Iterator start)
   m_name = Create<Name> ();
   uint32_t offset = m_name->Deserialize (i);
   i.Next (offset);
+  UpdateContentName ();
   
   i.ReadU16 ();
   i.ReadU16 ();
@@ -130,6 +130,21 @@ public:
   Ptr<const Name>
   GetNamePtr () const;
 
+  /**
+   * @brief Get content-level name of the interest (interest name without the last, chunk, component)
+   *
+   * The content name and its hash are computed once, when the name is set or the header
+   * is deserialized, and used as a key for Qtab, Repo and FIB lookups
+   */
+  const Name&
+  GetContentName () const;
+
+  /**
+   * @brief Get hash of the content-level name (see GetContentName)
+   */
+  std::size_t
+  GetContentKey () const;
+
   /**
    * \brief Set Scope
    * Scope limits where the Interest may propagate. 
@@ -256,9 +271,15 @@ public:
    */
   static Ptr<Interest>
   GetInterest (Ptr<Packet> packet);
+
+private:
+  void
+  UpdateContentName ();
   
 private:
   Ptr<Name> m_name;    ///< Interest name
+  Ptr<Name> m_contentName;       ///< Interest name without the chunk component
+  std::size_t m_contentKey;      ///< Hash of m_contentName
   uint8_t m_scope;                ///< 0xFF not set, 0 local scope, 1 this host, 2 immediate neighborhood
   Time  m_interestLifetime;      ///< InterestLifetime
   uint32_t m_nonce;              ///< Nonce. not used if zero
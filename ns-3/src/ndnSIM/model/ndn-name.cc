@@ -71,27 +71,49 @@ Name::Name (const char *prefix)
 const std::list<std::string> &
 Name::GetComponents () const
 {
-  return m_prefix;
+  // components are only appended to the name, so only the new ones are missing from the list
+  for (size_t i = m_components.size (); i < size (); i++)
+    {
+      m_components.push_back (std::string (GetComponentData (i), GetComponentSize (i)));
+    }
+
+  return m_components;
 }
 
 std::string
 Name::GetLastComponent () const
 {
-  if (m_prefix.size () == 0)
+  if (size () == 0)
     {
       return "";
     }
 
-  return m_prefix.back ();
+  return std::string (GetComponentData (size () - 1), GetComponentSize (size () - 1));
+}
+
+std::size_t
+Name::HashPrefixes (size_t length) const
+{
+  NS_ASSERT_MSG (length <= size (), "Invalid number of components requested");
+
+  std::size_t hash = m_hashes.empty () ? 0 : m_hashes.back ();
+  for (size_t i = m_hashes.size (); i < length; i++)
+    {
+      // same as boost::hash_range on the components
+      boost::hash_combine (hash, boost::hash_range (GetComponentData (i), GetComponentData (i) + GetComponentSize (i)));
+      m_hashes.push_back (hash);
+    }
+
+  return hash;
 }
 
 std::list<boost::reference_wrapper<const std::string> >
 Name::GetSubComponents (size_t num) const
 {
-  NS_ASSERT_MSG (0<=num && num<=m_prefix.size (), "Invalid number of subcomponents requested");
+  NS_ASSERT_MSG (0<=num && num<=size (), "Invalid number of subcomponents requested");
 
   std::list<boost::reference_wrapper<const std::string> > subComponents;
-  std::list<std::string>::const_iterator component = m_prefix.begin();
+  std::list<std::string>::const_iterator component = GetComponents ().begin();
   for (size_t i=0; i<num; i++, component++)
     {
       subComponents.push_back (boost::ref (*component));
@@ -103,12 +125,14 @@ Name::GetSubComponents (size_t num) const
 Name
 Name::cut (size_t minusComponents) const
 {
+  NS_ASSERT_MSG (minusComponents <= size (), "Invalid number of components to cut");
+
+  size_t length = size () - minusComponents;
+
   Name retval;
-  std::list<std::string>::const_iterator component = m_prefix.begin ();
-  for (uint32_t i = 0; i < m_prefix.size () - minusComponents; i++, component++)
-    {
-      retval.Add (*component);
-    }
+  retval.m_buffer.assign (m_buffer, 0, GetComponentBegin (length));
+  retval.m_offsets.assign (m_offsets.begin (), m_offsets.begin () + length);
+  retval.m_hashes.assign (m_hashes.begin (), m_hashes.begin () + std::min (length, m_hashes.size ()));
 
   return retval;
 }
@@ -116,14 +140,7 @@ Name::cut (size_t minusComponents) const
 size_t
 Name::GetSerializedSize () const
 {
-  size_t nameSerializedSize = 2;
-
-  for (std::list<std::string>::const_iterator i = this->begin ();
-       i != this->end ();
-       i++)
-    {
-      nameSerializedSize += 2 + i->size ();
-    }
+  size_t nameSerializedSize = 2 + 2 * size () + m_buffer.size ();
   NS_ASSERT_MSG (nameSerializedSize < 30000, "Name is too long (> 30kbytes)");
 
   return nameSerializedSize;
@@ -136,12 +153,10 @@ Name::Serialize (Buffer::Iterator start) const
 
   i.WriteU16 (static_cast<uint16_t> (this->GetSerializedSize ()-2));
 
-  for (std::list<std::string>::const_iterator item = this->begin ();
-       item != this->end ();
-       item++)
+  for (size_t component = 0; component < size (); component++)
     {
-      i.WriteU16 (static_cast<uint16_t> (item->size ()));
-      i.Write (reinterpret_cast<const uint8_t*> (item->c_str ()), item->size ());
+      i.WriteU16 (static_cast<uint16_t> (GetComponentSize (component)));
+      i.Write (reinterpret_cast<const uint8_t*> (GetComponentData (component)), GetComponentSize (component));
     }
 
   return i.GetDistanceFrom (start);
@@ -153,15 +168,17 @@ Name::Deserialize (Buffer::Iterator start)
   Buffer::Iterator i = start;
 
   uint16_t nameLength = i.ReadU16 ();
+  m_buffer.reserve (m_buffer.size () + nameLength);
   while (nameLength > 0)
     {
       uint16_t length = i.ReadU16 ();
       nameLength = nameLength - 2 - length;
 
-      uint8_t tmp[length];
-      i.Read (tmp, length);
-
-      this->Add (string (reinterpret_cast<const char*> (tmp), length));
+      // read the component directly into the buffer
+      size_t offset = m_buffer.size ();
+      m_buffer.resize (offset + length);
+      i.Read (reinterpret_cast<uint8_t*> (&m_buffer[offset]), length);
+      m_offsets.push_back (m_buffer.size ());
     }
 
   return i.GetDistanceFrom (start);
@@ -170,11 +187,12 @@ Name::Deserialize (Buffer::Iterator start)
 void
 Name::Print (std::ostream &os) const
 {
-  for (const_iterator i=m_prefix.begin(); i!=m_prefix.end(); i++)
+  for (size_t i = 0; i < size (); i++)
     {
-      os << "/" << *i;
+      os << "/";
+      os.write (GetComponentData (i), GetComponentSize (i));
     }
-  if (m_prefix.size ()==0) os << "/";
+  if (size ()==0) os << "/";
 }
 
 std::ostream &
@@ -29,10 +29,13 @@
 #include <string>
 #include <algorithm>
 #include <list>
+#include <vector>
+#include <cstring>
 #include "ns3/object.h"
 #include "ns3/buffer.h"
 
 #include <boost/ref.hpp>
+#include <boost/functional/hash.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -45,11 +48,16 @@ namespace ndn {
  * Each Component element contains a sequence of zero or more bytes.
  * There are no restrictions on what byte sequences may be used.
  * The Name element in an Interest is often referred to with the term name prefix or simply prefix.
+ *
+ * Components are stored one after the other in a single buffer, with the offset where every
+ * component ends. Hashes of the prefixes are computed on first use and cached, so the tables
+ * (PIT, FIB, CS, ...) looking up the same name do not hash its components again.
+ * The list of components (GetComponents (), begin (), end ()) is built only when requested.
  */
 class Name : public SimpleRefCount<Name>
 {
 public:
-  typedef std::list<std::string>::iterator       iterator;
+  typedef std::list<std::string>::const_iterator iterator; ///< \brief components cannot be modified through iterators
   typedef std::list<std::string>::const_iterator const_iterator;
 
   /**
@@ -95,6 +103,13 @@ public:
   inline Name&
   Add (const T &value);
 
+  /**
+   * \brief Append string component (no conversion through std::ostringstream)
+   * @param[in] value The component to be appended
+   */
+  inline Name&
+  Add (const std::string &value);
+
   /**
    * \brief Generic constructor operator
    * The object of type T will be appended to the list of components
@@ -116,6 +131,34 @@ public:
   std::string
   GetLastComponent () const;
 
+  /**
+   * @brief Get pointer to the data of the component (numbering starts from 0), without copying it
+   */
+  inline const char *
+  GetComponentData (size_t num) const;
+
+  /**
+   * @brief Get size of the component (numbering starts from 0)
+   */
+  inline size_t
+  GetComponentSize (size_t num) const;
+
+  /**
+   * @brief Check if the component (numbering starts from 0) is equal to the string
+   */
+  inline bool
+  IsComponentEqual (size_t num, const std::string &component) const;
+
+  /**
+   * @brief Get hash of the prefix made of the first length components
+   *
+   * The hash is the same as boost::hash_range on the components (hash of the whole name is hash_value (name)).
+   * It is computed incrementally from the hash of the shorter prefix, and cached.
+   * @param[in] length Number of components. Valid value is in range [0, size ()]
+   */
+  inline std::size_t
+  GetPrefixHash (size_t length) const;
+
   /**
    * \brief Get subcomponents of the name, starting with first component
    * @param[in] num Number of components to return. Valid value is in range [1, GetComponents ().size ()]
@@ -200,7 +243,17 @@ public:
   typedef std::string partial_type;
 
 private:
-  std::list<std::string> m_prefix;                              ///< \brief a list of strings (components)
+  inline size_t
+  GetComponentBegin (size_t num) const;
+
+  std::size_t
+  HashPrefixes (size_t length) const;
+
+private:
+  std::string m_buffer;                                         ///< \brief all components, one after the other
+  std::vector<uint32_t> m_offsets;                              ///< \brief offset in m_buffer of the end of every component
+  mutable std::vector<std::size_t> m_hashes;                    ///< \brief cached hashes of the prefixes with 1, 2, ... components
+  mutable std::list<std::string> m_components;                  ///< \brief list of components, built on first request
 };
 
 /**
@@ -222,13 +275,13 @@ operator >> (std::istream &is, Name &components);
 size_t
 Name::size () const
 {
-  return m_prefix.size ();
+  return m_offsets.size ();
 }
 
 Name::iterator
 Name::begin ()
 {
-  return m_prefix.begin ();
+  return GetComponents ().begin ();
 }
 
 /**
@@ -237,7 +290,7 @@ Name::begin ()
 Name::const_iterator
 Name::begin () const
 {
-  return m_prefix.begin ();
+  return GetComponents ().begin ();
 }
 
 /**
@@ -246,7 +299,7 @@ Name::begin () const
 Name::iterator
 Name::end ()
 {
-  return m_prefix.end ();
+  return GetComponents ().end ();
 }
 
 /**
@@ -255,7 +308,43 @@ Name::end ()
 Name::const_iterator
 Name::end () const
 {
-  return m_prefix.end ();
+  return GetComponents ().end ();
+}
+
+size_t
+Name::GetComponentBegin (size_t num) const
+{
+  return (num == 0) ? 0 : m_offsets[num - 1];
+}
+
+const char *
+Name::GetComponentData (size_t num) const
+{
+  return m_buffer.data () + GetComponentBegin (num);
+}
+
+size_t
+Name::GetComponentSize (size_t num) const
+{
+  return m_offsets[num] - GetComponentBegin (num);
+}
+
+bool
+Name::IsComponentEqual (size_t num, const std::string &component) const
+{
+  return GetComponentSize (num) == component.size () &&
+    std::memcmp (GetComponentData (num), component.data (), component.size ()) == 0;
+}
+
+std::size_t
+Name::GetPrefixHash (size_t length) const
+{
+  if (length == 0)
+    return 0;
+  if (length <= m_hashes.size ())
+    return m_hashes[length - 1];
+
+  return HashPrefixes (length);
 }
 
 
@@ -281,7 +370,18 @@ Name::Add (const T &value)
 {
   std::ostringstream os;
   os << value;
-  m_prefix.push_back (os.str ());
+
+  return Add (os.str ());
+}
+
+/**
+ * \brief Append string component (no conversion through std::ostringstream)
+ */
+Name&
+Name::Add (const std::string &value)
+{
+  m_buffer.append (value);
+  m_offsets.push_back (m_buffer.size ());
 
   return *this;
 }
@@ -292,10 +392,7 @@ Name::Add (const T &value)
 bool
 Name::operator== (const Name &prefix) const
 {
-  if (m_prefix.size () != prefix.m_prefix.size ())
-    return false;
-
-  return std::equal (m_prefix.begin (), m_prefix.end (), prefix.m_prefix.begin ());
+  return m_offsets == prefix.m_offsets && m_buffer == prefix.m_buffer;
 }
 
 /**
@@ -304,8 +401,30 @@ Name::operator== (const Name &prefix) const
 bool
 Name::operator< (const Name &prefix) const
 {
-  return std::lexicographical_compare (m_prefix.begin (), m_prefix.end (),
-                                       prefix.m_prefix.begin (), prefix.m_prefix.end ());
+  // same order as std::lexicographical_compare on the lists of components
+  size_t common = std::min (size (), prefix.size ());
+  for (size_t i = 0; i < common; i++)
+    {
+      size_t size = GetComponentSize (i);
+      size_t otherSize = prefix.GetComponentSize (i);
+
+      int result = std::memcmp (GetComponentData (i), prefix.GetComponentData (i), std::min (size, otherSize));
+      if (result == 0 && size != otherSize)
+        result = (size < otherSize) ? -1 : 1;
+
+      if (result != 0)
+        return result < 0;
+    }
+  return size () < prefix.size ();
+}
+
+/**
+ * \brief Hash of the name components (allows using Name with boost::hash)
+ */
+inline std::size_t
+hash_value (const Name &name)
+{
+  return name.GetPrefixHash (name.size ());
 }
 
 ATTRIBUTE_HELPER_HEADER (Name);
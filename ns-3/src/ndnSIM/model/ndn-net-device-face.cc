@@ -109,13 +109,8 @@ NetDeviceFace::SendImpl (Ptr<Packet> packet)
   HeaderHelper::Type type = HeaderHelper::GetNdnHeaderType (packet);
   if (type == HeaderHelper::CONTENT_OBJECT_NDNSIM)
   {
-  	  Ptr<ContentObject> header = Create<ContentObject> ();
-  	  packet->RemoveHeader (*header);
-  	  uint32_t receivedHC = header->GetAdditionalInfo().GetHopCount();
-  	  //NS_LOG_UNCOND("Hop count extracted from the header: \t" << receivedHC);
-  	  uint32_t newHC = receivedHC + 1;
-  	  header->GetAdditionalInfo().SetHopCount(newHC);
-  	  packet->AddHeader(*header);
+  	  // hop count is updated in place, the header is not deserialized
+  	  ContentObject::PatchHopCount (packet, ContentObject::PeekHopCount (packet) + 1);
   }
 
   bool ok = m_netDevice->Send (packet, m_netDevice->GetBroadcast (),
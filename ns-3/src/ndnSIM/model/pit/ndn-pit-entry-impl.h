@@ -30,6 +30,7 @@ namespace pit {
 
 template<class Pit>
 class EntryImpl : public Entry
+                , public ExpiryWheel::Item
 {
 public:
   typedef Entry base_type;
@@ -44,36 +45,33 @@ public:
   : Entry (pit, header, fibEntry)
   , item_ (0)
   {
-    CONTAINER.i_time.insert (*this);
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.m_wheel->Schedule (*this);
   }
   
   virtual ~EntryImpl ()
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
-    
-    CONTAINER.RescheduleCleaning ();
   }
 
   virtual void
   UpdateLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
     super::UpdateLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
-
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.m_wheel->Update (*this);
   }
 
   virtual void
   OffsetLifetime (const Time &offsetTime)
   {
-    CONTAINER.i_time.erase (Pit::time_index::s_iterator_to (*this));
     super::OffsetLifetime (offsetTime);
-    CONTAINER.i_time.insert (*this);
-
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.m_wheel->Update (*this);
   }
+
+  // from ExpiryWheel::Item
+  virtual const Time &
+  GetExpireTime () const { return super::GetExpireTime (); }
+
+  virtual void
+  Expire () { CONTAINER.CleanExpired (*this); }
   
   // to make sure policies work
   void
@@ -82,23 +80,10 @@ public:
   typename Pit::super::iterator to_iterator () { return item_; }
   typename Pit::super::const_iterator to_iterator () const { return item_; }
 
-public:
-  boost::intrusive::set_member_hook<> time_hook_;
-  
 private:
   typename Pit::super::iterator item_;
 };
 
-template<class T>
-struct TimestampIndex
-{
-  bool
-  operator () (const T &a, const T &b) const
-  {
-    return a.GetExpireTime () < b.GetExpireTime ();
-  }
-};
-
 } // namespace pit
 } // namespace ndn
 } // namespace ns3
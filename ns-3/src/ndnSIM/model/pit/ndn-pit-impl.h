@@ -27,6 +27,7 @@
 #include "ns3/simulator.h"
 
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/ndn-expiry-wheel.h"
 #include "ndn-pit-entry-impl.h"
 
 #include "ns3/ndn-interest.h"
@@ -91,7 +92,7 @@ public:
   Find (const Name &prefix);
 
   virtual Ptr<Entry>
-  Create (Ptr<const Interest> header, Ptr<const Interest> headerNew);
+  Create (Ptr<const Interest> header);
 
   virtual void
   MarkErased (Ptr<Entry> entry);
@@ -118,8 +119,7 @@ public:
   GetPolicy () { return super::getPolicy (); }
 
 protected:
-  void RescheduleCleaning ();
-  void CleanExpired ();
+  void CleanExpired (entry &item);
 
   // inherited from Object class
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
@@ -136,25 +136,13 @@ private:
   GetCurrentSize () const;
 
 private:
-  EventId m_cleanEvent;
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
   Ptr<ForwardingStrategy> m_forwardingStrategy;
   Ptr<Qtab> m_qTab;
-
-
+  Ptr<ExpiryWheel> m_wheel; ///< \brief Per-node wheel that expires PIT entries
 
   static LogComponent g_log; ///< @brief Logging variable
 
-  // indexes
-  typedef
-  boost::intrusive::multiset<entry,
-                        boost::intrusive::compare < TimestampIndex< entry > >,
-                        boost::intrusive::member_hook< entry,
-                                                       boost::intrusive::set_member_hook<>,
-                                                       &entry::time_hook_>
-                        > time_index;
-  time_index i_time;
-
   friend class EntryImpl< PitImpl >;
 };
 
@@ -238,6 +226,10 @@ PitImpl<Policy>::NotifyNewAggregate ()
      {
        m_qTab = GetObject<Qtab> ();
      }
+  if (m_wheel == 0)
+    {
+      m_wheel = GetObject<ExpiryWheel> ();
+    }
 
 
   Pit::NotifyNewAggregate ();
@@ -252,61 +244,19 @@ PitImpl<Policy>::DoDispose ()
   m_forwardingStrategy = 0;
   m_fib = 0;
   m_qTab = 0;
-
+  m_wheel = 0;
 
   Pit::DoDispose ();
 }
 
 template<class Policy>
 void
-PitImpl<Policy>::RescheduleCleaning ()
-{
-  // m_cleanEvent.Cancel ();
-  Simulator::Remove (m_cleanEvent); // slower, but better for memory
-  if (i_time.empty ())
-    {
-      // NS_LOG_DEBUG ("No items in PIT");
-      return;
-    }
-
-  Time nextEvent = i_time.begin ()->GetExpireTime () - Simulator::Now ();
-  if (nextEvent <= 0) nextEvent = Seconds (0);
-
-  NS_LOG_DEBUG ("Schedule next cleaning in " <<
-                nextEvent.ToDouble (Time::S) << "s (at " <<
-                i_time.begin ()->GetExpireTime () << "s abs time");
-
-  m_cleanEvent = Simulator::Schedule (nextEvent,
-                                      &PitImpl<Policy>::CleanExpired, this);
-}
-
-template<class Policy>
-void
-PitImpl<Policy>::CleanExpired ()
+PitImpl<Policy>::CleanExpired (entry &item)
 {
-  NS_LOG_LOGIC ("Cleaning PIT. Total: " << i_time.size ());
-  Time now = Simulator::Now ();
-
-  // uint32_t count = 0;
-  while (!i_time.empty ())
-    {
-      typename time_index::iterator entry = i_time.begin ();
-      if (entry->GetExpireTime () <= now) // is the record stale?
-        {
-          //m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry->to_iterator ()->payload ());  // ** [MT] ** Tracing disabled
-          super::erase (entry->to_iterator ());
-          // count ++;
-        }
-      else
-        break; // nothing else to do. All later records will not be stale
-    }
+  NS_LOG_LOGIC ("Cleaning PIT entry " << item.GetPrefix () << ". Total: " << super::getPolicy ().size ());
 
-  if (super::getPolicy ().size ())
-    {
-      NS_LOG_DEBUG ("Size: " << super::getPolicy ().size ());
-      NS_LOG_DEBUG ("i_time size: " << i_time.size ());
-    }
-  RescheduleCleaning ();
+  //m_forwardingStrategy->WillEraseTimedOutPendingInterest (item.to_iterator ()->payload ());  // ** [MT] ** Tracing disabled
+  super::erase (item.to_iterator ());
 }
 
 // ** [MT] ** ORIGINAL VERSION. It is a LongestPrefixMatch searching
@@ -373,15 +323,16 @@ PitImpl<Policy>::Find (const Name &prefix)
 
 template<class Policy>
 Ptr<Entry>
-PitImpl<Policy>::Create (Ptr<const Interest> header, Ptr<const Interest> headerNew)
+PitImpl<Policy>::Create (Ptr<const Interest> header)
 {
   NS_LOG_DEBUG (header->GetName ());
+  NS_ASSERT_MSG (m_wheel != 0, "ExpiryWheel should be aggregated to the node");
   ////// **** ASSOLUTAMENTE COMMENTARE ****** ////// m_fib->Print(std::cout);
-  Ptr<fib::Entry> fibEntry = m_fib->ExactPrefixMatch (*headerNew);
+  Ptr<fib::Entry> fibEntry = m_fib->Find (header->GetContentName ());   // exact match on the content-level name
 
   if (fibEntry == 0)     // Quando l'Interest arriva ad un repo con una sola netDev, l'exact match non fornisce alcun risultato; quindi bisogna usare la default route.
   {
-	  fibEntry = m_fib->LongestPrefixMatch(*headerNew);
+	  fibEntry = m_fib->LongestPrefixMatch(*header);
 	  if(fibEntry==0)
 		  return 0;
   }
@@ -103,10 +103,12 @@ public:
    * @returns iterator to Pit entry. If record could not be created (e.g., limit reached),
    *          return end() iterator
    *
+   * FIB entry is selected using the content-level name of the interest (Interest::GetContentName)
+   *
    * Note. This call assumes that the entry does not exist (i.e., there was a Lookup call before)
    */
   virtual Ptr<pit::Entry>
-  Create (Ptr<const Interest> header, Ptr<const Interest> headerNew) = 0;
+  Create (Ptr<const Interest> header) = 0;
 
   /**
    * @brief Creates a PIT entry for the given interest according to the info stored in the BFs of the node
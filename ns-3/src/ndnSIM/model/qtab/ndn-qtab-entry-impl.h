@@ -30,6 +30,7 @@ namespace qtab {
 
 template<class Qtab>
 class EntryImpl : public Entry
+                , public ExpiryWheel::Item
 {
 public:
   typedef Entry base_type;
@@ -45,27 +46,34 @@ public:
   : Entry (qtab, header, fibEntry, interfaces)
   , item_ (0)
   {
-    CONTAINER.i_time.insert (*this);
-    CONTAINER.RescheduleCleaning ();
+    CONTAINER.m_wheel->Schedule (*this);
   }
 
   virtual ~EntryImpl ()
   {
-    CONTAINER.i_time.erase (Qtab::time_index::s_iterator_to (*this));
-
-    CONTAINER.RescheduleCleaning ();
   }
 
   virtual void
-  UpdateQtabEntryLifetime (const Time &offsetTime)
+  UpdateQtabEntryLifetime ()
   {
-    CONTAINER.i_time.erase (Qtab::time_index::s_iterator_to (*this));
     super::UpdateQtabEntryLifetime ();
-    CONTAINER.i_time.insert (*this);
+    CONTAINER.m_wheel->Update (*this);
+  }
 
-    CONTAINER.RescheduleCleaning ();
+  virtual void
+  SetExpireTime (const Time &expireTime)
+  {
+    super::SetExpireTime (expireTime);
+    CONTAINER.m_wheel->Update (*this);
   }
 
+  // from ExpiryWheel::Item
+  virtual const Time &
+  GetExpireTime () const { return super::GetExpireTime (); }
+
+  virtual void
+  Expire () { CONTAINER.CleanExpired (*this); }
+
 
   // to make sure policies work
   void
@@ -74,23 +82,10 @@ public:
   typename Qtab::super::iterator to_iterator () { return item_; }
   typename Qtab::super::const_iterator to_iterator () const { return item_; }
 
-public:
-  boost::intrusive::set_member_hook<> time_hook_;
-
 private:
   typename Qtab::super::iterator item_;
 };
 
-template<class T>
-struct TimestampIndex
-{
-  bool
-  operator () (const T &a, const T &b) const
-  {
-    return a.GetExpireTime () < b.GetExpireTime ();
-  }
-};
-
 } // namespace qtab
 } // namespace ndn
 } // namespace ns3
@@ -45,15 +45,13 @@ Entry::Entry (Qtab &container,
               uint32_t numInterfaces)
   : m_container (container)
   , m_interest (header)
+  , m_qMin (MicroSeconds (0), 0)
 {
   NS_LOG_FUNCTION (this);
 
   // Inizializzo la tabella dei qValue
   qValuesInterf.resize(numInterfaces, Time (std::numeric_limits<int64_t>::max ()));
 
-  // Inizializzo il minQvalue
-  minQValue = new qMin(MicroSeconds(0), 0);
-
   numberOfInterfaces = numInterfaces;
 
   // Setto i flag che indicano lo stato dell'algoritmo per questa entry.
@@ -91,7 +89,7 @@ Entry::UpdateQtabEntryLifetime ()
 const Name &
 Entry::GetPrefix () const
 {
-  return m_interest->GetName ();
+  return m_interest->GetContentName ();
 }
 
 const Time &
@@ -100,6 +98,12 @@ Entry::GetExpireTime () const
   return m_qTabEntryExpireTime;
 }
 
+void
+Entry::SetExpireTime (const Time &expireTime)
+{
+  m_qTabEntryExpireTime = expireTime;
+}
+
 
 Entry::in_iterator
 Entry::AddIncomingQtab (Ptr<Face> face)
@@ -270,6 +274,10 @@ Entry::SetMinDelayFace (Ptr<fib::Entry> fibEntry)
 void
 Entry::UpdateQvalue (uint32_t incomingFace, Time piggyQvalue)
 {
+	// Faces without an interface slot (i.e., application faces) carry no neighbour Q-value
+	if (incomingFace >= qValuesInterf.size () || incomingFace >= m_container.GetRttVect ().size ())
+		return;
+
 	double eta = m_container.GetEta();
 	Time rtt = m_container.GetRttVect().operator [](incomingFace);
 	if(qValuesInterf[incomingFace] == Time (std::numeric_limits<int64_t>::max ()))
@@ -324,14 +332,14 @@ Entry::CalculateMinQvalue ()
 		NS_LOG_UNCOND("ERRORE!! - Durante la exploration phase, non è stato aggiornato nessun qValue.");
 		return;
 	}
-	minQValue->interfId = intMin;
-	minQValue->qValueMin = *iterMin;
+	m_qMin.interfId = intMin;
+	m_qMin.qValueMin = *iterMin;
 }
 
 bool
 Entry::CheckContinueExploit (uint32_t incIntId)
 {
-	double qMinDouble = static_cast<double> (minQValue->qValueMin.ToDouble (Time::US));
+	double qMinDouble = static_cast<double> (m_qMin.qValueMin.ToDouble (Time::US));
 	double qIncIntDouble = static_cast<double> (qValuesInterf[incIntId].ToDouble (Time::US));
 
 	double valueChecked = (std::abs(qMinDouble-qIncIntDouble)/qMinDouble);
@@ -345,7 +353,7 @@ Entry::CheckContinueExploit (uint32_t incIntId)
 Entry::qMin&
 Entry::GetqMin ()
 {
-	return *minQValue;
+	return m_qMin;
 }
 
 std::vector<Time> &
@@ -354,6 +362,24 @@ Entry::GetqValuesInterf ()
 	return qValuesInterf;
 }
 
+uint32_t
+Entry::GetNQvalues () const
+{
+  return qValuesInterf.size ();
+}
+
+Time
+Entry::GetQvalue (uint32_t interface) const
+{
+  return qValuesInterf[interface];
+}
+
+void
+Entry::SetQvalue (uint32_t interface, const Time &qValue)
+{
+  qValuesInterf[interface] = qValue;
+}
+
 
 
 
@@ -107,8 +107,6 @@ public:
 	  uint32_t interfId;
   };
 
-  qMin* minQValue;
-
 
   /**
    * \brief PIT entry constructor
@@ -148,6 +146,14 @@ public:
   const Time &
   GetExpireTime () const;
 
+  /**
+   * @brief Set expiration time of the record (e.g., when the entry is restored by WarmStateHelper)
+   *
+   * Unlike UpdateQtabEntryLifetime, the expiration time can be moved earlier
+   */
+  virtual void
+  SetExpireTime (const Time &expireTime);
+
 
   /**
    * @brief Add `face` to the list of incoming faces
@@ -250,6 +256,24 @@ public:
   std::vector<Time> &
   GetqValuesInterf ();
 
+  /**
+   * @brief Get number of per-interface qValues of the entry
+   */
+  virtual uint32_t
+  GetNQvalues () const;
+
+  /**
+   * @brief Get the qValue of the interface (Time (max int64) if it was not updated yet)
+   */
+  virtual Time
+  GetQvalue (uint32_t interface) const;
+
+  /**
+   * @brief Set the qValue of the interface
+   */
+  virtual void
+  SetQvalue (uint32_t interface, const Time &qValue);
+
   /**
    * @brief Get the flag which indicates the phase of the algorithm
    */
@@ -331,22 +355,22 @@ public:
   /**
    * @brief Update the specified qValue
    */
-  void
+  virtual void
   UpdateQvalue (uint32_t incomingFace, Time piggyQvalue);
 
   /**
    * @brief Extract the minimum qValue to be piggybacked.
    */
-  Time
+  virtual Time
   ExtractTempMinQvalue ();
 
   /**
    * @brief Calculate the minimum qValue when entering the exploitation phase.
    */
-  void
+  virtual void
   CalculateMinQvalue ();
 
-  bool
+  virtual bool
   CheckContinueExploit (uint32_t incIntId);
 
 
@@ -365,6 +389,8 @@ protected:
   /////*****/////QTAB
   std::vector<Time> qValuesInterf;        // Vettore dei qValue associati alle singole interfacce.
 
+  qMin m_qMin;                            ///< \brief Minimum qValue and its interface (computed when entering the exploitation phase)
+
 
   bool exploration;
   bool isFirstExploration;
@@ -0,0 +1,492 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-qtab-flat.h"
+
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+#include "ns3/ndn-name.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <boost/ref.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.qtab.QtabFlat");
+
+namespace ns3 {
+namespace ndn {
+namespace qtab {
+
+NS_OBJECT_ENSURE_REGISTERED (QtabFlat);
+
+const int64_t QtabFlat::EMPTY_QVALUE = std::numeric_limits<int64_t>::max ();
+const uint32_t QtabFlat::NO_SLOT = std::numeric_limits<uint32_t>::max ();
+
+static const uint32_t INITIAL_CAPACITY = 64; // must be a power of two
+
+#define CONTAINER static_cast<QtabFlat&> (m_container)
+
+FlatEntry::FlatEntry (QtabFlat &qtab, Ptr<const Interest> header, Ptr<fib::Entry> fibEntry)
+  : Entry (qtab, header, fibEntry, 0) // Q-values are kept by the table
+  , m_key (header->GetContentKey ())
+  , m_slot (QtabFlat::NO_SLOT)
+{
+}
+
+FlatEntry::~FlatEntry ()
+{
+}
+
+void
+FlatEntry::UpdateQtabEntryLifetime ()
+{
+  Entry::UpdateQtabEntryLifetime ();
+
+  if (IsStored ())
+    CONTAINER.m_wheel->Update (*this);
+}
+
+void
+FlatEntry::SetExpireTime (const Time &expireTime)
+{
+  Entry::SetExpireTime (expireTime);
+
+  if (IsStored ())
+    CONTAINER.m_wheel->Update (*this);
+}
+
+const Time &
+FlatEntry::GetExpireTime () const
+{
+  return Entry::GetExpireTime ();
+}
+
+void
+FlatEntry::Expire ()
+{
+  CONTAINER.CleanExpired (*this);
+}
+
+void
+FlatEntry::UpdateQvalue (uint32_t incomingFace, Time piggyQvalue)
+{
+  NS_ASSERT_MSG (IsStored (), "Entry was removed from QTAB");
+
+  // Faces without an interface slot (i.e., application faces) carry no neighbour Q-value
+  if (incomingFace >= CONTAINER.GetNFaces () || incomingFace >= m_container.GetRttVect ().size ())
+    return;
+
+  int64_t &qValue = CONTAINER.GetRow (m_slot)[incomingFace];
+  const Time &rtt = m_container.GetRttVect ()[incomingFace];
+
+  if (qValue == QtabFlat::EMPTY_QVALUE)
+    qValue = (piggyQvalue + rtt).GetNanoSeconds ();
+  else
+    {
+      // same arithmetic as Entry::UpdateQvalue: average in us, result truncated to us
+      double eta = m_container.GetEta ();
+      double value = qValue / 1000.0;
+      double newValue = (1 - eta) * value + eta * (piggyQvalue.ToDouble (Time::US) + rtt.ToDouble (Time::US));
+      qValue = static_cast<int64_t> (static_cast<uint64_t> (newValue)) * 1000;
+    }
+}
+
+uint32_t
+FlatEntry::GetNQvalues () const
+{
+  return IsStored () ? CONTAINER.GetNFaces () : 0;
+}
+
+Time
+FlatEntry::GetQvalue (uint32_t interface) const
+{
+  NS_ASSERT_MSG (IsStored (), "Entry was removed from QTAB");
+  return NanoSeconds (CONTAINER.GetRow (m_slot)[interface]);
+}
+
+void
+FlatEntry::SetQvalue (uint32_t interface, const Time &qValue)
+{
+  NS_ASSERT_MSG (IsStored (), "Entry was removed from QTAB");
+  CONTAINER.GetRow (m_slot)[interface] = qValue.GetNanoSeconds ();
+}
+
+Time
+FlatEntry::ExtractTempMinQvalue ()
+{
+  NS_ASSERT_MSG (IsStored (), "Entry was removed from QTAB");
+
+  const int64_t *row = CONTAINER.GetRow (m_slot);
+  int64_t minValue = *std::min_element (row, row + CONTAINER.GetNFaces ());
+
+  if (minValue != QtabFlat::EMPTY_QVALUE)
+    return NanoSeconds (minValue);
+  else
+    return NanoSeconds (0);
+}
+
+void
+FlatEntry::CalculateMinQvalue ()
+{
+  NS_ASSERT_MSG (IsStored (), "Entry was removed from QTAB");
+
+  const int64_t *row = CONTAINER.GetRow (m_slot);
+  const int64_t *minValue = std::min_element (row, row + CONTAINER.GetNFaces ());
+
+  if (*minValue == QtabFlat::EMPTY_QVALUE)
+    {
+      NS_LOG_DEBUG ("No qValue has been updated during the exploration phase");
+      return;
+    }
+
+  m_qMin.interfId = std::distance (row, minValue);
+  m_qMin.qValueMin = NanoSeconds (*minValue);
+}
+
+bool
+FlatEntry::CheckContinueExploit (uint32_t incIntId)
+{
+  NS_ASSERT_MSG (IsStored (), "Entry was removed from QTAB");
+
+  double qMinDouble = m_qMin.qValueMin.ToDouble (Time::US);
+  double qIncIntDouble = CONTAINER.GetRow (m_slot)[incIntId] / 1000.0;
+
+  double valueChecked = (std::abs (qMinDouble - qIncIntDouble) / qMinDouble);
+
+  return !(valueChecked > m_container.GetDelta ());
+}
+
+#undef CONTAINER
+
+////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+TypeId
+QtabFlat::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::qtab::Flat")
+    .SetGroupName ("Ndn")
+    .SetParent<Qtab> ()
+    .AddConstructor< QtabFlat > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in QTAB. If 0, limit is not enforced",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&QtabFlat::GetMaxSize,
+                                         &QtabFlat::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+
+    .AddAttribute ("CurrentSize", "Get current number of entries in QTAB",
+                   TypeId::ATTR_GET,
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&QtabFlat::GetCurrentSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+
+  return tid;
+}
+
+QtabFlat::QtabFlat ()
+  : m_nFaces (0)
+  , m_size (0)
+  , m_maxSize (0)
+  , m_shift (64)
+{
+  Resize (INITIAL_CAPACITY, 1); // number of faces is updated on the first CreateQtab
+}
+
+QtabFlat::~QtabFlat ()
+{
+}
+
+uint32_t
+QtabFlat::GetMaxSize () const
+{
+  return m_maxSize;
+}
+
+void
+QtabFlat::SetMaxSize (uint32_t maxSize)
+{
+  m_maxSize = maxSize;
+}
+
+uint32_t
+QtabFlat::GetCurrentSize () const
+{
+  return m_size;
+}
+
+void
+QtabFlat::NotifyNewAggregate ()
+{
+  if (m_wheel == 0)
+    {
+      m_wheel = GetObject<ExpiryWheel> ();
+    }
+
+  Qtab::NotifyNewAggregate ();
+}
+
+void
+QtabFlat::DoDispose ()
+{
+  for (uint32_t slot = 0; slot < GetCapacity (); slot ++)
+    {
+      if (m_entries[slot] == 0) continue;
+
+      if (m_entries[slot]->IsScheduled ())
+        m_wheel->Cancel (*m_entries[slot]); // entry may outlive the table
+      m_entries[slot]->m_slot = NO_SLOT;
+      m_entries[slot] = 0;
+    }
+  m_size = 0;
+  m_wheel = 0;
+
+  Qtab::DoDispose ();
+}
+
+void
+QtabFlat::CleanExpired (FlatEntry &entry)
+{
+  NS_LOG_DEBUG ("Erasing qTabEntry: " << entry.GetPrefix ());
+  Erase (entry.m_slot);
+}
+
+uint32_t
+QtabFlat::FindSlot (std::size_t key, const Name &name) const
+{
+  uint32_t mask = GetCapacity () - 1;
+  for (uint32_t slot = HomeSlot (key); m_entries[slot] != 0; slot = (slot + 1) & mask)
+    {
+      if (m_keys[slot] == key && m_entries[slot]->GetPrefix () == name)
+        return slot;
+    }
+  return NO_SLOT;
+}
+
+void
+QtabFlat::Erase (uint32_t slot)
+{
+  NS_ASSERT (slot < GetCapacity () && m_entries[slot] != 0);
+
+  Ptr<FlatEntry> entry = m_entries[slot];
+  if (entry->IsScheduled ())
+    m_wheel->Cancel (*entry);
+  entry->m_slot = NO_SLOT;
+  m_entries[slot] = 0;
+  m_size --;
+
+  // backward-shift deletion: move up entries that would become unreachable because of the hole
+  uint32_t mask = GetCapacity () - 1;
+  uint32_t hole = slot;
+  for (uint32_t next = (slot + 1) & mask; m_entries[next] != 0; next = (next + 1) & mask)
+    {
+      uint32_t home = HomeSlot (m_keys[next]);
+      if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+          m_entries[hole] = m_entries[next];
+          m_keys[hole] = m_keys[next];
+          std::copy (GetRow (next), GetRow (next) + m_nFaces, GetRow (hole));
+          m_entries[hole]->m_slot = hole;
+
+          m_entries[next] = 0;
+          hole = next;
+        }
+    }
+}
+
+void
+QtabFlat::Resize (uint32_t capacity, uint32_t nFaces)
+{
+  NS_LOG_FUNCTION (this << capacity << nFaces);
+  NS_ASSERT ((capacity & (capacity - 1)) == 0);
+
+  std::vector< Ptr<FlatEntry> > entries (capacity);
+  std::vector<std::size_t> keys (capacity);
+  std::vector<int64_t> qValues (static_cast<std::size_t> (capacity) * nFaces, EMPTY_QVALUE);
+
+  uint32_t shift = 64;
+  for (uint32_t c = capacity; c > 1; c >>= 1)
+    shift --;
+
+  std::swap (m_entries, entries);
+  std::swap (m_keys, keys);
+  std::swap (m_qValues, qValues);
+  std::swap (m_nFaces, nFaces);
+  m_shift = shift;
+
+  // re-insert entries (note that after the swap, nFaces and the *old* arrays refer to the previous table)
+  uint32_t mask = capacity - 1;
+  for (uint32_t oldSlot = 0; oldSlot < entries.size (); oldSlot ++)
+    {
+      if (entries[oldSlot] == 0)
+        continue;
+
+      uint32_t slot = HomeSlot (keys[oldSlot]);
+      while (m_entries[slot] != 0)
+        slot = (slot + 1) & mask;
+
+      m_entries[slot] = entries[oldSlot];
+      m_keys[slot] = keys[oldSlot];
+      std::copy (qValues.begin () + static_cast<std::size_t> (oldSlot) * nFaces,
+                 qValues.begin () + static_cast<std::size_t> (oldSlot + 1) * nFaces,
+                 GetRow (slot));
+      m_entries[slot]->m_slot = slot;
+    }
+}
+
+Ptr<Entry>
+QtabFlat::LookupQtab (const ContentObject &header)
+{
+  uint32_t slot = FindSlot (header.GetContentKey (), header.GetContentName ());
+  if (slot == NO_SLOT)
+    return 0;
+  else
+    return m_entries[slot];
+}
+
+Ptr<Entry>
+QtabFlat::LookupQtab (const Interest &header)
+{
+  uint32_t slot = FindSlot (header.GetContentKey (), header.GetContentName ());
+  if (slot == NO_SLOT)
+    return 0;
+  else
+    return m_entries[slot];
+}
+
+Ptr<Entry>
+QtabFlat::FindQtab (const Name &prefix)
+{
+  uint32_t slot = FindSlot (hash_value (prefix), prefix);
+  if (slot == NO_SLOT)
+    return 0;
+  else
+    return m_entries[slot];
+}
+
+Ptr<Entry>
+QtabFlat::CreateQtab (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry, uint32_t interfaces)
+{
+  NS_LOG_DEBUG (header->GetContentName ());
+  NS_ASSERT_MSG (m_wheel != 0, "ExpiryWheel should be aggregated to the node");
+
+  uint32_t slot = FindSlot (header->GetContentKey (), header->GetContentName ());
+  if (slot != NO_SLOT)
+    return m_entries[slot];
+
+  if (m_maxSize != 0 && m_size >= m_maxSize)
+    return 0;
+
+  // keep load factor below 1/2, so probe sequences stay short
+  if (interfaces > m_nFaces || 2 * (m_size + 1) > GetCapacity ())
+    {
+      uint32_t capacity = GetCapacity ();
+      while (2 * (m_size + 1) > capacity)
+        capacity <<= 1;
+
+      Resize (capacity, std::max (interfaces, m_nFaces));
+    }
+
+  Ptr<FlatEntry> newEntry = ns3::Create<FlatEntry> (boost::ref (*this), header, fibEntry);
+
+  uint32_t mask = GetCapacity () - 1;
+  slot = HomeSlot (newEntry->GetKey ());
+  while (m_entries[slot] != 0)
+    slot = (slot + 1) & mask;
+
+  m_entries[slot] = newEntry;
+  m_keys[slot] = newEntry->GetKey ();
+  std::fill (GetRow (slot), GetRow (slot) + m_nFaces, EMPTY_QVALUE);
+  newEntry->m_slot = slot;
+  m_size ++;
+
+  m_wheel->Schedule (*newEntry);
+
+  return newEntry;
+}
+
+void
+QtabFlat::MarkErasedQtab (Ptr<Entry> item)
+{
+  Ptr<FlatEntry> entry = StaticCast<FlatEntry> (item);
+  if (entry->IsStored ())
+    Erase (entry->m_slot);
+}
+
+void
+QtabFlat::PrintQtab (std::ostream& os) const
+{
+  for (uint32_t slot = 0; slot < GetCapacity (); slot ++)
+    {
+      if (m_entries[slot] == 0) continue;
+
+      os << m_entries[slot]->GetPrefix () << "\t" << *m_entries[slot] << "\n";
+    }
+}
+
+uint32_t
+QtabFlat::GetSizeQtab () const
+{
+  return m_size;
+}
+
+Ptr<Entry>
+QtabFlat::BeginQtab ()
+{
+  for (uint32_t slot = 0; slot < GetCapacity (); slot ++)
+    {
+      if (m_entries[slot] != 0)
+        return m_entries[slot];
+    }
+
+  return EndQtab ();
+}
+
+Ptr<Entry>
+QtabFlat::EndQtab ()
+{
+  return 0;
+}
+
+Ptr<Entry>
+QtabFlat::NextQtab (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  Ptr<FlatEntry> entry = StaticCast<FlatEntry> (from);
+  NS_ASSERT_MSG (entry->IsStored (), "Entry was removed from QTAB");
+
+  for (uint32_t slot = entry->m_slot + 1; slot < GetCapacity (); slot ++)
+    {
+      if (m_entries[slot] != 0)
+        return m_entries[slot];
+    }
+
+  return EndQtab ();
+}
+
+} // namespace qtab
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,291 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_QTAB_FLAT_H_
+#define	_NDN_QTAB_FLAT_H_
+
+#include "ndn-qtab.h"
+#include "../../utils/ndn-expiry-wheel.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+class Fib;
+
+namespace qtab {
+
+class QtabFlat;
+
+/**
+ * \ingroup ndn
+ * \brief QTAB entry of QtabFlat
+ *
+ * The entry does not own its Q-values: they are stored by the table (one row per slot,
+ * integer nanoseconds), so all Q-value operations are redirected to the row of the slot
+ * currently occupied by the entry.  GetqValuesInterf () of this entry is always empty.
+ */
+class FlatEntry : public Entry
+                , public ExpiryWheel::Item
+{
+public:
+  /**
+   * \brief Constructor
+   * \param qtab  table that owns the entry
+   * \param header Interest that created the entry
+   * \param fibEntry FIB entry of the content
+   */
+  FlatEntry (QtabFlat &qtab, Ptr<const Interest> header, Ptr<fib::Entry> fibEntry);
+
+  virtual ~FlatEntry ();
+
+  /**
+   * @brief Update lifetime of the entry (and its position in the expiration index)
+   */
+  virtual void
+  UpdateQtabEntryLifetime ();
+
+  virtual void
+  SetExpireTime (const Time &expireTime);
+
+  virtual uint32_t
+  GetNQvalues () const;
+
+  virtual Time
+  GetQvalue (uint32_t interface) const;
+
+  virtual void
+  SetQvalue (uint32_t interface, const Time &qValue);
+
+  virtual void
+  UpdateQvalue (uint32_t incomingFace, Time piggyQvalue);
+
+  virtual Time
+  ExtractTempMinQvalue ();
+
+  virtual void
+  CalculateMinQvalue ();
+
+  virtual bool
+  CheckContinueExploit (uint32_t incIntId);
+
+  // from ExpiryWheel::Item
+  virtual const Time &
+  GetExpireTime () const;
+
+  virtual void
+  Expire ();
+
+  /**
+   * @brief Get hash of the content name (Interest::GetContentKey)
+   */
+  inline std::size_t
+  GetKey () const;
+
+  /**
+   * @brief Check if the entry is still stored in the table
+   */
+  inline bool
+  IsStored () const;
+
+private:
+  friend class QtabFlat;
+
+  std::size_t m_key;
+  uint32_t m_slot; ///< @brief Current slot in the table (QtabFlat::NO_SLOT, if entry was removed)
+};
+
+/**
+ * \ingroup ndn
+ * \brief QTAB implementation based on a flat open-addressing hash table
+ *
+ * Entries are keyed by the hash of the content-level name (Interest::GetContentKey) and
+ * stored with linear probing in power-of-two arrays (backward-shift deletion, no tombstones).
+ * Full names are compared only when hashes match.  Per-face Q-values of all entries are
+ * kept in a single array of integer nanoseconds (one row of GetNFaces () values per slot),
+ * instead of a std::vector<Time> per entry.
+ *
+ * Forwarding decisions are identical to the trie-based QtabImpl.
+ */
+class QtabFlat : public Qtab
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  /**
+   * \brief Constructor
+   */
+  QtabFlat ();
+
+  /**
+   * \brief Destructor
+   */
+  virtual ~QtabFlat ();
+
+  // inherited from Qtab
+  virtual Ptr<Entry>
+  LookupQtab (const ContentObject &header);
+
+  virtual Ptr<Entry>
+  LookupQtab (const Interest &header);
+
+  virtual Ptr<Entry>
+  FindQtab (const Name &prefix);
+
+  virtual Ptr<Entry>
+  CreateQtab (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry, uint32_t interfaces);
+
+  virtual void
+  MarkErasedQtab (Ptr<Entry> entry);
+
+  virtual void
+  PrintQtab (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSizeQtab () const;
+
+  virtual Ptr<Entry>
+  BeginQtab ();
+
+  virtual Ptr<Entry>
+  EndQtab ();
+
+  virtual Ptr<Entry>
+  NextQtab (Ptr<Entry>);
+
+  /**
+   * @brief Get number of slots in the table
+   */
+  inline uint32_t
+  GetCapacity () const;
+
+  /**
+   * @brief Get number of per-face Q-values kept for each slot
+   */
+  inline uint32_t
+  GetNFaces () const;
+
+  /**
+   * @brief Value of a Q-value that was not yet updated (same as Time (max int64) of the QtabImpl)
+   */
+  static const int64_t EMPTY_QVALUE;
+
+  /**
+   * @brief Slot number of the entry that is not stored in the table
+   */
+  static const uint32_t NO_SLOT;
+
+protected:
+  void CleanExpired (FlatEntry &entry);
+
+  // inherited from Object class
+  virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  inline uint32_t
+  HomeSlot (std::size_t key) const;
+
+  uint32_t
+  FindSlot (std::size_t key, const Name &name) const;
+
+  void
+  Erase (uint32_t slot);
+
+  void
+  Resize (uint32_t capacity, uint32_t nFaces);
+
+  inline int64_t *
+  GetRow (uint32_t slot);
+
+  uint32_t
+  GetMaxSize () const;
+
+  void
+  SetMaxSize (uint32_t maxSize);
+
+  uint32_t
+  GetCurrentSize () const;
+
+private:
+  // struct of arrays, indexed by slot
+  std::vector< Ptr<FlatEntry> > m_entries; ///< @brief entry in the slot (0 for free slots)
+  std::vector<std::size_t> m_keys;         ///< @brief content key of the entry in the slot
+  std::vector<int64_t> m_qValues;          ///< @brief per-face Q-values [ns], m_nFaces per slot
+
+  uint32_t m_nFaces;
+  uint32_t m_size;
+  uint32_t m_maxSize;
+  uint32_t m_shift; ///< @brief 64 - log2 (capacity), used to spread keys over slots
+
+  Ptr<ExpiryWheel> m_wheel; ///< @brief Per-node wheel that expires stored entries
+
+  friend class FlatEntry;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+inline std::size_t
+FlatEntry::GetKey () const
+{
+  return m_key;
+}
+
+inline bool
+FlatEntry::IsStored () const
+{
+  return m_slot != QtabFlat::NO_SLOT;
+}
+
+inline uint32_t
+QtabFlat::GetCapacity () const
+{
+  return m_entries.size ();
+}
+
+inline uint32_t
+QtabFlat::GetNFaces () const
+{
+  return m_nFaces;
+}
+
+inline uint32_t
+QtabFlat::HomeSlot (std::size_t key) const
+{
+  // Fibonacci hashing: boost::hash_range is weak in low bits for similar names
+  return static_cast<uint32_t> ((static_cast<uint64_t> (key) * 11400714819323198485ull) >> m_shift);
+}
+
+inline int64_t *
+QtabFlat::GetRow (uint32_t slot)
+{
+  return &m_qValues[static_cast<std::size_t> (slot) * m_nFaces];
+}
+
+} // namespace qtab
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_QTAB_FLAT_H_ */
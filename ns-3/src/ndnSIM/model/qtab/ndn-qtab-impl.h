@@ -27,6 +27,7 @@
 #include "ns3/simulator.h"
 
 #include "../../utils/trie/trie-with-policy.h"
+#include "../../utils/ndn-expiry-wheel.h"
 #include "ndn-qtab-entry-impl.h"
 
 #include "ns3/ndn-interest.h"
@@ -117,8 +118,7 @@ public:
   GetPolicy () { return super::getPolicy (); }
 
 protected:
-  void RescheduleCleaning ();
-  void CleanExpired ();
+  void CleanExpired (entry &item);
 
   // inherited from Object class
   virtual void NotifyNewAggregate (); ///< @brief Even when object is aggregated to another Object
@@ -135,22 +135,12 @@ private:
   GetCurrentSize () const;
 
 private:
-  EventId m_cleanEvent;
   Ptr<Fib> m_fib; ///< \brief Link to FIB table
   Ptr<ForwardingStrategy> m_forwardingStrategy;
+  Ptr<ExpiryWheel> m_wheel; ///< \brief Per-node wheel that expires QTAB entries
 
   static LogComponent g_log; ///< @brief Logging variable
 
-  // indexes
-  typedef
-  boost::intrusive::multiset<entry,
-                        boost::intrusive::compare < TimestampIndex< entry > >,
-                        boost::intrusive::member_hook< entry,
-                                                       boost::intrusive::set_member_hook<>,
-                                                       &entry::time_hook_>
-                        > time_index;
-  time_index i_time;
-
   friend class EntryImpl< QtabImpl >;
 };
 
@@ -230,6 +220,10 @@ QtabImpl<Policy>::NotifyNewAggregate ()
     {
       m_forwardingStrategy = GetObject<ForwardingStrategy> ();
     }
+  if (m_wheel == 0)
+    {
+      m_wheel = GetObject<ExpiryWheel> ();
+    }
 
   Qtab::NotifyNewAggregate ();
 }
@@ -238,66 +232,30 @@ template<class Policy>
 void
 QtabImpl<Policy>::DoDispose ()
 {
+  // Entries of content names with no components live in the trie root, which clear () does not touch.
+  // Remove it explicitly, otherwise its destructor would run after the table has been destroyed
+  if (super::getTrie ().payload () != 0)
+    super::erase (&super::getTrie ());
+
   super::clear ();
 
   m_forwardingStrategy = 0;
   m_fib = 0;
+  m_wheel = 0;
 
   Qtab::DoDispose ();
 }
 
 template<class Policy>
 void
-QtabImpl<Policy>::RescheduleCleaning ()
-{
-  // m_cleanEvent.Cancel ();
-  Simulator::Remove (m_cleanEvent); // slower, but better for memory
-  if (i_time.empty ())
-    {
-      // NS_LOG_DEBUG ("No items in PIT");
-      return;
-    }
-
-  Time nextEvent = i_time.begin ()->GetExpireTime () - Simulator::Now ();
-  if (nextEvent <= 0) nextEvent = Seconds (0);
-
-  NS_LOG_DEBUG ("Schedule next cleaning in " <<
-                nextEvent.ToDouble (Time::S) << "s (at " <<
-                i_time.begin ()->GetExpireTime () << "s abs time");
-
-  m_cleanEvent = Simulator::Schedule (nextEvent,
-                                      &QtabImpl<Policy>::CleanExpired, this);
-}
-
-template<class Policy>
-void
-QtabImpl<Policy>::CleanExpired ()
+QtabImpl<Policy>::CleanExpired (entry &item)
 {
-  NS_LOG_LOGIC ("Cleaning QTAB. Total: " << i_time.size ());
-  Time now = Simulator::Now ();
+  NS_LOG_LOGIC ("Cleaning QTAB entry " << item.GetPrefix () << ". Total: " << super::getPolicy ().size ());
 
-  // uint32_t count = 0;
-  while (!i_time.empty ())
-    {
-      typename time_index::iterator entry = i_time.begin ();
-      if (entry->GetExpireTime () <= now) // is the record stale?
-        {
-          //m_forwardingStrategy->WillEraseTimedOutPendingInterest (entry->to_iterator ()->payload ());  // ** [MT] ** Tracing disabled
-          super::erase (entry->to_iterator ());
-          uint32_t thisNode = m_fib->GetObject<Node>()->GetId();
-          NS_LOG_UNCOND("QtabImpl/CE - NODE:\t" << thisNode << "\t Erasing qTabEntry:\t" << entry->to_iterator()->payload());
-          // count ++;
-        }
-      else
-        break; // nothing else to do. All later records will not be stale
-    }
-
-  if (super::getPolicy ().size ())
-    {
-      NS_LOG_DEBUG ("Size: " << super::getPolicy ().size ());
-      NS_LOG_DEBUG ("i_time size: " << i_time.size ());
-    }
-  RescheduleCleaning ();
+  //m_forwardingStrategy->WillEraseTimedOutPendingInterest (item.to_iterator ()->payload ());  // ** [MT] ** Tracing disabled
+  uint32_t thisNode = m_fib->GetObject<Node>()->GetId();
+  NS_LOG_UNCOND("QtabImpl/CE - NODE:\t" << thisNode << "\t Erasing qTabEntry:\t" << item.to_iterator()->payload());
+  super::erase (item.to_iterator ());
 }
 
 // ** [MT] ** ORIGINAL VERSION. It is a LongestPrefixMatch searching
@@ -321,7 +279,7 @@ QtabImpl<Policy>::LookupQtab (const ContentObject &header)
 {
   typename super::iterator foundItem, lastItem;
   bool reachLast;
-  boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (header.GetName ());
+  boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (header.GetContentName ());
 
   if (!reachLast || lastItem == super::end ())
    return 0;
@@ -340,7 +298,7 @@ QtabImpl<Policy>::LookupQtab (const Interest &header)
 
   typename super::iterator foundItem, lastItem;
   bool reachLast;
-  boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (header.GetName ());
+  boost::tie (foundItem, reachLast, lastItem) = super::getTrie ().find (header.GetContentName ());
 
   if (!reachLast || lastItem == super::end ())
     return 0;
@@ -365,10 +323,11 @@ template<class Policy>
 Ptr<Entry>
 QtabImpl<Policy>::CreateQtab (Ptr<const Interest> header, Ptr<fib::Entry> fibEntry, uint32_t interfaces)
 {
-  NS_LOG_DEBUG (header->GetName ());
+  NS_LOG_DEBUG (header->GetContentName ());
+  NS_ASSERT_MSG (m_wheel != 0, "ExpiryWheel should be aggregated to the node");
 
   Ptr< entry > newEntry = ns3::Create< entry > (boost::ref (*this), header, fibEntry, interfaces);
-  std::pair< typename super::iterator, bool > result = super::insert (header->GetName (), newEntry);
+  std::pair< typename super::iterator, bool > result = super::insert (header->GetContentName (), newEntry);
   if (result.first != super::end ())
     {
       if (result.second)
@@ -66,24 +66,26 @@ public:
   virtual ~Qtab ();
 
   /**
-   * \brief Find corresponding QTAB entry for the given content name
+   * \brief Find corresponding QTAB entry for the given content object
    *
-   * Not that this call should be repeated enough times until it return 0.
-   * This way all records with shorter or equal prefix as in content object will be found
-   * and satisfied.
+   * Lookup is an exact match on the content-level name (ContentObject::GetContentName),
+   * i.e., the name without the chunk component
    *
-   * \param prefix Prefix for which to lookup the entry
-   * \returns smart pointer to PIT entry. If record not found,
+   * \param header parsed content object header
+   * \returns smart pointer to QTAB entry. If record not found,
    *          returns 0
    */
   virtual Ptr<qtab::Entry>
   LookupQtab (const ContentObject &header) = 0;
 
   /**
-   * \brief Find a PIT entry for the given content interest
+   * \brief Find a QTAB entry for the given content interest
+   *
+   * Lookup is an exact match on the content-level name (Interest::GetContentName)
+   *
    * \param header parsed interest header
-   * \returns iterator to Pit entry. If record not found,
-   *          return end() iterator
+   * \returns smart pointer to QTAB entry. If record not found,
+   *          returns 0
    */
   virtual Ptr<qtab::Entry>
   LookupQtab (const Interest &header) = 0;
@@ -98,10 +100,10 @@ public:
   FindQtab (const Name &prefix) = 0;
 
   /**
-   * @brief Creates a PIT entry for the given interest
-   * @param header parsed interest header
-   * @returns iterator to Pit entry. If record could not be created (e.g., limit reached),
-   *          return end() iterator
+   * @brief Creates a QTAB entry for the content of the given interest
+   * @param header parsed interest header (entry is keyed by Interest::GetContentName)
+   * @returns smart pointer to QTAB entry. If record could not be created (e.g., limit reached),
+   *          returns 0
    *
    * Note. This call assumes that the entry does not exist (i.e., there was a Lookup call before)
    */
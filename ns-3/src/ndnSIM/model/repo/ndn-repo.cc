@@ -26,6 +26,7 @@
 #include "ns3/ndn-name.h"
 #include "ns3/ndn-interest.h"
 #include "ns3/ndn-content-object.h"
+#include "ns3/simulator.h"
 
 NS_LOG_COMPONENT_DEFINE ("ndn.rp.Repo");
 
@@ -56,6 +57,23 @@ Repo::~Repo ()
 {
 }
 
+bool
+Repo::AddContent (const Name &name, uint32_t payloadSize)
+{
+  static ContentObjectTail tail;
+
+  Ptr<ContentObject> header = Create<ContentObject> ();
+  header->SetName (name);
+  header->SetTimestamp (Simulator::Now ());
+  header->SetSignature (0);
+
+  Ptr<Packet> packet = Create<Packet> (payloadSize);
+  packet->AddHeader (*header);
+  packet->AddTrailer (tail);
+
+  return Add (header, packet);
+}
+
 namespace rp {
 
 //////////////////////////////////////////////////////////////////////
@@ -142,7 +142,8 @@ public:
    * \brief Find corresponding CS entry for the given interest
    *
    * \param interest Interest for which matching content store entry
-   * will be searched
+   * will be searched. Repository stores whole contents, so the lookup
+   * uses the content-level name of the interest (Interest::GetContentName)
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
@@ -161,6 +162,19 @@ public:
   virtual bool
   Add (Ptr<const ContentObject> header, Ptr<const Packet> packet) = 0;
 
+  /**
+   * \brief Add a content known only by its name (e.g., a seed copy read from the content catalog)
+   *
+   * The default implementation creates the ContentObject packet (payload, ContentObject header
+   * and trailer) and adds it with Add ()
+   *
+   * \param name Name of the content
+   * \param payloadSize Size of the payload
+   * @returns true if the content has been added
+   */
+  virtual bool
+  AddContent (const Name &name, uint32_t payloadSize);
+
   // /*
   //  * \brief Add a new content to the content store.
   //  *
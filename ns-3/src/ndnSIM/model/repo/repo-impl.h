@@ -162,7 +162,7 @@ RepoImpl<Policy>::Lookup (Ptr<const Interest> interest)
   NS_LOG_FUNCTION (this << interest->GetName ());
 
   /// @todo Change to search with predicate
-  typename super::const_iterator node = this->deepest_prefix_match (interest->GetName ());
+  typename super::const_iterator node = this->deepest_prefix_match (interest->GetContentName ());
 
   if (node != this->end ())
     {
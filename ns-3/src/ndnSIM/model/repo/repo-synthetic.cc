@@ -0,0 +1,293 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "repo-synthetic.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/ndn-name.h"
+#include "ns3/ndn-interest.h"
+#include "ns3/ndn-content-object.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+
+#include <boost/tuple/tuple.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.rp.Synthetic");
+
+namespace ns3 {
+namespace ndn {
+namespace rp {
+
+NS_OBJECT_ENSURE_REGISTERED (Synthetic);
+
+static void
+AppendU16 (std::string &buffer, uint16_t value)
+{
+  buffer.push_back (static_cast<char> (value & 0xff));
+  buffer.push_back (static_cast<char> (value >> 8));
+}
+
+static uint16_t
+ReadU16 (const std::string &buffer, uint32_t offset)
+{
+  return static_cast<uint8_t> (buffer[offset]) | (static_cast<uint8_t> (buffer[offset + 1]) << 8);
+}
+
+TypeId
+Synthetic::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ndn::rp::Synthetic")
+    .SetGroupName ("Ndn")
+    .SetParent<Repo> ()
+    .AddConstructor< Synthetic > ()
+    .AddAttribute ("MaxSize",
+                   "Set maximum number of entries in Repository. If 0, limit is not enforced",
+                   StringValue ("100"),
+                   MakeUintegerAccessor (&Synthetic::GetMaxSize,
+                                         &Synthetic::SetMaxSize),
+                   MakeUintegerChecker<uint32_t> ())
+    ;
+
+  return tid;
+}
+
+Synthetic::Synthetic ()
+  : m_maxSize (100)
+  , m_index (16, 0)
+{
+}
+
+Synthetic::~Synthetic ()
+{
+}
+
+bool
+Synthetic::IsEqual (const Content &content, const Name &name) const
+{
+  uint32_t offset = content.m_offset;
+  if (ReadU16 (m_names, offset) != name.size ())
+    return false;
+  offset += 2;
+
+  for (size_t i = 0; i < name.size (); i++)
+    {
+      uint16_t length = ReadU16 (m_names, offset);
+      offset += 2;
+      if (length != name.GetComponentSize (i) ||
+          m_names.compare (offset, length, name.GetComponentData (i), length) != 0)
+        return false;
+      offset += length;
+    }
+
+  return true;
+}
+
+Ptr<Name>
+Synthetic::GetName (const Content &content) const
+{
+  Ptr<Name> name = Create<Name> ();
+
+  uint32_t offset = content.m_offset;
+  uint16_t components = ReadU16 (m_names, offset);
+  offset += 2;
+  for (uint16_t i = 0; i < components; i++)
+    {
+      uint16_t length = ReadU16 (m_names, offset);
+      name->Add (m_names.substr (offset + 2, length));
+      offset += 2 + length;
+    }
+
+  return name;
+}
+
+int32_t
+Synthetic::Find (const Name &name, std::size_t hash) const
+{
+  uint32_t mask = m_index.size () - 1;
+  for (uint32_t bucket = hash & mask; m_index[bucket] != 0; bucket = (bucket + 1) & mask)
+    {
+      const Content &content = m_contents[m_index[bucket] - 1];
+      if (content.m_hash == hash && IsEqual (content, name))
+        return m_index[bucket] - 1;
+    }
+
+  return -1;
+}
+
+bool
+Synthetic::Insert (const Name &name, std::size_t hash, uint32_t size)
+{
+  if (m_maxSize != 0 && m_contents.size () >= m_maxSize)
+    return false;
+
+  if (Find (name, hash) >= 0)
+    return false;
+
+  // load factor is kept at most 1/2, so the probe sequences stay short
+  if (2 * (m_contents.size () + 1) > m_index.size ())
+    {
+      m_index.assign (2 * m_index.size (), 0);
+      uint32_t mask = m_index.size () - 1;
+      for (uint32_t i = 0; i < m_contents.size (); i++)
+        {
+          uint32_t bucket = m_contents[i].m_hash & mask;
+          while (m_index[bucket] != 0)
+            bucket = (bucket + 1) & mask;
+          m_index[bucket] = i + 1;
+        }
+    }
+
+  Content content;
+  content.m_hash = hash;
+  content.m_offset = m_names.size ();
+  content.m_size = size;
+
+  AppendU16 (m_names, name.size ());
+  for (size_t i = 0; i < name.size (); i++)
+    {
+      AppendU16 (m_names, name.GetComponentSize (i));
+      m_names.append (name.GetComponentData (i), name.GetComponentSize (i));
+    }
+
+  m_contents.push_back (content);
+
+  uint32_t mask = m_index.size () - 1;
+  uint32_t bucket = hash & mask;
+  while (m_index[bucket] != 0)
+    bucket = (bucket + 1) & mask;
+  m_index[bucket] = m_contents.size ();
+
+  return true;
+}
+
+Ptr<rp::Entry>
+Synthetic::CreateEntry (const Content &content)
+{
+  Ptr<ContentObject> header = Create<ContentObject> ();
+  header->SetName (GetName (content));
+  header->SetSignature (0);
+
+  return Create<Entry> (this, header, Create<Packet> (content.m_size));
+}
+
+boost::tuple<Ptr<Packet>, Ptr<const ContentObject>, Ptr<const Packet> >
+Synthetic::Lookup (Ptr<const Interest> interest)
+{
+  NS_LOG_FUNCTION (this << interest->GetName ());
+
+  int32_t content = Find (interest->GetContentName (), interest->GetContentKey ());
+  if (content < 0)
+    {
+      this->m_repoMissesTrace (interest);
+      return boost::tuple<Ptr<Packet>, Ptr<ContentObject>, Ptr<Packet> > (0, 0, 0);
+    }
+
+  static ContentObjectTail tail;
+
+  Ptr<ContentObject> header = Create<ContentObject> ();
+  header->SetName (Create<Name> (interest->GetContentName ()));
+  header->SetSignature (0);
+
+  Ptr<Packet> payload = Create<Packet> (m_contents[content].m_size);
+  Ptr<Packet> packet = payload->Copy ();
+  packet->AddHeader (*header);
+  packet->AddTrailer (tail);
+
+  this->m_repoHitsTrace (interest, header);
+  return boost::make_tuple (packet, header, payload);
+}
+
+bool
+Synthetic::Add (Ptr<const ContentObject> header, Ptr<const Packet> packet)
+{
+  NS_LOG_FUNCTION (this << header->GetName ());
+
+  return Insert (header->GetName (), hash_value (header->GetName ()), packet->GetSize ());
+}
+
+bool
+Synthetic::AddContent (const Name &name, uint32_t payloadSize)
+{
+  NS_LOG_FUNCTION (this << name);
+
+  // same size as the packet created by Repo::AddContent: payload, ContentObject header and trailer
+  static ContentObjectTail tail;
+  ContentObject header;
+  header.SetName (name);
+  header.SetSignature (0);
+
+  return Insert (name, hash_value (name), payloadSize + header.GetSerializedSize () + tail.GetSerializedSize ());
+}
+
+void
+Synthetic::Print (std::ostream &os) const
+{
+  for (std::vector<Content>::const_iterator content = m_contents.begin (); content != m_contents.end (); content++)
+    {
+      os << *GetName (*content) << std::endl;
+    }
+}
+
+uint32_t
+Synthetic::GetSize () const
+{
+  return m_contents.size ();
+}
+
+uint32_t
+Synthetic::GetMaxSize () const
+{
+  return m_maxSize;
+}
+
+void
+Synthetic::SetMaxSize (uint32_t maxSize)
+{
+  m_maxSize = maxSize;
+}
+
+Ptr<Entry>
+Synthetic::Begin ()
+{
+  if (m_contents.empty ())
+    return End ();
+
+  return CreateEntry (m_contents.front ());
+}
+
+Ptr<Entry>
+Synthetic::End ()
+{
+  return 0;
+}
+
+Ptr<Entry>
+Synthetic::Next (Ptr<Entry> from)
+{
+  if (from == 0) return 0;
+
+  int32_t content = Find (from->GetName (), hash_value (from->GetName ()));
+  if (content < 0 || content + 1 >= static_cast<int32_t> (m_contents.size ()))
+    return End ();
+
+  return CreateEntry (m_contents[content + 1]);
+}
+
+} // namespace rp
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,132 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDN_REPO_SYNTHETIC_H
+#define	NDN_REPO_SYNTHETIC_H
+
+#include "ns3/ndn-repo.h"
+
+#include <vector>
+#include <string>
+
+namespace ns3 {
+namespace ndn {
+namespace rp {
+
+/**
+ * \ingroup ndn
+ * \brief Repository that stores only the names of the contents and synthesizes Data packets on demand
+ *
+ * For every content only the name (components packed in a single buffer), its hash and the size of the
+ * payload are kept, in an open addressing hash table.  Packets are created when the content is requested,
+ * with the same size they would have in rp::Persistent (payload of the size given to Add or AddContent),
+ * so the simulated transmission times do not change, while the memory and the startup time do not
+ * depend on the payload.
+ *
+ * Only contents whose name is equal to the content-level name of the Interest are matched.
+ */
+class Synthetic : public Repo
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static
+  TypeId GetTypeId ();
+
+  /**
+   * @brief Default constructor
+   */
+  Synthetic ();
+
+  /**
+   * @brief Virtual destructor
+   */
+  virtual
+  ~Synthetic ();
+
+  virtual boost::tuple<Ptr<Packet>, Ptr<const ContentObject>, Ptr<const Packet> >
+  Lookup (Ptr<const Interest> interest);
+
+  /**
+   * \brief Add the content: only the name and the size of the packet are stored
+   */
+  virtual bool
+  Add (Ptr<const ContentObject> header, Ptr<const Packet> packet);
+
+  virtual bool
+  AddContent (const Name &name, uint32_t payloadSize);
+
+  virtual void
+  Print (std::ostream &os) const;
+
+  virtual uint32_t
+  GetSize () const;
+
+  virtual uint32_t
+  GetMaxSize () const;
+
+  virtual Ptr<rp::Entry>
+  Begin ();
+
+  virtual Ptr<rp::Entry>
+  End ();
+
+  virtual Ptr<rp::Entry>
+  Next (Ptr<rp::Entry>);
+
+private:
+  struct Content
+  {
+    std::size_t m_hash;  ///< @brief hash of the name
+    uint32_t m_offset;   ///< @brief offset of the name in m_names
+    uint32_t m_size;     ///< @brief size of the stored packet
+  };
+
+  bool
+  Insert (const Name &name, std::size_t hash, uint32_t size);
+
+  int32_t
+  Find (const Name &name, std::size_t hash) const;
+
+  bool
+  IsEqual (const Content &content, const Name &name) const;
+
+  Ptr<Name>
+  GetName (const Content &content) const;
+
+  Ptr<rp::Entry>
+  CreateEntry (const Content &content);
+
+  void
+  SetMaxSize (uint32_t maxSize);
+
+private:
+  uint32_t m_maxSize;                 ///< @brief maximum number of contents
+  std::vector<Content> m_contents;    ///< @brief contents, in the order they have been added
+  std::vector<uint32_t> m_index;      ///< @brief open addressing hash table: content index + 1, 0 if the bucket is empty
+  std::string m_names;                ///< @brief names: number of components, then length (2 bytes) and value of every component
+};
+
+} // namespace rp
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_REPO_SYNTHETIC_H
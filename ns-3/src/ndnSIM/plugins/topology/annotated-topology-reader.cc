@@ -45,6 +45,8 @@
 
 #include "ns3/constant-position-mobility-model.h"
 
+#include "topology-partitioner.h"
+
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
@@ -70,6 +72,7 @@ AnnotatedTopologyReader::AnnotatedTopologyReader (const std::string &path, doubl
   , m_randY (0, 100.0)
   , m_scale (scale)
   , m_requiredPartitions (1)
+  , m_partitions (1)
 {
   NS_LOG_FUNCTION (this);
 
@@ -92,6 +95,13 @@ AnnotatedTopologyReader::SetMobilityModel (const std::string &model)
   m_mobilityFactory.SetTypeId (model);
 }
 
+void
+AnnotatedTopologyReader::SetPartitions (uint32_t partitions)
+{
+  NS_LOG_FUNCTION (this << partitions);
+  m_partitions = partitions;
+}
+
 AnnotatedTopologyReader::~AnnotatedTopologyReader ()
 {
   NS_LOG_FUNCTION (this);
@@ -167,6 +177,8 @@ AnnotatedTopologyReader::Read (void)
       return m_nodes;
     }
 
+  // routers are created after the links are read, as their system ids may depend on the links
+  std::vector<string> routers;
   while (!topgen.eof ())
     {
       string line;
@@ -174,7 +186,31 @@ AnnotatedTopologyReader::Read (void)
       if (line[0] == '#') continue; // comments
       if (line=="link") break; // stop reading nodes
 
-      istringstream lineBuffer (line);
+      routers.push_back (line);
+    }
+
+  bool noLinks = topgen.eof ();
+
+  std::vector<string> links;
+  while (!topgen.eof ())
+    {
+      string line;
+      getline (topgen,line);
+      if (line == "") continue;
+      if (line[0] == '#') continue; // comments
+
+      links.push_back (line);
+    }
+
+  std::vector<uint32_t> systemIds;
+  if (m_partitions > 1)
+    {
+      systemIds = Partition (routers, links);
+    }
+
+  for (size_t i = 0; i < routers.size (); i++)
+    {
+      istringstream lineBuffer (routers[i]);
       string name, city;
       double latitude = 0, longitude = 0;
       uint32_t systemId = 0;
@@ -182,6 +218,9 @@ AnnotatedTopologyReader::Read (void)
       lineBuffer >> name >> city >> latitude >> longitude >> systemId;
       if (name.empty ()) continue;
 
+      if (m_partitions > 1)
+        systemId = systemIds[i];
+
       Ptr<Node> node;
 
       if (abs(latitude) > 0.001 && abs(latitude) > 0.001)
@@ -196,19 +235,16 @@ AnnotatedTopologyReader::Read (void)
 
   map<string, set<string> > processedLinks; // to eliminate duplications
 
-  if (topgen.eof ())
+  if (noLinks)
     {
       NS_LOG_ERROR ("Topology file " << GetFileName () << " does not have \"link\" section");
       return m_nodes;
     }
 
   // SeekToSection ("link");
-  while (!topgen.eof ())
+  for (size_t i = 0; i < links.size (); i++)
     {
-      string line;
-      getline (topgen,line);
-      if (line == "") continue;
-      if (line[0] == '#') continue; // comments
+      const string &line = links[i];
 
       // NS_LOG_DEBUG ("Input: [" << line << "]");
 
@@ -255,6 +291,48 @@ AnnotatedTopologyReader::Read (void)
   return m_nodes;
 }
 
+std::vector<uint32_t>
+AnnotatedTopologyReader::Partition (const std::vector<std::string> &routers, const std::vector<std::string> &links) const
+{
+  TopologyPartitioner partitioner;
+  map<string, uint32_t> indexes;
+  std::vector<uint32_t> routerIndexes (routers.size (), 0);
+
+  for (size_t i = 0; i < routers.size (); i++)
+    {
+      istringstream lineBuffer (routers[i]);
+      string name;
+      lineBuffer >> name;
+      if (name.empty ()) continue;
+
+      routerIndexes[i] = indexes[name] = partitioner.AddNode ();
+    }
+
+  set<pair<string, string> > processedLinks; // to eliminate duplications
+  for (size_t i = 0; i < links.size (); i++)
+    {
+      istringstream lineBuffer (links[i]);
+      string from, to, capacity, metric, delay;
+      lineBuffer >> from >> to >> capacity >> metric >> delay;
+
+      if (processedLinks.find (make_pair (to, from)) != processedLinks.end ())
+        continue;
+      processedLinks.insert (make_pair (from, to));
+
+      NS_ASSERT_MSG (indexes.find (from) != indexes.end (), from << " node not found");
+      NS_ASSERT_MSG (indexes.find (to) != indexes.end (), to << " node not found");
+      partitioner.AddLink (indexes[from], indexes[to], delay.empty () ? Time (0) : Time (delay));
+    }
+
+  const std::vector<uint32_t> &partitions = partitioner.Partition (m_partitions);
+  NS_LOG_INFO (m_partitions << " partitions with " << partitioner.GetCutLinks () << " cut links, lookahead " << partitioner.GetLookahead ());
+
+  std::vector<uint32_t> systemIds (routers.size (), 0);
+  for (size_t i = 0; i < routers.size (); i++)
+    systemIds[i] = partitions[routerIndexes[i]];
+  return systemIds;
+}
+
 void
 AnnotatedTopologyReader::AssignIpv4Addresses (Ipv4Address base)
 {
@@ -403,6 +481,13 @@ void
 AnnotatedTopologyReader::ApplySettings ()
 {
 #ifdef NS3_MPI
+  // links may connect nodes created outside of the reader (AddLink)
+  BOOST_FOREACH (Link &link, m_linksList)
+    {
+      m_requiredPartitions = std::max (m_requiredPartitions, link.GetFromNode ()->GetSystemId () + 1);
+      m_requiredPartitions = std::max (m_requiredPartitions, link.GetToNode ()->GetSystemId () + 1);
+    }
+
   if (MpiInterface::IsEnabled () &&
       MpiInterface::GetSize () != m_requiredPartitions)
     {
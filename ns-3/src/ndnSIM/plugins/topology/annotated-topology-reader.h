@@ -25,6 +25,8 @@
 #include "ns3/random-variable.h"
 #include "ns3/object-factory.h"
 
+#include <vector>
+
 namespace ns3 
 {
     
@@ -48,6 +50,18 @@ public:
 
 
   void ApplySettingsCall();
+
+  /**
+   * \brief Split the routers of the topology among the ranks of a distributed simulation
+   *
+   * If more than one partition is requested, system ids of the routers are not taken from the
+   * topology file but assigned by TopologyPartitioner (fewest cut links with the largest lookahead)
+   *
+   * \param partitions number of partitions (e.g., MpiInterface::GetSize ())
+   */
+  void
+  SetPartitions (uint32_t partitions);
+
   /**
    * \brief Main annotated topology reading function.
    *
@@ -134,6 +148,12 @@ protected:
    * NodeContainer from Read method
    */
   void ApplySettings ();
+
+  /**
+   * \brief Assign system ids to the routers (lines of the "router" section) using the links (lines of the "link" section)
+   */
+  std::vector<uint32_t>
+  Partition (const std::vector<std::string> &routers, const std::vector<std::string> &links) const;
     
 protected:
   std::string m_path;
@@ -150,6 +170,7 @@ private:
   double m_scale;
 
   uint32_t m_requiredPartitions;
+  uint32_t m_partitions;
 };
 
 }
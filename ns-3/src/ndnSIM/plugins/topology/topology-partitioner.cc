@@ -0,0 +1,398 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "topology-partitioner.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+
+#include <algorithm>
+#include <functional>
+
+NS_LOG_COMPONENT_DEFINE ("TopologyPartitioner");
+
+namespace ns3 {
+
+TopologyPartitioner::TopologyPartitioner ()
+  : m_lookahead (0)
+  , m_cutLinks (0)
+{
+}
+
+uint32_t
+TopologyPartitioner::AddNode (double weight/* = 1.0*/)
+{
+  m_weights.push_back (weight);
+  return m_weights.size () - 1;
+}
+
+void
+TopologyPartitioner::AddLink (uint32_t from, uint32_t to, const Time &delay)
+{
+  NS_ASSERT_MSG (from < m_weights.size () && to < m_weights.size (), "Unknown node");
+
+  Link link;
+  link.m_from = from;
+  link.m_to = to;
+  link.m_delay = delay.GetTimeStep ();
+  m_links.push_back (link);
+}
+
+uint32_t
+TopologyPartitioner::GetN () const
+{
+  return m_weights.size ();
+}
+
+Time
+TopologyPartitioner::GetLookahead () const
+{
+  return TimeStep (m_lookahead);
+}
+
+uint32_t
+TopologyPartitioner::GetCutLinks () const
+{
+  return m_cutLinks;
+}
+
+double
+TopologyPartitioner::GetWeight (uint32_t part) const
+{
+  NS_ASSERT (part < m_partWeights.size ());
+  return m_partWeights[part];
+}
+
+static uint32_t
+FindRoot (std::vector<uint32_t> &parents, uint32_t node)
+{
+  while (parents[node] != node)
+    {
+      parents[node] = parents[parents[node]];
+      node = parents[node];
+    }
+  return node;
+}
+
+uint32_t
+TopologyPartitioner::Contract (int64_t delay, std::vector<uint32_t> &groups) const
+{
+  std::vector<uint32_t> parents (m_weights.size ());
+  for (uint32_t node = 0; node < parents.size (); node++)
+    parents[node] = node;
+
+  for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+    {
+      if (link->m_delay < delay)
+        parents[FindRoot (parents, link->m_from)] = FindRoot (parents, link->m_to);
+    }
+
+  // groups are numbered in the order of their first node
+  std::vector<uint32_t> rootGroups (m_weights.size (), m_weights.size ());
+  uint32_t count = 0;
+  groups.resize (m_weights.size ());
+  for (uint32_t node = 0; node < m_weights.size (); node++)
+    {
+      uint32_t root = FindRoot (parents, node);
+      if (rootGroups[root] == m_weights.size ())
+        rootGroups[root] = count++;
+      groups[node] = rootGroups[root];
+    }
+  return count;
+}
+
+const std::vector<uint32_t> &
+TopologyPartitioner::Partition (uint32_t parts, double imbalance/* = 0.1*/)
+{
+  NS_ASSERT_MSG (parts > 0, "At least one partition is needed");
+  if (m_weights.size () < parts)
+    NS_FATAL_ERROR ("Cannot split " << m_weights.size () << " nodes in " << parts << " partitions");
+
+  double total = 0;
+  for (uint32_t node = 0; node < m_weights.size (); node++)
+    total += m_weights[node];
+  double maxWeight = (1 + imbalance) * total / parts;
+
+  m_partitions.assign (m_weights.size (), 0);
+  if (parts > 1)
+    {
+      // the largest lookahead still allowing balanced partitions (links shorter than it are never cut)
+      std::vector<int64_t> delays;
+      for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+        delays.push_back (link->m_delay);
+      std::sort (delays.begin (), delays.end (), std::greater<int64_t> ());
+      delays.erase (std::unique (delays.begin (), delays.end ()), delays.end ());
+      delays.push_back (0); // nothing contracted
+
+      std::vector<uint32_t> groups;
+      std::vector<double> weights;
+      for (std::vector<int64_t>::const_iterator delay = delays.begin (); delay != delays.end (); delay++)
+        {
+          uint32_t count = Contract (*delay, groups);
+
+          weights.assign (count, 0);
+          for (uint32_t node = 0; node < groups.size (); node++)
+            weights[groups[node]] += m_weights[node];
+
+          if (count >= parts && *std::max_element (weights.begin (), weights.end ()) <= maxWeight)
+            {
+              NS_LOG_DEBUG ("Links shorter than " << TimeStep (*delay) << " contracted, " << count << " groups");
+              break;
+            }
+        }
+
+      // a link for every link between groups (parallel links count more)
+      std::vector< std::vector<uint32_t> > neighbors (weights.size ());
+      for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+        {
+          uint32_t from = groups[link->m_from];
+          uint32_t to = groups[link->m_to];
+          if (from == to)
+            continue;
+          neighbors[from].push_back (to);
+          neighbors[to].push_back (from);
+        }
+
+      std::vector<uint32_t> assignment;
+      Split (parts, imbalance, weights, neighbors, assignment);
+
+      for (uint32_t node = 0; node < m_weights.size (); node++)
+        m_partitions[node] = assignment[groups[node]];
+    }
+
+  m_partWeights.assign (parts, 0);
+  for (uint32_t node = 0; node < m_weights.size (); node++)
+    m_partWeights[m_partitions[node]] += m_weights[node];
+
+  m_cutLinks = 0;
+  m_lookahead = 0;
+  for (std::vector<Link>::const_iterator link = m_links.begin (); link != m_links.end (); link++)
+    {
+      if (m_partitions[link->m_from] == m_partitions[link->m_to])
+        continue;
+
+      if (m_cutLinks == 0 || link->m_delay < m_lookahead)
+        m_lookahead = link->m_delay;
+      m_cutLinks++;
+    }
+
+  NS_LOG_INFO (m_weights.size () << " nodes in " << parts << " partitions, " << m_cutLinks << " links cut, lookahead " << GetLookahead ());
+  return m_partitions;
+}
+
+void
+TopologyPartitioner::Split (uint32_t parts, double imbalance,
+                            const std::vector<double> &weights,
+                            const std::vector< std::vector<uint32_t> > &neighbors,
+                            std::vector<uint32_t> &assignment) const
+{
+  uint32_t count = weights.size ();
+  assignment.assign (count, 0);
+  if (parts == 1)
+    return;
+
+  double total = 0;
+  for (uint32_t node = 0; node < count; node++)
+    total += weights[node];
+
+  // side 0 gets half of the partitions (rounded down) and side 1 the others
+  std::vector<uint32_t> sideParts (2);
+  sideParts[0] = parts / 2;
+  sideParts[1] = parts - sideParts[0];
+
+  std::vector<double> maxWeights (2);
+  for (uint32_t side = 0; side < 2; side++)
+    maxWeights[side] = (1 + imbalance) * total * sideParts[side] / parts;
+
+  std::vector<uint32_t> sides;
+  Grow (total * sideParts[0] / parts, maxWeights[0], sideParts, weights, neighbors, sides);
+  Refine (maxWeights, sideParts, weights, neighbors, sides);
+
+  for (uint32_t side = 0; side < 2; side++)
+    {
+      std::vector<uint32_t> members;
+      std::vector<uint32_t> indexes (count, count);
+      for (uint32_t node = 0; node < count; node++)
+        {
+          if (sides[node] != side)
+            continue;
+          indexes[node] = members.size ();
+          members.push_back (node);
+        }
+
+      std::vector<double> sideWeights (members.size ());
+      std::vector< std::vector<uint32_t> > sideNeighbors (members.size ());
+      for (uint32_t member = 0; member < members.size (); member++)
+        {
+          sideWeights[member] = weights[members[member]];
+          for (std::vector<uint32_t>::const_iterator neighbor = neighbors[members[member]].begin ();
+               neighbor != neighbors[members[member]].end ();
+               neighbor++)
+            {
+              if (sides[*neighbor] == side)
+                sideNeighbors[member].push_back (indexes[*neighbor]);
+            }
+        }
+
+      std::vector<uint32_t> sideAssignment;
+      Split (sideParts[side], imbalance, sideWeights, sideNeighbors, sideAssignment);
+      for (uint32_t member = 0; member < members.size (); member++)
+        assignment[members[member]] = side * sideParts[0] + sideAssignment[member];
+    }
+
+  // imbalance allowed at every level of the bisection adds up: fix it (and cut links) on all partitions
+  maxWeights.assign (parts, (1 + imbalance) * total / parts);
+  Refine (maxWeights, std::vector<uint32_t> (parts, 1), weights, neighbors, assignment);
+}
+
+void
+TopologyPartitioner::Grow (double target, double maxWeight, const std::vector<uint32_t> &minSizes,
+                           const std::vector<double> &weights,
+                           const std::vector< std::vector<uint32_t> > &neighbors,
+                           std::vector<uint32_t> &assignment) const
+{
+  uint32_t count = weights.size ();
+  assignment.assign (count, 1);
+
+  std::vector<uint32_t> freeLinks (count); // links to nodes still on side 1
+  std::vector<uint32_t> links (count, 0);  // links to side 0
+  for (uint32_t node = 0; node < count; node++)
+    freeLinks[node] = neighbors[node].size ();
+
+  double weight = 0;
+  uint32_t size = 0;
+  while ((weight < target || size < minSizes[0]) && count - size > minSizes[1])
+    {
+      // the frontier node most connected to side 0 and least to side 1, otherwise
+      // (first node, or disconnected graph) a new seed at the periphery of side 1
+      uint32_t best = count;
+      bool frontier = false;
+      for (uint32_t node = 0; node < count; node++)
+        {
+          if (assignment[node] != 1 ||
+              (size >= minSizes[0] && size > 0 && weight + weights[node] > maxWeight))
+            continue;
+
+          if (links[node] > 0)
+            {
+              if (!frontier ||
+                  static_cast<int64_t> (links[node]) - freeLinks[node] > static_cast<int64_t> (links[best]) - freeLinks[best])
+                best = node;
+              frontier = true;
+            }
+          else if (!frontier && (best == count || freeLinks[node] < freeLinks[best]))
+            best = node;
+        }
+
+      if (best == count)
+        break;
+
+      assignment[best] = 0;
+      weight += weights[best];
+      size++;
+      for (std::vector<uint32_t>::const_iterator neighbor = neighbors[best].begin ();
+           neighbor != neighbors[best].end ();
+           neighbor++)
+        {
+          freeLinks[*neighbor]--;
+          links[*neighbor]++;
+        }
+    }
+}
+
+void
+TopologyPartitioner::Refine (const std::vector<double> &maxWeights, const std::vector<uint32_t> &minSizes,
+                             const std::vector<double> &weights,
+                             const std::vector< std::vector<uint32_t> > &neighbors,
+                             std::vector<uint32_t> &assignment) const
+{
+  uint32_t parts = maxWeights.size ();
+  std::vector<double> partWeights (parts, 0);
+  std::vector<uint32_t> partSizes (parts, 0);
+  for (uint32_t node = 0; node < weights.size (); node++)
+    {
+      partWeights[assignment[node]] += weights[node];
+      partSizes[assignment[node]]++;
+    }
+
+  // a node is moved if it cuts fewer links in the other partition, or as many but the partitions get
+  // more balanced (overweight partitions give nodes away at any cost)
+  const uint32_t maxPasses = 20;
+  bool moved = true;
+  for (uint32_t pass = 0; moved && pass < maxPasses; pass++)
+    {
+      moved = false;
+      std::vector<int64_t> links (parts);
+      for (uint32_t node = 0; node < weights.size (); node++)
+        {
+          uint32_t from = assignment[node];
+          if (partSizes[from] <= minSizes[from])
+            continue;
+
+          std::fill (links.begin (), links.end (), 0);
+          for (std::vector<uint32_t>::const_iterator neighbor = neighbors[node].begin ();
+               neighbor != neighbors[node].end ();
+               neighbor++)
+            {
+              links[assignment[*neighbor]]++;
+            }
+
+          bool overweight = partWeights[from] > maxWeights[from];
+          uint32_t best = parts;
+          int64_t bestGain = 0;
+          for (uint32_t to = 0; to < parts; to++)
+            {
+              if (to == from || partWeights[to] + weights[node] > maxWeights[to])
+                continue;
+              if (!overweight && links[to] == 0)
+                continue;
+
+              // balance is compared relative to the maximum weight (sides of a bisection may differ)
+              int64_t gain = links[to] - links[from];
+              if (best == parts)
+                {
+                  if (overweight || gain > 0 ||
+                      (gain == 0 && (partWeights[to] + weights[node]) / maxWeights[to] < partWeights[from] / maxWeights[from]))
+                    {
+                      best = to;
+                      bestGain = gain;
+                    }
+                }
+              else if (gain > bestGain ||
+                       (gain == bestGain && partWeights[to] / maxWeights[to] < partWeights[best] / maxWeights[best]))
+                {
+                  best = to;
+                  bestGain = gain;
+                }
+            }
+
+          if (best == parts)
+            continue;
+
+          assignment[node] = best;
+          partWeights[from] -= weights[node];
+          partWeights[best] += weights[node];
+          partSizes[from]--;
+          partSizes[best]++;
+          moved = true;
+        }
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,143 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TOPOLOGY_PARTITIONER_H
+#define TOPOLOGY_PARTITIONER_H
+
+#include "ns3/nstime.h"
+
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Splits a topology among the ranks (system ids) of a distributed simulation
+ *
+ * Ranks of ns3::DistributedSimulatorImpl run independently for a window as long as the
+ * smallest delay of the links crossing two ranks (the lookahead), so the partitioner first
+ * looks for the largest link delay below which no link has to be cut while keeping the
+ * partitions balanced: links shorter than it are contracted.  The contracted graph is then
+ * split by recursive bisection (greedy graph growing) and refined by moving boundary nodes to
+ * minimize the number of cut links, which are the links carrying MPI messages.
+ */
+class TopologyPartitioner
+{
+public:
+  TopologyPartitioner ();
+
+  /**
+   * \brief Add a node
+   * \param weight Load of the node (e.g., 1 for every node, or the number of attached applications)
+   * \return index of the node, in the order nodes are added
+   */
+  uint32_t
+  AddNode (double weight = 1.0);
+
+  /**
+   * \brief Add a (bidirectional) link between two nodes
+   */
+  void
+  AddLink (uint32_t from, uint32_t to, const Time &delay);
+
+  /**
+   * \brief Get number of nodes
+   */
+  uint32_t
+  GetN () const;
+
+  /**
+   * \brief Assign nodes to partitions
+   * \param parts Number of partitions (MPI ranks)
+   * \param imbalance Maximum weight of a partition above the average (0.1 = 10%)
+   * \return partition (system id) of every node, in the order nodes were added
+   */
+  const std::vector<uint32_t> &
+  Partition (uint32_t parts, double imbalance = 0.1);
+
+  /**
+   * \brief Get the smallest delay of the links cut by the last Partition call (zero if no link is cut)
+   */
+  Time
+  GetLookahead () const;
+
+  /**
+   * \brief Get number of links cut by the last Partition call
+   */
+  uint32_t
+  GetCutLinks () const;
+
+  /**
+   * \brief Get total weight of the nodes assigned to the partition by the last Partition call
+   */
+  double
+  GetWeight (uint32_t part) const;
+
+private:
+  struct Link
+  {
+    uint32_t m_from;
+    uint32_t m_to;
+    int64_t m_delay;
+  };
+
+  /**
+   * \brief Contract links shorter than delay, returning the group of every node
+   */
+  uint32_t
+  Contract (int64_t delay, std::vector<uint32_t> &groups) const;
+
+  /**
+   * \brief Split a (contracted) graph by recursive bisection, then refine the partitions
+   */
+  void
+  Split (uint32_t parts, double imbalance,
+         const std::vector<double> &weights,
+         const std::vector< std::vector<uint32_t> > &neighbors,
+         std::vector<uint32_t> &assignment) const;
+
+  /**
+   * \brief Grow side 0 of a bisection from a peripheral node, up to the target weight
+   */
+  void
+  Grow (double target, double maxWeight, const std::vector<uint32_t> &minSizes,
+        const std::vector<double> &weights,
+        const std::vector< std::vector<uint32_t> > &neighbors,
+        std::vector<uint32_t> &assignment) const;
+
+  /**
+   * \brief Move boundary nodes to the partitions where they cut fewer links
+   */
+  void
+  Refine (const std::vector<double> &maxWeights, const std::vector<uint32_t> &minSizes,
+          const std::vector<double> &weights,
+          const std::vector< std::vector<uint32_t> > &neighbors,
+          std::vector<uint32_t> &assignment) const;
+
+private:
+  std::vector<double> m_weights;
+  std::vector<Link> m_links;
+
+  std::vector<uint32_t> m_partitions;
+  std::vector<double> m_partWeights;
+  int64_t m_lookahead;
+  uint32_t m_cutLinks;
+};
+
+} // namespace ns3
+
+#endif // TOPOLOGY_PARTITIONER_H
@@ -0,0 +1,105 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-binary-trace.h"
+
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace-writer.h"
+#include "ns3/simulator.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace ns3
+{
+
+typedef ndn::BinaryTraceWriter Writer;
+
+static void
+WriteInterestRecord (Ptr<Writer> writer, uint32_t i)
+{
+  writer->OnInterestApp (0, i, "EXIT_CLIENT", "APP");
+}
+
+static void
+WriteDownloadRecord (Ptr<Writer> writer, uint32_t i)
+{
+  writer->OnDownloadTime (0, i, 2 * i, i % 7, "DOWNLOAD_TIME", "APP");
+}
+
+void
+BinaryTraceTest::DoRun ()
+{
+  std::string path = CreateTempDirFilename ("binary-trace.bin");
+  {
+    // small buffer, so records are written in several chunks
+    Ptr<Writer> writer = Create<Writer> (path, false, 4096);
+    for (uint32_t i = 0; i < 200; i ++)
+      {
+        Simulator::Schedule (MicroSeconds (10 * i), &WriteInterestRecord, writer, i);
+        Simulator::Schedule (MicroSeconds (10 * i + 5), &WriteDownloadRecord, writer, i);
+      }
+    Simulator::Run ();
+    Simulator::Destroy ();
+    writer->Close ();
+  }
+
+  FILE *file = fopen (path.c_str (), "rb");
+  NS_TEST_ASSERT_MSG_NE (file, 0, "Trace file should exist");
+
+  char magic[sizeof (Writer::MAGIC)];
+  NS_TEST_ASSERT_MSG_EQ (fread (magic, 1, sizeof (magic), file), sizeof (magic), "File should start with the magic");
+  NS_TEST_ASSERT_MSG_EQ (memcmp (magic, Writer::MAGIC, sizeof (magic)), 0, "File should start with the magic");
+
+  std::vector<std::string> events (256);
+  uint32_t interests = 0;
+  uint32_t downloads = 0;
+  Writer::Record record;
+  while (fread (&record, sizeof (record), 1, file) == 1)
+    {
+      if (record.type == Writer::EVENT_NAME)
+        {
+          events[record.event].resize (record.value);
+          NS_TEST_ASSERT_MSG_EQ (fread (&events[record.event][0], 1, record.value, file), record.value, "Event name should follow its record");
+        }
+      else if (record.type == Writer::INTEREST_APP)
+        {
+          NS_TEST_ASSERT_MSG_EQ (events[record.event], "EXIT_CLIENT", "Wrong event name");
+          NS_TEST_ASSERT_MSG_EQ (record.time, 10 * interests, "Wrong time");
+          NS_TEST_ASSERT_MSG_EQ (record.timeSent, interests, "Wrong time sent");
+          interests ++;
+        }
+      else if (record.type == Writer::DOWNLOAD_TIME)
+        {
+          NS_TEST_ASSERT_MSG_EQ (events[record.event], "DOWNLOAD_TIME", "Wrong event name");
+          NS_TEST_ASSERT_MSG_EQ (record.time, 10 * downloads + 5, "Wrong time");
+          NS_TEST_ASSERT_MSG_EQ (record.downloadTime, 2 * downloads, "Wrong download time");
+          NS_TEST_ASSERT_MSG_EQ (record.value, downloads % 7, "Wrong distance");
+          downloads ++;
+        }
+      else
+        NS_TEST_ASSERT_MSG_EQ (static_cast<uint32_t> (record.type), 0, "Unexpected record type");
+    }
+  fclose (file);
+
+  NS_TEST_ASSERT_MSG_EQ (interests, 200, "All interest records should be read back");
+  NS_TEST_ASSERT_MSG_EQ (downloads, 200, "All download records should be read back");
+
+  std::remove (path.c_str ());
+}
+
+}
@@ -0,0 +1,417 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-bloom-filter.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/bloom-filter/ndn-bloom-filter-simple.h"
+#include "ns3/ndnSIM/model/bloom-filter/ndn-bloom-filter-stable.h"
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cstdlib>
+
+namespace ns3
+{
+
+namespace
+{
+
+/**
+ * Counters stored as the filters used to store them: one bitset per interface, with the bits
+ * of a cell walked from lsb to msb
+ */
+class BitsetFilters
+{
+public:
+  BitsetFilters (uint64_t cells, uint32_t cellWidth, uint32_t interfaces)
+    : m_cellWidth (cellWidth)
+    , m_filters (interfaces, boost::dynamic_bitset<> (cells * cellWidth))
+  {
+  }
+
+  bool
+  Increment (std::size_t cell, std::size_t interface)
+  {
+    boost::dynamic_bitset<> &filter = m_filters[interface];
+    for (std::size_t i = Lsb (cell, interface); i <= Msb (cell, interface); i++)
+      {
+        if (!filter[i])
+          {
+            filter[i] = true;
+            while (i && i > Lsb (cell, interface))
+              filter[--i] = false;
+            return true;
+          }
+      }
+    return false;
+  }
+
+  bool
+  Decrement (std::size_t cell, std::size_t interface)
+  {
+    boost::dynamic_bitset<> &filter = m_filters[interface];
+    for (std::size_t i = Lsb (cell, interface); i <= Msb (cell, interface); i++)
+      {
+        if (filter[i])
+          {
+            filter[i] = false;
+            while (i && i > Lsb (cell, interface))
+              filter[--i] = true;
+            return true;
+          }
+      }
+    return false;
+  }
+
+  void
+  SetMax (std::size_t cell, std::size_t interface)
+  {
+    for (std::size_t i = Lsb (cell, interface); i <= Msb (cell, interface); i++)
+      m_filters[interface][i] = true;
+  }
+
+  void
+  SetZero (std::size_t cell, std::size_t interface)
+  {
+    for (std::size_t i = Lsb (cell, interface); i <= Msb (cell, interface); i++)
+      m_filters[interface][i] = false;
+  }
+
+  uint32_t
+  Count (std::size_t cell, std::size_t interface) const
+  {
+    uint32_t counter = 0;
+    uint32_t numPos = 0;
+    for (std::size_t i = Lsb (cell, interface); i <= Msb (cell, interface); i++)
+      {
+        if (m_filters[interface][i])
+          {
+            counter = counter + std::pow (2, numPos);
+            numPos++;
+          }
+      }
+    return counter;
+  }
+
+  void
+  Clear (std::size_t interface) { m_filters[interface].reset (); }
+
+  void
+  Fill (std::size_t interface) { m_filters[interface].set (); }
+
+  uint32_t
+  GetNInterfaces () const { return m_filters.size (); }
+
+private:
+  std::size_t
+  Msb (std::size_t cell, std::size_t interface) const
+  {
+    return m_filters[interface].size () - (cell * m_cellWidth) - 1;
+  }
+
+  std::size_t
+  Lsb (std::size_t cell, std::size_t interface) const
+  {
+    return Msb (cell, interface) - (m_cellWidth - 1);
+  }
+
+  uint32_t m_cellWidth;
+  std::vector<boost::dynamic_bitset<> > m_filters;
+};
+
+/**
+ * Filter with a custom initialization that does not need a node
+ */
+template<class Filter>
+class TestFilter : public Filter
+{
+public:
+  TestFilter (uint32_t cellWidth, uint32_t interfaces, uint64_t cells, uint32_t hashes)
+  {
+    this->randomSeed = 0xA5A5A5A5 + 1;
+    this->bfParam = new ndn::BloomFilterBase::bfParameters (0, 0, 0, 0, 0, 0, 0.0, 0);
+    this->InitBloomFilterCustom (1000, 0.01, cellWidth, interfaces, cells * cellWidth, hashes);
+  }
+
+  using Filter::InsertFootprint;
+
+  uint64_t
+  GetNCells () const { return this->bfParam->bfRawLengthBit; }
+
+  std::vector<std::size_t>
+  Indices (const std::string &key) const
+  {
+    ndn::BloomFilterBase::PrefixHash hash = this->HashKey (reinterpret_cast<const unsigned char*> (key.c_str ()), key.size ());
+
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < this->bfParam->bfNumHashFunctions; ++i)
+      indices.push_back (this->GetFilterIndex (hash, i));
+    return indices;
+  }
+
+  /**
+   * Check that the prefix hashes of the name are the hashes of its prefixes, hashed one by one
+   */
+  bool
+  CheckPrefixHashes (const std::string &name) const
+  {
+    ndn::Name full (name);
+    std::vector<ndn::BloomFilterBase::PrefixHash> prefixes;
+    ndn::BloomFilterBase::PrefixHash hash = this->HashKey (full, &prefixes);
+    if (prefixes.size () != full.size () + 1 || hash.h1 != prefixes.back ().h1 || hash.h2 != prefixes.back ().h2)
+      return false;
+
+    ndn::Name prefix;
+    ndn::Name::const_iterator component = full.begin ();
+    for (uint32_t t = 0; t < prefixes.size (); t++)
+      {
+        if (t > 0)
+          prefix.Add (*component++);
+
+        std::string key = boost::lexical_cast<std::string> (prefix);
+        ndn::BloomFilterBase::PrefixHash expected = this->HashKey (reinterpret_cast<const unsigned char*> (key.c_str ()), key.size ());
+        if (prefixes[t].h1 != expected.h1 || prefixes[t].h2 != expected.h2)
+          return false;
+      }
+    return true;
+  }
+};
+
+void
+Insert (TestFilter<ndn::BloomFilterSimple> &filter, BitsetFilters &reference, const std::string &key, uint32_t interface)
+{
+  filter.InsertFootprint (key, interface);
+
+  std::vector<std::size_t> indices = filter.Indices (key);
+  for (std::size_t i = 0; i < indices.size (); i++)
+    reference.Increment (indices[i], interface);
+}
+
+void
+Insert (TestFilter<ndn::BloomFilterStable> &filter, BitsetFilters &reference, const std::string &key, uint32_t interface)
+{
+  // cells decremented by the stable filter are drawn with rand ()
+  uint32_t seed = std::rand ();
+  std::srand (seed);
+  filter.InsertFootprint (key, interface);
+
+  std::srand (seed);
+  for (std::size_t i = 0; i < filter.bfStableP; i++)
+    reference.Decrement (std::rand () % filter.GetNCells (), interface);
+
+  std::vector<std::size_t> indices = filter.Indices (key);
+  for (std::size_t i = 0; i < indices.size (); i++)
+    reference.SetMax (indices[i], interface);
+}
+
+std::string
+RandomName (uint32_t components)
+{
+  static const char *values[] = { "a", "b", "c", "d" };
+
+  std::string name;
+  for (uint32_t i = 0; i < components; i++)
+    name += std::string ("/") + values[std::rand () % 4];
+  return name;
+}
+
+/**
+ * Order of the interfaces of MakeCustomLookupBloomFilters, computed on the bitset counters
+ */
+template<class Filter>
+std::vector<std::vector<uint32_t> >
+ReferenceLookup (const TestFilter<Filter> &filter, const BitsetFilters &reference, const ndn::Name &name, uint32_t incoming, bool evict)
+{
+  uint32_t interfaces = reference.GetNInterfaces ();
+  std::vector<std::vector<uint32_t> > ordered (interfaces, std::vector<uint32_t> (2, 0));
+  std::vector<bool> inserted (interfaces, false);
+  if (evict)
+    inserted[incoming] = true;
+
+  uint32_t position = 0;
+  uint32_t last = evict ? interfaces - 1 : interfaces;
+  uint32_t metric = 1;
+
+  std::vector<std::string> components (name.GetComponents ().begin (), name.GetComponents ().end ());
+  for (uint32_t length = components.size (); length > 0 && position < last; length--)
+    {
+      std::string prefix;
+      for (uint32_t i = 0; i < length; i++)
+        prefix += "/" + components[i];
+      std::vector<std::size_t> indices = filter.Indices (prefix);
+
+      std::vector<uint32_t> counters (interfaces, 0);
+      for (uint32_t j = 0; j < interfaces; j++)
+        {
+          if (inserted[j])
+            continue;
+          for (std::size_t i = 0; i < indices.size (); i++)
+            {
+              uint32_t counter = reference.Count (indices[i], j);
+              if (counter == 0)
+                {
+                  counters[j] = 0;
+                  break;
+                }
+              counters[j] += counter;
+            }
+        }
+
+      // highest counter first, lowest interface on ties
+      for (;;)
+        {
+          std::vector<uint32_t>::iterator best = std::max_element (counters.begin (), counters.end ());
+          if (*best == 0)
+            break;
+          uint32_t j = best - counters.begin ();
+          ordered[position][0] = j;
+          ordered[position][1] = metric;
+          position++;
+          inserted[j] = true;
+          *best = 0;
+        }
+      metric++;
+    }
+
+  for (uint32_t j = 0; j < interfaces; j++)
+    {
+      if (!inserted[j])
+        {
+          ordered[position][0] = j;
+          ordered[position][1] = metric;
+          position++;
+        }
+    }
+  if (evict)
+    {
+      ordered[position][0] = incoming;
+      ordered[position][1] = 1000;
+    }
+  return ordered;
+}
+
+}
+
+template<class Filter>
+void
+BloomFilterTest::CheckFilter (uint32_t cellWidth, uint32_t interfaces)
+{
+  std::srand (cellWidth * 100 + interfaces);
+
+  Ptr<TestFilter<Filter> > filter = CreateObject<TestFilter<Filter> > (cellWidth, interfaces, 128, 3);
+  uint64_t cells = filter->GetNCells ();
+  BitsetFilters reference (cells, cellWidth, interfaces);
+
+  // counter operations
+  for (uint32_t op = 0; op < 5000; op++)
+    {
+      std::size_t cell = std::rand () % cells;
+      std::size_t interface = std::rand () % interfaces;
+      switch (std::rand () % 8)
+        {
+        case 0:
+          filter->SetMaxFilterCell (cell, interface);
+          reference.SetMax (cell, interface);
+          break;
+        case 1:
+          filter->SetZeroFilterCell (cell, interface);
+          reference.SetZero (cell, interface);
+          break;
+        case 2:
+        case 3:
+        case 4:
+          NS_TEST_ASSERT_MSG_EQ (filter->DecrementFilterCell (cell, interface), reference.Decrement (cell, interface),
+                                 "Decrement of cell " << cell << " should have the same outcome");
+          break;
+        default:
+          NS_TEST_ASSERT_MSG_EQ (filter->IncrementFilterCell (cell, interface), reference.Increment (cell, interface),
+                                 "Increment of cell " << cell << " should have the same outcome");
+          break;
+        }
+    }
+  for (uint32_t interface = 0; interface < interfaces; interface++)
+    for (uint64_t cell = 0; cell < cells; cell++)
+      NS_TEST_ASSERT_MSG_EQ (filter->CountCell (cell, interface), reference.Count (cell, interface),
+                             "Counter of cell " << cell << ", interface " << interface << " after counter operations");
+
+  for (uint32_t interface = 0; interface < interfaces; interface++)
+    {
+      filter->ClearFilter (interface);
+      reference.Clear (interface);
+    }
+  filter->SetFilter (interfaces - 1);
+  reference.Fill (interfaces - 1);
+  filter->ClearFilter (interfaces - 1);
+  reference.Clear (interfaces - 1);
+
+  // footprints
+  for (uint32_t interface = 0; interface < interfaces; interface++)
+    for (uint32_t i = 0; i < 40; i++)
+      Insert (*filter, reference, RandomName (1 + std::rand () % 3), interface);
+
+  for (uint32_t interface = 0; interface < interfaces; interface++)
+    for (uint64_t cell = 0; cell < cells; cell++)
+      NS_TEST_ASSERT_MSG_EQ (filter->CountCell (cell, interface), reference.Count (cell, interface),
+                             "Counter of cell " << cell << ", interface " << interface << " after insertions");
+
+  // prefix hashes
+  NS_TEST_ASSERT_MSG_EQ (filter->CheckPrefixHashes ("/"), true, "Empty name");
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      std::string name = RandomName (1 + i % 5);
+      NS_TEST_ASSERT_MSG_EQ (filter->CheckPrefixHashes (name), true, "Prefix hashes of " << name);
+    }
+
+  // lookups
+  for (uint32_t i = 0; i < 50; i++)
+    {
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (Create<ndn::Name> (RandomName (1 + i % 4)));
+      std::string key = boost::lexical_cast<std::string> (interest->GetName ());
+
+      for (uint32_t incoming = 0; incoming < interfaces; incoming++)
+        for (uint32_t evict = 0; evict < 2; evict++)
+          {
+            std::vector<std::vector<uint32_t> > *ordered =
+              filter->MakeCustomLookupBloomFilters (key, interest, incoming, interfaces, evict);
+            std::vector<std::vector<uint32_t> > expected =
+              ReferenceLookup (*filter, reference, interest->GetName (), incoming, evict);
+
+            NS_TEST_ASSERT_MSG_EQ ((*ordered == expected), true,
+                                   "Ordered interfaces for " << key << " (incoming " << incoming << ", evict " << evict << ")");
+            delete ordered;
+          }
+    }
+}
+
+void
+BloomFilterTest::DoRun ()
+{
+  // cells of all interfaces in one or two words, and more than 64 bits (read interface by interface)
+  CheckFilter<ndn::BloomFilterSimple> (1, 5);
+  CheckFilter<ndn::BloomFilterSimple> (3, 7);
+  CheckFilter<ndn::BloomFilterSimple> (5, 13);
+  CheckFilter<ndn::BloomFilterStable> (4, 3);
+  CheckFilter<ndn::BloomFilterStable> (3, 10);
+  CheckFilter<ndn::BloomFilterStable> (8, 10);
+}
+
+}
@@ -0,0 +1,119 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-cs-s3fifo.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/cs/content-store-s3fifo.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3
+{
+
+static bool
+Add (Ptr<ndn::ContentStore> cs, const std::string &name, uint32_t size = 100)
+{
+  Ptr<ndn::ContentObject> header = Create<ndn::ContentObject> ();
+  header->SetName (Create<ndn::Name> (name));
+  return cs->Add (header, Create<Packet> (size));
+}
+
+static bool
+IsCached (Ptr<ndn::ContentStore> cs, const std::string &name)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (name));
+  return cs->Lookup (interest).get<1> () != 0;
+}
+
+static Ptr<ndn::cs::S3Fifo>
+CreateStore (uint32_t maxSize, uint64_t maxBytes = 0)
+{
+  Ptr<ndn::cs::S3Fifo> cs = CreateObject<ndn::cs::S3Fifo> ();
+  cs->SetAttribute ("MaxSize", UintegerValue (maxSize));
+  cs->SetAttribute ("MaxBytes", UintegerValue (maxBytes));
+  return cs;
+}
+
+void
+CsS3FifoTest::DoRun ()
+{
+  Ptr<ndn::cs::S3Fifo> cs = CreateStore (10);
+  for (uint32_t i = 1; i <= 10; i++)
+    NS_TEST_ASSERT_MSG_EQ (Add (cs, "/a/" + boost::lexical_cast<std::string> (i)), true, "Content should be added");
+  NS_TEST_ASSERT_MSG_EQ (Add (cs, "/a/1"), false, "Content should not be added twice");
+  NS_TEST_ASSERT_MSG_EQ (cs->GetSize (), 10, "Wrong number of entries");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/a/3"), true, "Content should be cached");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/a"), false, "Only equal names should match");
+
+  // popular contents survive a scan of one-shot contents
+  for (uint32_t i = 1; i <= 5; i++)
+    IsCached (cs, "/a/" + boost::lexical_cast<std::string> (i));
+  for (uint32_t i = 0; i < 100; i++)
+    Add (cs, "/scan/" + boost::lexical_cast<std::string> (i));
+  NS_TEST_ASSERT_MSG_EQ (cs->GetSize (), 10, "Wrong number of entries");
+  for (uint32_t i = 1; i <= 5; i++)
+    NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/a/" + boost::lexical_cast<std::string> (i)), true, "Popular content should be cached");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/a/6"), false, "Content should have been evicted");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/scan/99"), true, "Last content should be cached");
+
+  // content evicted from the small queue and requested again goes to the main queue
+  cs = CreateStore (4);
+  for (uint32_t i = 1; i <= 5; i++)
+    Add (cs, "/g/" + boost::lexical_cast<std::string> (i));
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/g/1"), false, "Oldest content should have been evicted");
+  Add (cs, "/g/1");
+  Add (cs, "/g/6");
+  Add (cs, "/g/7");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/g/1"), true, "Content remembered by the ghost queue should be kept");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/g/2"), false, "Content of the small queue should have been evicted");
+
+  // byte capacity
+  cs = CreateStore (0, 2500);
+  Add (cs, "/b/1", 1000);
+  Add (cs, "/b/2", 1000);
+  Add (cs, "/b/3", 1000);
+  NS_TEST_ASSERT_MSG_EQ (cs->GetSize (), 2, "Only two contents should fit");
+  NS_TEST_ASSERT_MSG_LT (cs->GetBytes (), 2501, "Byte limit should be enforced");
+  NS_TEST_ASSERT_MSG_EQ (Add (cs, "/b/4", 3000), false, "Content larger than the cache should not be added");
+  NS_TEST_ASSERT_MSG_EQ (IsCached (cs, "/b/3"), true, "Last content should be cached");
+
+  // index stays consistent with many insertions and evictions
+  cs = CreateStore (1000);
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  for (uint32_t i = 0; i < 20000; i++)
+    Add (cs, "/r/" + boost::lexical_cast<std::string> (rand->GetInteger (0, 3000)), 10);
+  NS_TEST_ASSERT_MSG_EQ (cs->GetSize (), 1000, "Wrong number of entries");
+
+  uint32_t entries = 0;
+  uint64_t bytes = 0;
+  for (Ptr<ndn::cs::Entry> entry = cs->Begin (); entry != cs->End (); entry = cs->Next (entry))
+    {
+      std::ostringstream name;
+      name << entry->GetName ();
+      NS_TEST_ASSERT_MSG_EQ (IsCached (cs, name.str ()), true, "Entry should be found");
+      entries ++;
+      bytes += entry->GetPacket ()->GetSize () + entry->GetHeader ()->GetSerializedSize ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (entries, 1000, "Every entry should be iterated");
+  NS_TEST_ASSERT_MSG_EQ (cs->GetBytes (), bytes, "Wrong number of bytes");
+}
+
+}
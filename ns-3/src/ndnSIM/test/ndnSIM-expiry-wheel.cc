@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-expiry-wheel.h"
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-expiry-wheel.h"
+
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ExpiryWheelTest");
+
+namespace ns3
+{
+
+namespace
+{
+
+class TestItem : public ndn::ExpiryWheel::Item
+{
+public:
+  TestItem (const Time &expireTime)
+    : m_expireTime (expireTime)
+    , m_expired (false)
+  {
+  }
+
+  virtual const Time &
+  GetExpireTime () const { return m_expireTime; }
+
+  virtual void
+  Expire ()
+  {
+    m_expired = true;
+    m_expiredAt = Simulator::Now ();
+  }
+
+  void
+  SetExpireTime (Ptr<ndn::ExpiryWheel> wheel, Time expireTime)
+  {
+    m_expireTime = expireTime;
+    wheel->Update (*this);
+  }
+
+  Time m_expireTime;
+  bool m_expired;
+  Time m_expiredAt;
+};
+
+void
+DestroyItem (TestItem *item)
+{
+  delete item;
+}
+
+void
+ScheduleItem (Ptr<ndn::ExpiryWheel> wheel, TestItem *item)
+{
+  wheel->Schedule (*item);
+}
+
+}
+
+void
+ExpiryWheelTest::CheckEmpty (Ptr<ndn::ExpiryWheel> wheel)
+{
+  NS_TEST_ASSERT_MSG_EQ (wheel->GetSize (), 0, "All items should have expired");
+}
+
+void
+ExpiryWheelTest::DoRun ()
+{
+  Ptr<ndn::ExpiryWheel> wheel = CreateObject<ndn::ExpiryWheel> ();
+  wheel->SetAttribute ("Tick", StringValue ("10ms"));
+  Time tick = wheel->GetTick ();
+
+  // expire times within each level of the wheel, beyond the wheel, and not aligned to ticks
+  std::vector<TestItem*> items;
+  items.push_back (new TestItem (MilliSeconds (5)));
+  items.push_back (new TestItem (MilliSeconds (2555)));
+  items.push_back (new TestItem (Seconds (30)));
+  items.push_back (new TestItem (Seconds (200)));
+  items.push_back (new TestItem (Seconds (20000)));
+  for (std::vector<TestItem*>::iterator item = items.begin (); item != items.end (); item++)
+    wheel->Schedule (**item);
+
+  // lifetime extended, and shortened after scheduling
+  TestItem *extended = new TestItem (Seconds (1));
+  wheel->Schedule (*extended);
+  Simulator::Schedule (Seconds (0.5), &TestItem::SetExpireTime, extended, wheel, Seconds (3));
+  items.push_back (extended);
+
+  TestItem *shortened = new TestItem (Seconds (100));
+  wheel->Schedule (*shortened);
+  Simulator::Schedule (Seconds (0.1), &TestItem::SetExpireTime, shortened, wheel, Seconds (0.2));
+  items.push_back (shortened);
+
+  // destroyed before expiration
+  TestItem *destroyed = new TestItem (Seconds (0.1));
+  wheel->Schedule (*destroyed);
+  Simulator::Schedule (Seconds (0.05), &DestroyItem, destroyed);
+
+  NS_TEST_ASSERT_MSG_EQ (wheel->GetSize (), items.size () + 1, "Items should be scheduled");
+
+  // scheduled when the wheel is idle
+  TestItem *late = new TestItem (Seconds (20000.5));
+  Simulator::Schedule (Seconds (20000.25), &ScheduleItem, wheel, late);
+  items.push_back (late);
+
+  Simulator::Schedule (Seconds (20001), &ExpiryWheelTest::CheckEmpty, this, wheel);
+  Simulator::Run ();
+
+  for (std::vector<TestItem*>::iterator item = items.begin (); item != items.end (); item++)
+    {
+      NS_TEST_ASSERT_MSG_EQ ((*item)->m_expired, true, "Item should have expired");
+      NS_TEST_ASSERT_MSG_EQ (((*item)->m_expiredAt >= (*item)->m_expireTime), true, "Item should not expire early");
+      NS_TEST_ASSERT_MSG_EQ (((*item)->m_expiredAt <= (*item)->m_expireTime + tick), true, "Item should expire within a tick");
+      delete *item;
+    }
+
+  wheel->Dispose ();
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,93 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-fib-sharing.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndn-fib-entry.h"
+
+namespace ns3
+{
+
+static Ptr<ndn::fib::Entry>
+Match (Ptr<ndn::Fib> fib, const std::string &name)
+{
+  ndn::Interest interest;
+  interest.SetName (Create<ndn::Name> (name));
+  return fib->LongestPrefixMatch (interest);
+}
+
+void
+FibSharingTest::DoRun ()
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> repo1 = CreateObject<Node> ();
+  Ptr<Node> repo2 = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, repo1);
+  p2p.Install (node, repo2);
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  Ptr<ndn::Face> face1 = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+  Ptr<ndn::Face> face2 = node->GetObject<ndn::L3Protocol> ()->GetFace (1);
+
+  Ptr<ndn::fib::Entry> entry = fib->Add (ndn::Name ("/repo1/content1"), face1, 1);
+  NS_TEST_ASSERT_MSG_EQ (fib->Add (Create<ndn::Name> ("/repo1/content2"), entry), entry, "Prefix should share the entry");
+  NS_TEST_ASSERT_MSG_EQ (fib->Add (Create<ndn::Name> ("/repo1/content3"), entry), entry, "Prefix should share the entry");
+  NS_TEST_ASSERT_MSG_EQ (fib->Add (Create<ndn::Name> ("/repo1/content3"), entry), entry, "Sharing twice should not change anything");
+
+  NS_TEST_ASSERT_MSG_EQ (Match (fib, "/repo1/content2/chunk1"), entry, "Longest prefix match should return the shared entry");
+  NS_TEST_ASSERT_MSG_EQ (fib->Find (ndn::Name ("/repo1/content3")), entry, "Exact match should return the shared entry");
+  NS_TEST_ASSERT_MSG_EQ (Match (fib, "/repo1/content4"), 0, "Prefix without entry should not match");
+
+  entry->UpdateStatus (face1, ndn::fib::FaceMetric::NDN_FIB_GREEN);
+  NS_TEST_ASSERT_MSG_EQ (Match (fib, "/repo1/content3")->m_faces.begin ()->GetStatus (), ndn::fib::FaceMetric::NDN_FIB_GREEN,
+                         "Update of the entry should apply to all prefixes sharing it");
+
+  // prefix that already has its own entry gets the next hops of the shared entry
+  Ptr<ndn::fib::Entry> own = fib->Add (ndn::Name ("/repo2/content1"), face2, 5);
+  NS_TEST_ASSERT_MSG_EQ (fib->Add (Create<ndn::Name> ("/repo2/content1"), entry), own, "Prefix should keep its own entry");
+  NS_TEST_ASSERT_MSG_EQ (own->m_faces.size (), 2, "Next hops of the shared entry should have been added");
+  NS_TEST_ASSERT_MSG_EQ (entry->m_faces.size (), 1, "Shared entry should not be changed");
+
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 4, "Every prefix should be counted");
+  uint32_t entries = 0;
+  for (Ptr<ndn::fib::Entry> item = fib->Begin (); item != fib->End (); item = fib->Next (item))
+    entries ++;
+  NS_TEST_ASSERT_MSG_EQ (entries, 2, "Shared entry should be iterated only once");
+
+  fib->Remove (Create<ndn::Name> ("/repo1/content2"));
+  NS_TEST_ASSERT_MSG_EQ (Match (fib, "/repo1/content2"), 0, "Removed prefix should not match");
+  NS_TEST_ASSERT_MSG_EQ (Match (fib, "/repo1/content3"), entry, "Other prefixes should still share the entry");
+
+  fib->RemoveFromAll (face1);
+  NS_TEST_ASSERT_MSG_EQ (fib->Find (ndn::Name ("/repo1/content1")), 0, "Entry without next hops should be removed");
+  NS_TEST_ASSERT_MSG_EQ (fib->Find (ndn::Name ("/repo1/content3")), 0, "Prefixes sharing the removed entry should be removed");
+  NS_TEST_ASSERT_MSG_EQ (fib->Find (ndn::Name ("/repo2/content1")), own, "Entry with other next hops should stay");
+  NS_TEST_ASSERT_MSG_EQ (own->m_faces.size (), 1, "Face should have been removed from the entry");
+  NS_TEST_ASSERT_MSG_EQ (fib->GetSize (), 1, "Only one prefix should be left");
+
+  Simulator::Destroy ();
+}
+
+}
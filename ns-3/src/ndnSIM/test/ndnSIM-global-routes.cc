@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-global-routes.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/helper/boost-graph-ndn-global-routing-helper.h"
+#include "ns3/ndnSIM/helper/ndn-global-routes.h"
+#include "ns3/ndnSIM/model/ndn-net-device-face.h"
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+
+namespace ns3
+{
+
+static void
+Dijkstra (Ptr<ndn::GlobalRouter> source, boost::DistancesMap &distances)
+{
+  boost::NdnGlobalRouterGraph graph;
+  boost::dijkstra_shortest_paths (graph, source,
+                                  boost::distance_map (boost::ref (distances))
+                                  .
+                                  distance_inf (boost::WeightInf)
+                                  .
+                                  distance_zero (boost::WeightZero)
+                                  .
+                                  distance_compare (boost::WeightCompare ())
+                                  .
+                                  distance_combine (boost::WeightCombine ())
+                                  );
+}
+
+static bool
+SameDistances (const boost::DistancesMap &expected, const boost::DistancesMap &actual)
+{
+  if (expected.size () != actual.size ())
+    return false;
+
+  for (boost::DistancesMap::const_iterator i = expected.begin (); i != expected.end (); i++)
+    {
+      boost::DistancesMap::const_iterator j = actual.find (i->first);
+      if (j == actual.end () ||
+          i->second.get<0> () != j->second.get<0> ())
+        return false;
+
+      if (i->second.get<0> () != 0 && // distances of unreachable routers do not matter
+          (i->second.get<1> () != j->second.get<1> () || i->second.get<2> () != j->second.get<2> ()))
+        return false;
+    }
+  return true;
+}
+
+void
+GlobalRoutesTest::DoRun ()
+{
+  // 3x3 grid (many equal cost paths) with one slower diagonal link
+  NodeContainer nodes;
+  nodes.Create (9);
+
+  PointToPointHelper p2p;
+  for (uint32_t row = 0; row < 3; row++)
+    for (uint32_t col = 0; col < 3; col++)
+      {
+        if (col < 2) p2p.Install (nodes.Get (row * 3 + col), nodes.Get (row * 3 + col + 1));
+        if (row < 2) p2p.Install (nodes.Get (row * 3 + col), nodes.Get ((row + 1) * 3 + col));
+      }
+  p2p.SetChannelAttribute ("Delay", StringValue ("10ms"));
+  p2p.Install (nodes.Get (0), nodes.Get (8));
+
+  ndn::StackHelper ndn;
+  ndn.Install (nodes);
+
+  ndn::GlobalRoutingHelper routingHelper;
+  routingHelper.InstallAll ();
+
+  ndn::GlobalRoutes routes (false);
+  routes.Calculate (1, "");
+  ndn::GlobalRoutes parallelRoutes (false);
+  parallelRoutes.Calculate (4, "");
+
+  std::string cacheDirectory = CreateTempDirFilename ("routes");
+  ndn::GlobalRoutes savedRoutes (false);
+  savedRoutes.Calculate (2, cacheDirectory);
+  ndn::GlobalRoutes loadedRoutes (false);
+  loadedRoutes.Calculate (2, cacheDirectory);
+
+  ndn::GlobalRoutes allRoutes (true);
+  allRoutes.Calculate (3, "");
+
+  for (uint32_t node = 0; node < nodes.GetN (); node++)
+    {
+      Ptr<ndn::GlobalRouter> source = nodes.Get (node)->GetObject<ndn::GlobalRouter> ();
+
+      boost::DistancesMap expected;
+      Dijkstra (source, expected);
+
+      boost::DistancesMap actual;
+      routes.GetDistances (source, 0, actual);
+      NS_TEST_ASSERT_MSG_EQ (SameDistances (expected, actual), true, "Routes of node " << node << " should match dijkstra_shortest_paths");
+
+      actual.clear ();
+      parallelRoutes.GetDistances (source, 0, actual);
+      NS_TEST_ASSERT_MSG_EQ (SameDistances (expected, actual), true, "Routes of node " << node << " calculated in parallel should match");
+
+      actual.clear ();
+      loadedRoutes.GetDistances (source, 0, actual);
+      NS_TEST_ASSERT_MSG_EQ (SameDistances (expected, actual), true, "Routes of node " << node << " loaded from the cache should match");
+
+      // same face metric changes as in GlobalRoutingHelper::CalculateAllPossibleRoutes before the snapshot
+      Ptr<ndn::L3Protocol> l3 = nodes.Get (node)->GetObject<ndn::L3Protocol> ();
+      NS_TEST_ASSERT_MSG_EQ (allRoutes.GetNRuns (source), l3->GetNFaces (), "One run per face is expected");
+
+      std::vector<uint16_t> originalMetric (l3->GetNFaces ());
+      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+        {
+          originalMetric[faceId] = l3->GetFace (faceId)->GetMetric ();
+          l3->GetFace (faceId)->SetMetric (std::numeric_limits<int16_t>::max ()-1);
+        }
+
+      for (uint32_t enabledFaceId = 0; enabledFaceId < l3->GetNFaces (); enabledFaceId++)
+        {
+          if (DynamicCast<ndn::NetDeviceFace> (l3->GetFace (enabledFaceId)) == 0)
+            continue;
+          l3->GetFace (enabledFaceId)->SetMetric (originalMetric[enabledFaceId]);
+
+          expected.clear ();
+          Dijkstra (source, expected);
+          for (boost::DistancesMap::iterator i = expected.begin (); i != expected.end (); i++)
+            {
+              if (i->second.get<0> () != 0 &&
+                  i->second.get<0> ()->GetMetric () == std::numeric_limits<uint16_t>::max ()-1)
+                i->second.get<0> () = 0; // not installed
+            }
+
+          actual.clear ();
+          allRoutes.GetDistances (source, enabledFaceId, actual);
+          NS_TEST_ASSERT_MSG_EQ (SameDistances (expected, actual), true,
+                                 "Routes of node " << node << " through face " << enabledFaceId << " should match");
+
+          l3->GetFace (enabledFaceId)->SetMetric (std::numeric_limits<uint16_t>::max ()-1);
+        }
+
+      for (uint32_t faceId = 0; faceId < l3->GetNFaces (); faceId++)
+        {
+          l3->GetFace (faceId)->SetMetric (originalMetric[faceId]);
+        }
+    }
+
+  Simulator::Destroy ();
+}
+
+}
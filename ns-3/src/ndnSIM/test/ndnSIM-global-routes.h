@@ -0,0 +1,44 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_TEST_GLOBAL_ROUTES_H
+#define NDNSIM_TEST_GLOBAL_ROUTES_H
+
+#include "ns3/test.h"
+
+namespace ns3 {
+
+/**
+ * @brief Check that routes calculated on the topology snapshot (in parallel, or loaded from
+ *        the cache) are the same as those of dijkstra_shortest_paths on the real topology
+ */
+class GlobalRoutesTest : public TestCase
+{
+public:
+  GlobalRoutesTest ()
+    : TestCase ("Global routes test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+};
+
+}
+
+#endif // NDNSIM_TEST_GLOBAL_ROUTES_H
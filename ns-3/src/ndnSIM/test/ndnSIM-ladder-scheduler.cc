@@ -0,0 +1,177 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-ladder-scheduler.h"
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/utils/ndn-ladder-scheduler.h"
+#include "ns3/ndnSIM/utils/ndn-recording-scheduler.h"
+
+#include <set>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+
+namespace ns3
+{
+
+static Scheduler::Event
+SchedulerEvent (uint64_t ts, uint32_t uid)
+{
+  Scheduler::Event ev;
+  ev.impl = 0;
+  ev.key.m_ts = ts;
+  ev.key.m_uid = uid;
+  ev.key.m_context = 0;
+  return ev;
+}
+
+void
+LadderSchedulerTest::CheckRandom ()
+{
+  Ptr<Scheduler> ladder = CreateObject<ndn::LadderScheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+
+  Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable> ();
+  rand->SetStream (1);
+
+  std::set<uint32_t> live;
+  std::vector<Scheduler::Event> cancellable;
+  uint32_t uid = 0;
+  uint64_t now = 0;
+
+  // bimodal delays, as link delays and PIT/QTAB/retransmission timers, plus zero delays
+  for (uint32_t step = 0; step < 100000; step++)
+    {
+      uint32_t inserts = step < 2000 ? 2 : (step < 90000 ? rand->GetInteger (0, 2) : 0);
+      for (uint32_t i = 0; i < inserts; i++)
+        {
+          double type = rand->GetValue ();
+          uint64_t delay = 0;
+          if (type < 0.8)
+            delay = rand->GetInteger (1, 10000000);
+          else if (type < 0.95)
+            delay = rand->GetInteger (1000000000, 3000000000u);
+
+          Scheduler::Event ev = SchedulerEvent (now + delay, uid++);
+          ladder->Insert (ev);
+          reference->Insert (ev);
+          live.insert (ev.key.m_uid);
+          if (delay >= 1000000000)
+            cancellable.push_back (ev);
+        }
+
+      if (!cancellable.empty () && rand->GetValue () < 0.05)
+        {
+          uint32_t pos = rand->GetInteger (0, cancellable.size () - 1);
+          Scheduler::Event ev = cancellable[pos];
+          cancellable[pos] = cancellable.back ();
+          cancellable.pop_back ();
+          if (live.erase (ev.key.m_uid) > 0)
+            {
+              ladder->Remove (ev);
+              reference->Remove (ev);
+            }
+        }
+
+      NS_TEST_ASSERT_MSG_EQ (ladder->IsEmpty (), reference->IsEmpty (), "Schedulers should have the same events");
+      if (reference->IsEmpty ())
+        continue;
+
+      NS_TEST_ASSERT_MSG_EQ (ladder->PeekNext ().key.m_uid, reference->PeekNext ().key.m_uid, "Next events should be the same");
+      Scheduler::Event next = ladder->RemoveNext ();
+      Scheduler::Event expected = reference->RemoveNext ();
+      NS_TEST_ASSERT_MSG_EQ (next.key.m_uid, expected.key.m_uid, "Events should be removed in the same order");
+      NS_TEST_ASSERT_MSG_EQ (next.key.m_ts, expected.key.m_ts, "Events should be removed in the same order");
+      live.erase (next.key.m_uid);
+      now = next.key.m_ts;
+    }
+
+  while (!reference->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (ladder->IsEmpty (), false, "Schedulers should have the same events");
+      NS_TEST_ASSERT_MSG_EQ (ladder->RemoveNext ().key.m_uid, reference->RemoveNext ().key.m_uid, "Events should be removed in the same order");
+    }
+  NS_TEST_ASSERT_MSG_EQ (ladder->IsEmpty (), true, "Ladder scheduler should be empty");
+}
+
+static void
+RecordTime (std::vector<uint32_t> *order, uint32_t i)
+{
+  order->push_back (i);
+}
+
+void
+LadderSchedulerTest::CheckSimulation ()
+{
+  ObjectFactory factory;
+  factory.SetTypeId ("ns3::ndn::LadderScheduler");
+  Simulator::SetScheduler (factory);
+
+  // many events at the same time are executed in the order they have been scheduled
+  std::vector<uint32_t> order;
+  for (uint32_t i = 0; i < 300; i++)
+    {
+      Simulator::Schedule (Seconds (1.0 + (i % 3)), &RecordTime, &order, i);
+    }
+  EventId cancelled = Simulator::Schedule (Seconds (2), &RecordTime, &order, 1000);
+  Simulator::Remove (cancelled);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (order.size (), 300, "All events, but the removed one, should be executed");
+  for (uint32_t i = 0; i < order.size (); i++)
+    {
+      uint32_t expected = (i % 100) * 3 + i / 100;
+      NS_TEST_ASSERT_MSG_EQ (order[i], expected, "Events should be executed in order of time and scheduling");
+    }
+}
+
+void
+LadderSchedulerTest::CheckRecording ()
+{
+  std::string path = CreateTempDirFilename ("scheduler-events.txt");
+  {
+    Ptr<ndn::RecordingScheduler> recording = CreateObject<ndn::RecordingScheduler> ();
+    recording->SetAttribute ("Scheduler", StringValue ("ns3::ndn::LadderScheduler"));
+    recording->SetAttribute ("File", StringValue (path));
+
+    recording->Insert (SchedulerEvent (20, 1));
+    recording->Insert (SchedulerEvent (10, 2));
+    recording->Insert (SchedulerEvent (30, 3));
+    recording->Remove (SchedulerEvent (30, 3));
+    NS_TEST_ASSERT_MSG_EQ (recording->RemoveNext ().key.m_uid, 2, "Recording scheduler should return the next event");
+  }
+
+  std::ifstream is (path.c_str ());
+  std::ostringstream os;
+  os << is.rdbuf ();
+  NS_TEST_ASSERT_MSG_EQ (os.str (), "i 20 1\ni 10 2\ni 30 3\nr 30 3\nn 10 2\n", "All operations should be recorded");
+  std::remove (path.c_str ());
+}
+
+void
+LadderSchedulerTest::DoRun ()
+{
+  CheckRandom ();
+  CheckSimulation ();
+  CheckRecording ();
+}
+
+}
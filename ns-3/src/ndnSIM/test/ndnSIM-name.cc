@@ -0,0 +1,123 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include "ndnSIM-name.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndn-fib-entry.h"
+
+#include <boost/functional/hash.hpp>
+
+namespace ns3
+{
+
+void
+NameTest::DoRun ()
+{
+  std::list<std::string> components;
+  components.push_back ("repo1");
+  components.push_back ("");
+  components.push_back ("content1");
+  components.push_back ("chunk7");
+
+  ndn::Name name (components);
+  NS_TEST_ASSERT_MSG_EQ (name.size (), 4, "Every component should be stored");
+  NS_TEST_ASSERT_MSG_EQ (name.GetComponentSize (1), 0, "Empty component should be stored");
+  NS_TEST_ASSERT_MSG_EQ (std::string (name.GetComponentData (2), name.GetComponentSize (2)), "content1", "Wrong component");
+  NS_TEST_ASSERT_MSG_EQ (name.IsComponentEqual (3, "chunk7"), true, "Component should be equal");
+  NS_TEST_ASSERT_MSG_EQ (name.IsComponentEqual (3, "chunk"), false, "Component should not be equal");
+  NS_TEST_ASSERT_MSG_EQ (name.GetLastComponent (), "chunk7", "Wrong last component");
+  NS_TEST_ASSERT_MSG_EQ ((name.GetComponents () == components), true, "List of components should be the same");
+
+  name.Add (12);
+  NS_TEST_ASSERT_MSG_EQ (name.GetComponents ().back (), "12", "Added component should be in the list of components");
+  NS_TEST_ASSERT_MSG_EQ (*name.begin (), "repo1", "Wrong first component");
+  components.push_back ("12");
+
+  // prefix hashes are the same as hashes of the lists of components
+  std::list<std::string> prefix;
+  std::list<std::string>::const_iterator component = components.begin ();
+  NS_TEST_ASSERT_MSG_EQ (name.GetPrefixHash (0), boost::hash_range (prefix.begin (), prefix.end ()), "Wrong hash of the root");
+  for (size_t i = 1; i <= name.size (); i++, component++)
+    {
+      prefix.push_back (*component);
+      NS_TEST_ASSERT_MSG_EQ (name.GetPrefixHash (i), boost::hash_range (prefix.begin (), prefix.end ()), "Wrong prefix hash");
+      NS_TEST_ASSERT_MSG_EQ (name.cut (name.size () - i).GetPrefixHash (i), name.GetPrefixHash (i), "Wrong hash of the cut name");
+    }
+  NS_TEST_ASSERT_MSG_EQ (boost::hash<ndn::Name> () (name), boost::hash_range (components.begin (), components.end ()), "Wrong hash of the name");
+  NS_TEST_ASSERT_MSG_EQ (ndn::Name ("/repo1/content1").GetPrefixHash (2), ndn::Name ("/repo1/content1/chunk1").GetPrefixHash (2),
+                         "Same prefixes should have the same hash");
+
+  NS_TEST_ASSERT_MSG_EQ (name.cut (2), ndn::Name (std::list<std::string> (components.begin (), --(--components.end ()))),
+                         "Wrong cut name");
+  NS_TEST_ASSERT_MSG_EQ (name.cut (name.size ()), ndn::Name (), "Cut of all components should be the root");
+
+  // same order as the lists of components
+  const char *names[] = { "/", "/a", "/a/b", "/ab", "/a/bc", "/b", "/a/b/c", "/abc/d", "/ab/c" };
+  size_t count = sizeof (names) / sizeof (names[0]);
+  for (size_t i = 0; i < count; i++)
+    for (size_t j = 0; j < count; j++)
+      {
+        ndn::Name a (names[i]), b (names[j]);
+        NS_TEST_ASSERT_MSG_EQ ((a < b), (a.GetComponents () < b.GetComponents ()), "Wrong order of " << a << " and " << b);
+        NS_TEST_ASSERT_MSG_EQ ((a == b), (i == j), "Wrong equality of " << a << " and " << b);
+      }
+
+  // serialization round trip
+  Buffer buffer;
+  buffer.AddAtStart (name.GetSerializedSize ());
+  NS_TEST_ASSERT_MSG_EQ (name.Serialize (buffer.Begin ()), name.GetSerializedSize (), "Wrong serialized size");
+  ndn::Name deserialized;
+  NS_TEST_ASSERT_MSG_EQ (deserialized.Deserialize (buffer.Begin ()), name.GetSerializedSize (), "Wrong deserialized size");
+  NS_TEST_ASSERT_MSG_EQ (deserialized, name, "Deserialized name should be the same");
+
+  std::ostringstream os;
+  os << name;
+  NS_TEST_ASSERT_MSG_EQ (os.str (), "/repo1//content1/chunk7/12", "Wrong printed name");
+  os.str ("");
+  os << ndn::Name ();
+  NS_TEST_ASSERT_MSG_EQ (os.str (), "/", "Wrong printed root");
+
+  // lookups in the tables
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<Node> repo = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (node, repo);
+
+  ndn::StackHelper ndn;
+  ndn.Install (node);
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  Ptr<ndn::Face> face = node->GetObject<ndn::L3Protocol> ()->GetFace (0);
+  Ptr<ndn::fib::Entry> entry1 = fib->Add (ndn::Name ("/repo1/content1"), face, 1);
+  Ptr<ndn::fib::Entry> entry2 = fib->Add (ndn::Name ("/repo1/content1/chunk1"), face, 1);
+
+  ndn::Interest interest;
+  interest.SetName (Create<ndn::Name> ("/repo1/content1/chunk2"));
+  NS_TEST_ASSERT_MSG_EQ (fib->LongestPrefixMatch (interest), entry1, "Wrong longest prefix match");
+  interest.SetName (Create<ndn::Name> ("/repo1/content1/chunk1/segment"));
+  NS_TEST_ASSERT_MSG_EQ (fib->LongestPrefixMatch (interest), entry2, "Wrong longest prefix match");
+  interest.SetName (Create<ndn::Name> ("/repo1/content"));
+  NS_TEST_ASSERT_MSG_EQ (fib->LongestPrefixMatch (interest), 0, "Prefix without entry should not match");
+  NS_TEST_ASSERT_MSG_EQ (fib->Find (ndn::Name ("/repo1/content1/chunk1")), entry2, "Wrong exact match");
+
+  Simulator::Destroy ();
+}
+
+}
@@ -0,0 +1,164 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-qtab.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndnSIM/model/qtab/ndn-qtab.h"
+#include "ns3/ndnSIM/model/qtab/ndn-qtab-entry.h"
+
+#include <boost/lexical_cast.hpp>
+#include <vector>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.QtabTest");
+
+namespace ns3
+{
+
+static const uint32_t CONTENTS = 100; // enough to make the flat table grow a couple of times
+static const uint32_t FACES = 3;
+
+static Ptr<ndn::Qtab>
+InstallQtab (Ptr<Node> node, const std::string &qtabClass)
+{
+  ndn::StackHelper ndn;
+  ndn.SetQtab (qtabClass, "QtabEntryLifetime", "1s");
+  ndn.Install (node);
+
+  ndn::StackHelper::AddRoute (node, "/", 0, 0);
+
+  Ptr<ndn::Qtab> qtab = node->GetObject<ndn::Qtab> ();
+  qtab->SetEta (0.3);
+  qtab->SetDelta (0.1);
+  qtab->InitializeRttVect (FACES);
+  for (uint32_t face = 0; face < FACES; face ++)
+    qtab->SetRttVect (MicroSeconds (1000 * (face + 1)) + NanoSeconds (250 * face), face);
+
+  return qtab;
+}
+
+static uint32_t
+CountEntries (Ptr<ndn::Qtab> qtab)
+{
+  uint32_t count = 0;
+  for (Ptr<ndn::qtab::Entry> entry = qtab->BeginQtab ();
+       entry != qtab->EndQtab ();
+       entry = qtab->NextQtab (entry))
+    count ++;
+  return count;
+}
+
+void
+QtabTest::CheckExpired (Ptr<ndn::Qtab> trie, Ptr<ndn::Qtab> flat)
+{
+  NS_TEST_ASSERT_MSG_EQ (trie->GetSizeQtab (), 0, "All trie entries should have expired");
+  NS_TEST_ASSERT_MSG_EQ (flat->GetSizeQtab (), 0, "All flat entries should have expired");
+}
+
+void
+QtabTest::DoRun ()
+{
+  Ptr<Node> trieNode = CreateObject<Node> ();
+  Ptr<Node> flatNode = CreateObject<Node> ();
+  PointToPointHelper p2p;
+  p2p.Install (trieNode, flatNode);
+
+  Ptr<ndn::Qtab> trie = InstallQtab (trieNode, "ns3::ndn::qtab::Persistent");
+  Ptr<ndn::Qtab> flat = InstallQtab (flatNode, "ns3::ndn::qtab::Flat");
+
+  std::vector< Ptr<ndn::Interest> > interests;
+  for (uint32_t content = 0; content < CONTENTS; content ++)
+    {
+      Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+      interest->SetName (Create<ndn::Name> ("/domain/content" + boost::lexical_cast<std::string> (content) + "/7"));
+      interests.push_back (interest);
+
+      Ptr<ndn::qtab::Entry> trieEntry = trie->CreateQtab (interest, trieNode->GetObject<ndn::Fib> ()->LongestPrefixMatch (*interest), FACES);
+      Ptr<ndn::qtab::Entry> flatEntry = flat->CreateQtab (interest, flatNode->GetObject<ndn::Fib> ()->LongestPrefixMatch (*interest), FACES);
+      NS_TEST_ASSERT_MSG_NE (trieEntry, 0, "Trie entry should have been created");
+      NS_TEST_ASSERT_MSG_NE (flatEntry, 0, "Flat entry should have been created");
+      NS_TEST_ASSERT_MSG_EQ (flatEntry->GetPrefix (), trieEntry->GetPrefix (), "Both entries should be keyed by the content name");
+
+      NS_TEST_ASSERT_MSG_EQ (flatEntry->ExtractTempMinQvalue (), trieEntry->ExtractTempMinQvalue (), "Q-values should start empty");
+
+      // a different chunk of the same content should not create a new entry
+      Ptr<ndn::Interest> otherChunk = Create<ndn::Interest> ();
+      otherChunk->SetName (Create<ndn::Name> ("/domain/content" + boost::lexical_cast<std::string> (content) + "/8"));
+      NS_TEST_ASSERT_MSG_EQ (flat->LookupQtab (*otherChunk), flatEntry, "Chunks of a content should share the flat entry");
+      NS_TEST_ASSERT_MSG_EQ (trie->LookupQtab (*otherChunk), trieEntry, "Chunks of a content should share the trie entry");
+
+      for (uint32_t round = 0; round < 5; round ++)
+        {
+          uint32_t face = (content + round) % (FACES + 1); // face FACES plays the application face
+          Time piggyQvalue = MicroSeconds (100 * content + 37 * round) + NanoSeconds ((311 * round) % 1000);
+
+          trieEntry->UpdateQvalue (face, piggyQvalue);
+          flatEntry->UpdateQvalue (face, piggyQvalue);
+
+          NS_TEST_ASSERT_MSG_EQ (flatEntry->ExtractTempMinQvalue (), trieEntry->ExtractTempMinQvalue (), "Minimum Q-values should match");
+        }
+
+      trieEntry->CalculateMinQvalue ();
+      flatEntry->CalculateMinQvalue ();
+      NS_TEST_ASSERT_MSG_EQ (flatEntry->GetqMin ().qValueMin, trieEntry->GetqMin ().qValueMin, "Minimum Q-values should match");
+      NS_TEST_ASSERT_MSG_EQ (flatEntry->GetqMin ().interfId, trieEntry->GetqMin ().interfId, "Interfaces of the minimum Q-value should match");
+
+      for (uint32_t face = 0; face < FACES; face ++)
+        NS_TEST_ASSERT_MSG_EQ (flatEntry->CheckContinueExploit (face), trieEntry->CheckContinueExploit (face), "Exploitation decisions should match");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (flat->GetSizeQtab (), trie->GetSizeQtab (), "Both tables should have the same size");
+
+  // growing the table should not lose Q-values
+  for (uint32_t content = 0; content < CONTENTS; content ++)
+    {
+      Ptr<ndn::qtab::Entry> trieEntry = trie->LookupQtab (*interests[content]);
+      Ptr<ndn::qtab::Entry> flatEntry = flat->LookupQtab (*interests[content]);
+      NS_TEST_ASSERT_MSG_NE (flatEntry, 0, "Flat entry should be found");
+      NS_TEST_ASSERT_MSG_EQ (flatEntry->ExtractTempMinQvalue (), trieEntry->ExtractTempMinQvalue (), "Minimum Q-values should match");
+    }
+
+  // remove every third entry, the rest should still be reachable (backward-shift deletion)
+  for (uint32_t content = 0; content < CONTENTS; content += 3)
+    {
+      trie->MarkErasedQtab (trie->LookupQtab (*interests[content]));
+      flat->MarkErasedQtab (flat->LookupQtab (*interests[content]));
+    }
+
+  for (uint32_t content = 0; content < CONTENTS; content ++)
+    {
+      Ptr<ndn::qtab::Entry> trieEntry = trie->FindQtab (interests[content]->GetContentName ());
+      Ptr<ndn::qtab::Entry> flatEntry = flat->FindQtab (interests[content]->GetContentName ());
+      NS_TEST_ASSERT_MSG_EQ ((flatEntry == 0), (content % 3 == 0), "Only erased entries should be missing");
+      if (trieEntry != 0 && flatEntry != 0)
+        NS_TEST_ASSERT_MSG_EQ (flatEntry->ExtractTempMinQvalue (), trieEntry->ExtractTempMinQvalue (), "Minimum Q-values should match");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (flat->GetSizeQtab (), trie->GetSizeQtab (), "Both tables should have the same size");
+  NS_TEST_ASSERT_MSG_EQ (CountEntries (flat), flat->GetSizeQtab (), "Iteration should visit every flat entry");
+
+  Simulator::Schedule (Seconds (1.5), &QtabTest::CheckExpired, this, trie, flat);
+
+  Simulator::Stop (Seconds (2.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+}
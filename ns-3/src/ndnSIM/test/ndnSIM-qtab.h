@@ -0,0 +1,50 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef NDNSIM_TEST_QTAB_H
+#define NDNSIM_TEST_QTAB_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+namespace ns3 {
+
+namespace ndn {
+class Qtab;
+}
+
+/**
+ * @brief Check that the flat QTAB (ns3::ndn::qtab::Flat) takes the same decisions as the trie-based one
+ */
+class QtabTest : public TestCase
+{
+public:
+  QtabTest ()
+    : TestCase ("QTAB flat vs trie test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void CheckExpired (Ptr<ndn::Qtab> trie, Ptr<ndn::Qtab> flat);
+};
+
+}
+
+#endif // NDNSIM_TEST_QTAB_H
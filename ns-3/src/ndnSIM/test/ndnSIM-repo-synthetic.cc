@@ -0,0 +1,100 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-repo-synthetic.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/model/repo/repo-synthetic.h"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ns3
+{
+
+static Ptr<ndn::Repo>
+CreateRepo (const std::string &type, uint32_t maxSize)
+{
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  factory.Set ("MaxSize", UintegerValue (maxSize));
+  return factory.Create<ndn::Repo> ();
+}
+
+static Ptr<ndn::Interest>
+CreateInterest (const std::string &name)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> (name));
+  return interest;
+}
+
+void
+RepoSyntheticTest::DoRun ()
+{
+  Ptr<ndn::Repo> persistent = CreateRepo ("ns3::ndn::rp::Persistent", 100);
+  Ptr<ndn::Repo> synthetic = CreateRepo ("ns3::ndn::rp::Synthetic", 100);
+
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      ndn::Name name ("/prefix/content" + boost::lexical_cast<std::string> (i));
+      persistent->AddContent (name, 512);
+      NS_TEST_ASSERT_MSG_EQ (synthetic->AddContent (name, 512), true, "Content should be added");
+    }
+  NS_TEST_ASSERT_MSG_EQ (synthetic->AddContent (ndn::Name ("/prefix/content7"), 512), false, "Content should not be added twice");
+  NS_TEST_ASSERT_MSG_EQ (synthetic->AddContent (ndn::Name ("/prefix/other"), 512), false, "Repository should be full");
+  NS_TEST_ASSERT_MSG_EQ (synthetic->GetSize (), persistent->GetSize (), "Wrong number of contents");
+
+  for (uint32_t i = 0; i < 100; i += 7)
+    {
+      Ptr<ndn::Interest> interest = CreateInterest ("/prefix/content" + boost::lexical_cast<std::string> (i) + "/" +
+                                                    boost::lexical_cast<std::string> (i * 3));
+
+      Ptr<Packet> expected, packet;
+      Ptr<const ndn::ContentObject> expectedHeader, header;
+      Ptr<const Packet> expectedPayload, payload;
+      boost::tie (expected, expectedHeader, expectedPayload) = persistent->Lookup (interest);
+      boost::tie (packet, header, payload) = synthetic->Lookup (interest);
+
+      NS_TEST_ASSERT_MSG_NE (packet, 0, "Content should be found");
+      NS_TEST_ASSERT_MSG_EQ (packet->GetSize (), expected->GetSize (), "Packet should have the same size");
+      NS_TEST_ASSERT_MSG_EQ (payload->GetSize (), expectedPayload->GetSize (), "Payload should have the same size");
+      NS_TEST_ASSERT_MSG_EQ (header->GetName (), expectedHeader->GetName (), "Header should have the same name");
+
+      // as done by the forwarding strategy, the content-level header is replaced
+      ndn::ContentObject packetHeader;
+      packet->RemoveHeader (packetHeader);
+      NS_TEST_ASSERT_MSG_EQ (packetHeader.GetName (), interest->GetContentName (), "Packet should have the content name");
+    }
+
+  Ptr<ndn::Interest> interest = CreateInterest ("/prefix/content100/0");
+  NS_TEST_ASSERT_MSG_EQ (synthetic->Lookup (interest).get<0> (), 0, "Content should not be found");
+  interest = CreateInterest ("/prefix/0");
+  NS_TEST_ASSERT_MSG_EQ (synthetic->Lookup (interest).get<0> (), 0, "Only equal names should match");
+
+  uint32_t entries = 0;
+  for (Ptr<ndn::rp::Entry> entry = synthetic->Begin (); entry != synthetic->End (); entry = synthetic->Next (entry))
+    {
+      NS_TEST_ASSERT_MSG_EQ (entry->GetName (), ndn::Name ("/prefix/content" + boost::lexical_cast<std::string> (entries)),
+                             "Contents should be iterated in the order they have been added");
+      entries ++;
+    }
+  NS_TEST_ASSERT_MSG_EQ (entries, 100, "Every content should be iterated");
+}
+
+}
@@ -0,0 +1,62 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-request-catalog.h"
+
+#include "ns3/ndnSIM/utils/ndn-request-catalog.h"
+
+#include <fstream>
+#include <cstdio>
+
+namespace ns3
+{
+
+void
+RequestCatalogTest::DoRun ()
+{
+  std::string path = CreateTempDirFilename ("request-catalog.txt");
+  {
+    std::ofstream file (path.c_str ());
+    file << "/domain/content1\t5\n"
+         << "\n"
+         << "/domain/content3\t1\n"
+         << "/domain/content4\t12"; // no newline at the end
+  }
+
+  Ptr<const ndn::RequestCatalog> catalog = ndn::RequestCatalog::Open (path);
+  NS_TEST_ASSERT_MSG_NE (catalog, 0, "Catalog should have been loaded");
+  NS_TEST_ASSERT_MSG_EQ (ndn::RequestCatalog::Open (path), catalog, "Catalog of the same file should be shared");
+  NS_TEST_ASSERT_MSG_EQ (catalog->GetSize (), 4, "Every line should be indexed");
+
+  std::ifstream file (path.c_str ());
+  for (uint32_t num = 1; num <= 4; num ++)
+    {
+      std::string line;
+      std::getline (file, line);
+      NS_TEST_ASSERT_MSG_EQ (catalog->GetLine (num), line, "Line " << num << " should match getline");
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (catalog->GetLine (0), "", "Lines are numbered from 1");
+  NS_TEST_ASSERT_MSG_EQ (catalog->GetLine (5), "", "Lines after the end of the file should be empty");
+
+  NS_TEST_ASSERT_MSG_EQ (ndn::RequestCatalog::Open (path + ".missing"), 0, "Missing file should not be loaded");
+
+  std::remove (path.c_str ());
+}
+
+}
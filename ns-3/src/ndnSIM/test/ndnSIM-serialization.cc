@@ -88,6 +88,9 @@ ContentObjectSerializationTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (source.GetSignature (), 10, "set/get signature failed");
 
   NS_TEST_ASSERT_MSG_EQ (source.GetSerializedSize (), static_cast<unsigned int> (size + 4), "Signature size should have increased by 4");
+
+  source.GetAdditionalInfo ().SetHopCount (3);
+  source.GetAdditionalInfo ().SetQvalue (MicroSeconds (1234));
   
   Packet packet (0);
   //serialization
@@ -101,6 +104,25 @@ ContentObjectSerializationTest::DoRun ()
   NS_TEST_ASSERT_MSG_EQ (source.GetFreshness (), target.GetFreshness (), "source/target freshness failed");
   NS_TEST_ASSERT_MSG_EQ (source.GetTimestamp (), target.GetTimestamp (), "source/target timestamp failed");
   NS_TEST_ASSERT_MSG_EQ (source.GetSignature (), target.GetSignature (), "source/target signature failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetAdditionalInfo ().GetHopCount (), target.GetAdditionalInfo ().GetHopCount (), "source/target hop count failed");
+  NS_TEST_ASSERT_MSG_EQ (source.GetAdditionalInfo ().GetQvalue (), target.GetAdditionalInfo ().GetQvalue (), "source/target qValue failed");
+
+  // in-place update of the serialized header
+  Ptr<Packet> patched = Create<Packet> (10);
+  patched->AddHeader (source);
+  NS_TEST_ASSERT_MSG_EQ (ContentObject::PeekHopCount (patched), 3, "peek hop count failed");
+  NS_TEST_ASSERT_MSG_EQ (ContentObject::PeekQvalue (patched), MicroSeconds (1234), "peek qValue failed");
+
+  ContentObject::PatchHopCount (patched, 4);
+  ContentObject::PatchQvalue (patched, MicroSeconds (42));
+
+  ContentObject patchedTarget;
+  patched->RemoveHeader (patchedTarget);
+  NS_TEST_ASSERT_MSG_EQ (patchedTarget.GetAdditionalInfo ().GetHopCount (), 4, "patch hop count failed");
+  NS_TEST_ASSERT_MSG_EQ (patchedTarget.GetAdditionalInfo ().GetQvalue (), MicroSeconds (42), "patch qValue failed");
+  NS_TEST_ASSERT_MSG_EQ (patchedTarget.GetName (), source.GetName (), "patch should not change the name");
+  NS_TEST_ASSERT_MSG_EQ (patchedTarget.GetSignature (), source.GetSignature (), "patch should not change the signature");
+  NS_TEST_ASSERT_MSG_EQ (patched->GetSize (), 10, "patch should not change the payload");
 }
 
 }
@@ -24,6 +24,19 @@
 #include "ndnSIM-serialization.h"
 #include "ndnSIM-pit.h"
 #include "ndnSIM-fib-entry.h"
+#include "ndnSIM-qtab.h"
+#include "ndnSIM-expiry-wheel.h"
+#include "ndnSIM-request-catalog.h"
+#include "ndnSIM-binary-trace.h"
+#include "ndnSIM-fib-sharing.h"
+#include "ndnSIM-global-routes.h"
+#include "ndnSIM-bloom-filter.h"
+#include "ndnSIM-name.h"
+#include "ndnSIM-cs-s3fifo.h"
+#include "ndnSIM-repo-synthetic.h"
+#include "ndnSIM-ladder-scheduler.h"
+#include "ndnSIM-topology-partitioner.h"
+#include "ndnSIM-warm-state.h"
 
 namespace ns3
 {
@@ -38,7 +51,20 @@ public:
 
     AddTestCase (new InterestSerializationTest ());
     AddTestCase (new ContentObjectSerializationTest ());
-    AddTestCase (new FibEntryTest ());
+    AddTestCase (new QtabTest ());
+    AddTestCase (new ExpiryWheelTest ());
+    AddTestCase (new RequestCatalogTest ());
+    AddTestCase (new BinaryTraceTest ());
+    AddTestCase (new FibSharingTest ());
+    AddTestCase (new GlobalRoutesTest ());
+    AddTestCase (new BloomFilterTest ());
+    AddTestCase (new NameTest ());
+    AddTestCase (new CsS3FifoTest ());
+    AddTestCase (new RepoSyntheticTest ());
+    AddTestCase (new LadderSchedulerTest ());
+    AddTestCase (new TopologyPartitionerTest ());
+    AddTestCase (new WarmStateTest ());
+    // AddTestCase (new FibEntryTest ());
     // AddTestCase (new PitTest ());
   }
 };
@@ -0,0 +1,140 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndnSIM-topology-partitioner.h"
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+
+#include "ns3/ndnSIM/plugins/topology/topology-partitioner.h"
+
+#include <fstream>
+#include <cstdio>
+
+namespace ns3
+{
+
+void
+TopologyPartitionerTest::CheckLookahead ()
+{
+  // two rings of 4 routers (1ms links) connected by two 10ms links: only the slow links are cut
+  TopologyPartitioner partitioner;
+  for (uint32_t node = 0; node < 8; node++)
+    partitioner.AddNode ();
+  for (uint32_t node = 0; node < 4; node++)
+    {
+      partitioner.AddLink (node, (node + 1) % 4, MilliSeconds (1));
+      partitioner.AddLink (4 + node, 4 + (node + 1) % 4, MilliSeconds (1));
+    }
+  partitioner.AddLink (0, 4, MilliSeconds (10));
+  partitioner.AddLink (2, 6, MilliSeconds (10));
+
+  std::vector<uint32_t> partitions = partitioner.Partition (2);
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetCutLinks (), 2, "Only the slow links should be cut");
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetLookahead (), MilliSeconds (10), "Lookahead should be the delay of the slow links");
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetWeight (0), 4, "Partitions should be balanced");
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetWeight (1), 4, "Partitions should be balanced");
+  for (uint32_t node = 1; node < 4; node++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (partitions[node], partitions[0], "Rings should not be split");
+      NS_TEST_ASSERT_MSG_EQ (partitions[4 + node], partitions[4], "Rings should not be split");
+    }
+
+  // a heavy ring cannot be kept whole: the fast links have to be cut
+  partitioner.AddNode (6);
+  partitioner.AddLink (8, 0, MilliSeconds (1));
+  partitioner.Partition (2);
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetLookahead (), MilliSeconds (1), "Fast links should be cut");
+  NS_TEST_ASSERT_MSG_EQ ((partitioner.GetWeight (0) <= 1.1 * 14 / 2), true, "Partitions should be balanced");
+  NS_TEST_ASSERT_MSG_EQ ((partitioner.GetWeight (1) <= 1.1 * 14 / 2), true, "Partitions should be balanced");
+
+  partitioner.Partition (1);
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetCutLinks (), 0, "One partition cuts no links");
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetWeight (0), 14, "One partition has all nodes");
+}
+
+void
+TopologyPartitionerTest::CheckGrid ()
+{
+  // 4x4 grid with the same delay everywhere: halves and quarters cut 4 and 8 links
+  TopologyPartitioner partitioner;
+  for (uint32_t node = 0; node < 16; node++)
+    partitioner.AddNode ();
+  for (uint32_t row = 0; row < 4; row++)
+    for (uint32_t column = 0; column < 4; column++)
+      {
+        if (column < 3)
+          partitioner.AddLink (row * 4 + column, row * 4 + column + 1, MilliSeconds (5));
+        if (row < 3)
+          partitioner.AddLink (row * 4 + column, (row + 1) * 4 + column, MilliSeconds (5));
+      }
+
+  partitioner.Partition (2);
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetCutLinks (), 4, "Grid should be cut in halves");
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetLookahead (), MilliSeconds (5), "Lookahead should be the link delay");
+
+  partitioner.Partition (4);
+  NS_TEST_ASSERT_MSG_EQ (partitioner.GetCutLinks (), 8, "Grid should be cut in quarters");
+  for (uint32_t part = 0; part < 4; part++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (partitioner.GetWeight (part), 4, "Partitions should be balanced");
+    }
+}
+
+void
+TopologyPartitionerTest::CheckAnnotated ()
+{
+  std::string file = "ndnSIM-topology-partitioner.txt";
+  std::ofstream os (file.c_str ());
+  os << "router\n"
+     << "pa1 NA 0 0\n" << "pa2 NA 0 0\n" << "pa3 NA 0 0\n"
+     << "pb1 NA 0 0\n" << "pb2 NA 0 0\n" << "pb3 NA 0 0\n"
+     << "link\n"
+     << "pa1 pa2 1Gbps 1 1ms 100\n" << "pa2 pa3 1Gbps 1 1ms 100\n" << "pa3 pa1 1Gbps 1 1ms 100\n"
+     << "pb1 pb2 1Gbps 1 1ms 100\n" << "pb2 pb3 1Gbps 1 1ms 100\n" << "pb3 pb1 1Gbps 1 1ms 100\n"
+     << "pa1 pb1 1Gbps 1 20ms 100\n";
+  os.close ();
+
+  AnnotatedTopologyReader reader;
+  reader.SetFileName (file);
+  reader.SetPartitions (2);
+  NodeContainer nodes = reader.Read ();
+  std::remove (file.c_str ());
+
+  NS_TEST_ASSERT_MSG_EQ (nodes.GetN (), 6, "All routers should be read");
+  NS_TEST_ASSERT_MSG_EQ (reader.LinksSize (), 7, "All links should be read");
+  NS_TEST_ASSERT_MSG_EQ ((nodes.Get (0)->GetSystemId () != nodes.Get (3)->GetSystemId ()), true, "Only the slow link should be cut");
+  for (uint32_t node = 1; node < 3; node++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (nodes.Get (node)->GetSystemId (), nodes.Get (0)->GetSystemId (), "Fast links should not be cut");
+      NS_TEST_ASSERT_MSG_EQ (nodes.Get (3 + node)->GetSystemId (), nodes.Get (3)->GetSystemId (), "Fast links should not be cut");
+    }
+
+  Names::Clear ();
+  Simulator::Destroy ();
+}
+
+void
+TopologyPartitionerTest::DoRun ()
+{
+  CheckLookahead ();
+  CheckGrid ();
+  CheckAnnotated ();
+}
+
+}
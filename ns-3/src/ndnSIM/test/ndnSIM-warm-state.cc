@@ -0,0 +1,206 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#include "ndnSIM-warm-state.h"
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "ns3/ndn-fib-entry.h"
+#include "ns3/ndnSIM/model/qtab/ndn-qtab.h"
+#include "ns3/ndnSIM/model/qtab/ndn-qtab-entry.h"
+#include "ns3/ndn-warm-state-helper.h"
+
+#include <boost/lexical_cast.hpp>
+#include <boost/foreach.hpp>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <cstdio>
+
+namespace ns3
+{
+
+static const char *WARM_STATE_FILE = "ndnSIM-warm-state.bin";
+static const uint32_t FACES = 2;
+
+static NodeContainer
+Build ()
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  PointToPointHelper p2p;
+  p2p.Install (nodes.Get (0), nodes.Get (1));
+
+  ndn::StackHelper trie;
+  trie.SetContentStore ("ns3::ndn::cs::Lru", "MaxSize", "3");
+  trie.SetQtab ("ns3::ndn::qtab::Persistent", "QtabEntryLifetime", "1s");
+  trie.Install (nodes.Get (0));
+
+  ndn::StackHelper flat;
+  flat.SetContentStore ("ns3::ndn::cs::S3Fifo", "MaxSize", "4");
+  flat.SetQtab ("ns3::ndn::qtab::Flat", "QtabEntryLifetime", "1s");
+  flat.Install (nodes.Get (1));
+
+  for (uint32_t node = 0; node < nodes.GetN (); node++)
+    {
+      Ptr<ndn::Qtab> qtab = nodes.Get (node)->GetObject<ndn::Qtab> ();
+      qtab->SetEta (0.3);
+      qtab->InitializeRttVect (FACES);
+      for (uint32_t face = 0; face < FACES; face ++)
+        qtab->SetRttVect (MicroSeconds (1000 * (face + 1)), face);
+    }
+  return nodes;
+}
+
+static Ptr<ndn::Interest>
+MakeInterest (uint32_t content)
+{
+  Ptr<ndn::Interest> interest = Create<ndn::Interest> ();
+  interest->SetName (Create<ndn::Name> ("/domain/content" + boost::lexical_cast<std::string> (content) + "/0"));
+  return interest;
+}
+
+static void
+Warm (Ptr<Node> node)
+{
+  Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol> ();
+  Ptr<ndn::Face> face = ndn->GetFace (0);
+
+  ndn::StackHelper::AddRoute (node, "/domain", face, 3);
+  Ptr<ndn::fib::Entry> fibEntry = node->GetObject<ndn::Fib> ()->Find (ndn::Name ("/domain"));
+  fibEntry->UpdateStatus (face, ndn::fib::FaceMetric::NDN_FIB_GREEN);
+  fibEntry->UpdateFaceRtt (face, MilliSeconds (20));
+  fibEntry->UpdateFaceRtt (face, MilliSeconds (30));
+  fibEntry->SetRealDelayToProducer (face, MilliSeconds (12));
+
+  Ptr<ndn::ContentStore> cs = node->GetObject<ndn::ContentStore> ();
+  for (uint32_t content = 0; content < 6; content++)
+    {
+      Ptr<ndn::ContentObject> header = Create<ndn::ContentObject> ();
+      header->SetName (Create<ndn::Name> (MakeInterest (content)->GetName ()));
+      cs->Add (header, Create<Packet> (100 + content));
+
+      // contents requested again move in the replacement order (S3-FIFO: to the main queue)
+      if (content % 2 == 1)
+        cs->Lookup (MakeInterest (content));
+    }
+
+  Ptr<ndn::Qtab> qtab = node->GetObject<ndn::Qtab> ();
+  for (uint32_t content = 0; content < 4; content++)
+    {
+      Ptr<ndn::qtab::Entry> entry = qtab->CreateQtab (MakeInterest (content), fibEntry, FACES);
+      entry->UpdateQvalue (content % FACES, MicroSeconds (500 * (content + 1)));
+      if (content % 2 == 0)
+        {
+          entry->UpdateQvalue ((content + 1) % FACES, MicroSeconds (700));
+          entry->SetExplorationFlag (false);
+          entry->SetIsFirstExplorationFlag (false);
+          entry->CalculateMinQvalue ();
+          entry->SetExploitationChunks (content + 3);
+        }
+      else
+        entry->SetExplorationChunks (content);
+    }
+}
+
+void
+WarmStateTest::Dump (Ptr<Node> node, std::string *state)
+{
+  std::ostringstream os;
+
+  Ptr<ndn::ContentStore> cs = node->GetObject<ndn::ContentStore> ();
+  std::vector< std::pair<Ptr<ndn::cs::Entry>, uint8_t> > entries;
+  cs->Snapshot (entries);
+  for (uint32_t i = 0; i < entries.size (); i++)
+    os << entries[i].first->GetName () << " " << static_cast<uint32_t> (entries[i].second)
+       << " " << entries[i].first->GetPacket ()->GetSize () << "\n";
+  cs->Print (os);
+
+  // QTAB iteration order is not defined
+  std::map<std::string, std::string> qtabEntries;
+  Ptr<ndn::Qtab> qtab = node->GetObject<ndn::Qtab> ();
+  for (Ptr<ndn::qtab::Entry> entry = qtab->BeginQtab (); entry != qtab->EndQtab (); entry = qtab->NextQtab (entry))
+    {
+      std::ostringstream item;
+      for (uint32_t face = 0; face < entry->GetNQvalues (); face++)
+        item << entry->GetQvalue (face) << " ";
+      item << entry->GetqMin ().qValueMin << " " << entry->GetqMin ().interfId << " "
+           << entry->GetExplorationFlag () << entry->GetIsFirstExplorationFlag () << " "
+           << entry->GetExplorationChunks () << " " << entry->GetExploitationChunks () << " "
+           << entry->GetMinDelayFace ()->GetId () << " "
+           << entry->GetExpireTime () - Simulator::Now ();
+      qtabEntries[boost::lexical_cast<std::string> (entry->GetPrefix ())] = item.str ();
+    }
+  for (std::map<std::string, std::string>::const_iterator item = qtabEntries.begin (); item != qtabEntries.end (); item++)
+    os << item->first << " " << item->second << "\n";
+
+  Ptr<ndn::Fib> fib = node->GetObject<ndn::Fib> ();
+  for (Ptr<ndn::fib::Entry> entry = fib->Begin (); entry != fib->End (); entry = fib->Next (entry))
+    {
+      os << entry->GetPrefix () << " " << *entry;
+      BOOST_FOREACH (const ndn::fib::FaceMetric &metric, entry->m_faces)
+        os << " " << metric.GetSRtt () << " " << metric.GetRttVar () << " " << metric.GetRealDelay ();
+      os << "\n";
+    }
+
+  *state = os.str ();
+}
+
+void
+WarmStateTest::DoRun ()
+{
+  std::string saved[2], restored[2];
+
+  NodeContainer nodes = Build ();
+  for (uint32_t node = 0; node < nodes.GetN (); node++)
+    {
+      Warm (nodes.Get (node));
+      Simulator::Schedule (Seconds (0.4), &WarmStateTest::Dump, this, nodes.Get (node), &saved[node]);
+    }
+  ndn::WarmStateHelper::SaveAt (Seconds (0.4), nodes, WARM_STATE_FILE);
+  Simulator::Stop (Seconds (0.5));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  // the same topology in a new simulation
+  nodes = Build ();
+  ndn::WarmStateHelper::Restore (WARM_STATE_FILE);
+  for (uint32_t node = 0; node < nodes.GetN (); node++)
+    {
+      Dump (nodes.Get (node), &restored[node]);
+      NS_TEST_ASSERT_MSG_EQ (restored[node], saved[node], "Node " << node << " should have the saved state");
+    }
+
+  Ptr<ndn::Qtab> qtab = nodes.Get (0)->GetObject<ndn::Qtab> ();
+  NS_TEST_ASSERT_MSG_EQ (qtab->GetSizeQtab (), 4, "QTAB entries should have been restored");
+  NS_TEST_ASSERT_MSG_EQ (qtab->BeginQtab ()->GetExpireTime (), Seconds (0.6), "Remaining lifetime should have been restored");
+
+  // restored entries expire after their remaining lifetime
+  Simulator::Stop (Seconds (0.8));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (qtab->GetSizeQtab (), 0, "Restored QTAB entries should have expired");
+  NS_TEST_ASSERT_MSG_EQ (nodes.Get (1)->GetObject<ndn::Qtab> ()->GetSizeQtab (), 0, "Restored QTAB entries should have expired");
+
+  Simulator::Destroy ();
+  std::remove (WARM_STATE_FILE);
+}
+
+}
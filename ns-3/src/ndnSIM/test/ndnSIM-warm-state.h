@@ -0,0 +1,54 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Alexander Afanasyev <alexander.afanasyev@ucla.edu>
+ */
+
+#ifndef NDNSIM_TEST_WARM_STATE_H
+#define NDNSIM_TEST_WARM_STATE_H
+
+#include "ns3/test.h"
+#include "ns3/ptr.h"
+
+#include <string>
+
+namespace ns3 {
+
+class Node;
+
+/**
+ * @brief Save content stores (LRU and S3-FIFO), QTABs (trie and flat) and FIBs with
+ *        WarmStateHelper and check that a new simulation restores the same state
+ */
+class WarmStateTest : public TestCase
+{
+public:
+  WarmStateTest ()
+    : TestCase ("Warm state snapshot and restore test")
+  {
+  }
+
+private:
+  virtual void DoRun ();
+
+  void
+  Dump (Ptr<Node> node, std::string *state);
+};
+
+}
+
+#endif // NDNSIM_TEST_WARM_STATE_H
@@ -0,0 +1,161 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2013 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/ndnSIM/utils/tracers/ndn-binary-trace-writer.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+
+#ifdef NDNSIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace ns3;
+using namespace std;
+
+typedef ndn::BinaryTraceWriter Writer;
+
+/**
+ * Reads plain files and, if zlib is available, gzip-compressed files
+ */
+class TraceReader
+{
+public:
+  TraceReader (const string &filename)
+  {
+#ifdef NDNSIM_HAVE_ZLIB
+    m_file = gzopen (filename.c_str (), "rb"); // reads uncompressed files as well
+#else
+    m_file = fopen (filename.c_str (), "rb");
+#endif
+  }
+
+  ~TraceReader ()
+  {
+    if (m_file == 0)
+      return;
+#ifdef NDNSIM_HAVE_ZLIB
+    gzclose (m_file);
+#else
+    fclose (m_file);
+#endif
+  }
+
+  bool
+  IsOpen () const
+  {
+    return m_file != 0;
+  }
+
+  bool
+  Read (void *data, uint32_t size)
+  {
+#ifdef NDNSIM_HAVE_ZLIB
+    return gzread (m_file, data, size) == static_cast<int> (size);
+#else
+    return fread (data, 1, size, m_file) == size;
+#endif
+  }
+
+private:
+#ifdef NDNSIM_HAVE_ZLIB
+  gzFile m_file;
+#else
+  FILE *m_file;
+#endif
+};
+
+int main (int argc, char**argv)
+{
+  string input = "";
+  string output = "";
+
+  CommandLine cmd;
+  cmd.AddValue ("input", "Binary trace file (.bin or .bin.gz)", input);
+  cmd.AddValue ("output", "Text trace file (standard output if not specified)", output);
+  cmd.Parse (argc, argv);
+
+  if (input == "")
+    {
+      cerr << "ERROR: input needs to be specified" << endl;
+      cerr << endl;
+
+      cerr << cmd;
+      return 1;
+    }
+
+  TraceReader reader (input);
+  char magic[sizeof (Writer::MAGIC)];
+  if (!reader.IsOpen () || !reader.Read (magic, sizeof (magic)) || memcmp (magic, Writer::MAGIC, sizeof (magic)) != 0)
+    {
+      cerr << "ERROR: " << input << " is not a binary trace file" << endl;
+      return 1;
+    }
+
+  ofstream file;
+  if (output != "")
+    {
+      file.open (output.c_str (), ios_base::out | ios_base::trunc);
+      if (!file.is_open ())
+        {
+          cerr << "ERROR: cannot open " << output << endl;
+          return 1;
+        }
+    }
+  ostream &os = (output != "") ? file : cout;
+
+  vector<string> events (256);
+  Writer::Record record;
+  while (reader.Read (&record, sizeof (record)))
+    {
+      const string &event = events[record.event];
+      switch (record.type)
+        {
+        case Writer::EVENT_NAME:
+          {
+            events[record.event].resize (record.value);
+            if (record.value > 0 && !reader.Read (&events[record.event][0], record.value))
+              {
+                cerr << "ERROR: " << input << " is truncated" << endl;
+                return 1;
+              }
+            break;
+          }
+        case Writer::INTEREST:
+        case Writer::DATA:
+          os << record.time << "\t" << event << "\t" << record.value << "\t--" << "\n";
+          break;
+        case Writer::DATA_APP:
+          os << record.time << "\t" << event << "\t--" << "\n";
+          break;
+        case Writer::INTEREST_APP:
+          os << record.time << "\t" << record.timeSent << "\t" << event << "\t--" << "\n";
+          break;
+        case Writer::DOWNLOAD_TIME:
+          os << record.time << "\t" << record.timeSent << "\t" << event << "\t" << "--" << "\t" << record.downloadTime << "\t" << record.value << "\n";
+          break;
+        default:
+          cerr << "ERROR: unknown record type " << static_cast<uint32_t> (record.type) << endl;
+          return 1;
+        }
+    }
+
+  return 0;
+}
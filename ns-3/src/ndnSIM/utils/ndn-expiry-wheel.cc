@@ -0,0 +1,276 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-expiry-wheel.h"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ExpiryWheel");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (ExpiryWheel);
+
+ExpiryWheel::Item::Item ()
+  : m_wheel (0)
+  , m_tick (0)
+{
+}
+
+ExpiryWheel::Item::~Item ()
+{
+  if (m_wheel != 0)
+    m_wheel->Cancel (*this);
+}
+
+TypeId
+ExpiryWheel::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::ExpiryWheel")
+    .SetGroupName ("Ndn")
+    .SetParent<Object> ()
+    .AddConstructor<ExpiryWheel> ()
+
+    .AddAttribute ("Tick", "Granularity of PIT and QTAB entry expiration",
+                   TimeValue (MilliSeconds (1)),
+                   MakeTimeAccessor (&ExpiryWheel::m_tick),
+                   MakeTimeChecker ())
+    ;
+  return tid;
+}
+
+ExpiryWheel::ExpiryWheel ()
+  : m_now (0)
+  , m_nextTick (0)
+  , m_size (0)
+  , m_inTick (false)
+{
+}
+
+ExpiryWheel::~ExpiryWheel ()
+{
+  Clear ();
+}
+
+void
+ExpiryWheel::DoDispose ()
+{
+  Simulator::Remove (m_tickEvent);
+  Clear ();
+
+  Object::DoDispose ();
+}
+
+void
+ExpiryWheel::Clear ()
+{
+  bucket *levels[] = { m_level0, m_level1, m_level2 };
+  uint32_t sizes[] = { LEVEL0_SIZE, LEVEL_SIZE, LEVEL_SIZE };
+  for (uint32_t level = 0; level < 3; level ++)
+    for (uint32_t slot = 0; slot < sizes[level]; slot ++)
+      {
+        while (!levels[level][slot].empty ())
+          {
+            levels[level][slot].front ().m_wheel = 0;
+            levels[level][slot].pop_front ();
+          }
+      }
+  m_size = 0;
+}
+
+uint32_t
+ExpiryWheel::GetSize () const
+{
+  return m_size;
+}
+
+const Time &
+ExpiryWheel::GetTick () const
+{
+  return m_tick;
+}
+
+uint64_t
+ExpiryWheel::ToTick (const Time &time) const
+{
+  // round up, so items are never expired before their expire time
+  int64_t step = m_tick.GetTimeStep ();
+  return static_cast<uint64_t> ((std::max<int64_t> (time.GetTimeStep (), 0) + step - 1) / step);
+}
+
+void
+ExpiryWheel::Schedule (Item &item)
+{
+  NS_ASSERT_MSG (!item.IsScheduled (), "Item is already scheduled");
+
+  if (!m_inTick && !m_tickEvent.IsRunning ())
+    {
+      // the wheel is empty, skip the ticks that passed since it was used last time
+      m_now = std::max (m_now, ToTick (Simulator::Now ()));
+    }
+
+  Insert (item);
+  m_size ++;
+
+  if (!m_inTick && (!m_tickEvent.IsRunning () || item.m_tick < m_nextTick))
+    {
+      Simulator::Remove (m_tickEvent);
+      RescheduleTick ();
+    }
+}
+
+void
+ExpiryWheel::Update (Item &item)
+{
+  if (!item.IsScheduled ())
+    {
+      Schedule (item);
+      return;
+    }
+
+  if (ToTick (item.GetExpireTime ()) < item.m_tick)
+    {
+      Cancel (item);
+      Schedule (item);
+    }
+  // otherwise, item will be re-inserted when its slot is reached
+}
+
+void
+ExpiryWheel::Cancel (Item &item)
+{
+  NS_ASSERT (item.m_wheel == this);
+
+  item.m_hook.unlink ();
+  item.m_wheel = 0;
+  m_size --;
+}
+
+void
+ExpiryWheel::Insert (Item &item)
+{
+  uint64_t tick = std::max (ToTick (item.GetExpireTime ()), m_now);
+  uint64_t delta = tick - m_now;
+
+  if (delta < LEVEL0_SIZE)
+    {
+      m_level0[tick & (LEVEL0_SIZE - 1)].push_back (item);
+    }
+  else if (delta < (LEVEL0_SIZE << LEVEL_BITS))
+    {
+      m_level1[(tick >> LEVEL0_BITS) & (LEVEL_SIZE - 1)].push_back (item);
+    }
+  else
+    {
+      if (delta >= (LEVEL0_SIZE << (2 * LEVEL_BITS)))
+        tick = m_now + (LEVEL0_SIZE << (2 * LEVEL_BITS)) - 1; // beyond the wheel, will be re-examined
+
+      m_level2[(tick >> (LEVEL0_BITS + LEVEL_BITS)) & (LEVEL_SIZE - 1)].push_back (item);
+    }
+
+  item.m_wheel = this;
+  item.m_tick = tick;
+}
+
+void
+ExpiryWheel::Cascade (bucket *level, uint32_t slot)
+{
+  bucket items;
+  items.swap (level[slot]);
+
+  while (!items.empty ())
+    {
+      Item &item = items.front ();
+      items.pop_front ();
+      Insert (item);
+    }
+}
+
+void
+ExpiryWheel::ProcessTick ()
+{
+  uint64_t tick = m_now;
+  if ((tick & (LEVEL0_SIZE - 1)) == 0)
+    {
+      uint64_t slot1 = (tick >> LEVEL0_BITS) & (LEVEL_SIZE - 1);
+      if (slot1 == 0)
+        Cascade (m_level2, (tick >> (LEVEL0_BITS + LEVEL_BITS)) & (LEVEL_SIZE - 1));
+      Cascade (m_level1, slot1);
+    }
+
+  bucket items;
+  items.swap (m_level0[tick & (LEVEL0_SIZE - 1)]);
+  m_now ++;
+
+  Time now = Simulator::Now ();
+  while (!items.empty ())
+    {
+      Item &item = items.front ();
+      items.pop_front ();
+
+      if (item.GetExpireTime () <= now) // is the record stale?
+        {
+          item.m_wheel = 0;
+          m_size --;
+          item.Expire ();
+        }
+      else
+        Insert (item); // lifetime was extended
+    }
+}
+
+void
+ExpiryWheel::OnTick ()
+{
+  uint64_t current = Simulator::Now ().GetTimeStep () / m_tick.GetTimeStep ();
+  NS_LOG_LOGIC ("Tick " << current << ". Total: " << m_size);
+
+  m_inTick = true;
+  while (m_now <= current)
+    {
+      ProcessTick ();
+    }
+  m_inTick = false;
+
+  RescheduleTick ();
+}
+
+void
+ExpiryWheel::RescheduleTick ()
+{
+  if (m_size == 0)
+    return;
+
+  // skip empty slots, but never a cascade
+  uint64_t next = m_now;
+  while ((next & (LEVEL0_SIZE - 1)) != 0 && m_level0[next & (LEVEL0_SIZE - 1)].empty ())
+    next ++;
+
+  Time nextEvent = TimeStep (next * m_tick.GetTimeStep ()) - Simulator::Now ();
+  if (nextEvent <= 0) nextEvent = Seconds (0);
+
+  m_nextTick = next;
+  m_tickEvent = Simulator::Schedule (nextEvent, &ExpiryWheel::OnTick, this);
+}
+
+} // namespace ndn
+} // namespace ns3
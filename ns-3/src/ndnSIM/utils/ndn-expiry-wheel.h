@@ -0,0 +1,185 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_EXPIRY_WHEEL_H_
+#define	_NDN_EXPIRY_WHEEL_H_
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+
+#include <boost/intrusive/list.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Per-node hierarchical timing wheel, which expires PIT and QTAB entries
+ *
+ * Three levels of buckets (256, 64 and 64 slots) cover 2^20 ticks ahead (~17 minutes with the
+ * default 1ms tick), which is well above Interest lifetimes and QtabEntryLifetime values
+ * used in scenarios.  Items further in the future are parked in the last slot and re-examined.
+ *
+ * Extending the lifetime of an item does not move it: when its bucket is reached, the item
+ * is either expired or re-inserted according to its current expire time.  Items are
+ * expired at most one tick after their expire time, and a single event per node
+ * (only while the wheel is not empty) drives the wheel.
+ */
+class ExpiryWheel : public Object
+{
+public:
+  /**
+   * \brief Object that can be expired by the wheel (i.e., PIT or QTAB entry)
+   */
+  class Item
+  {
+  public:
+    Item ();
+
+    /**
+     * \brief Destructor, removes the item from the wheel
+     */
+    virtual ~Item ();
+
+    /**
+     * \brief Get absolute time when the item should be expired
+     */
+    virtual const Time &
+    GetExpireTime () const = 0;
+
+    /**
+     * \brief Called by the wheel when item expires (item is already removed from the wheel)
+     *
+     * The item may be destroyed by this call
+     */
+    virtual void
+    Expire () = 0;
+
+    /**
+     * \brief Check if the item is scheduled in a wheel
+     */
+    bool
+    IsScheduled () const { return m_wheel != 0; }
+
+  private:
+    friend class ExpiryWheel;
+
+    boost::intrusive::list_member_hook< boost::intrusive::link_mode<boost::intrusive::auto_unlink> > m_hook;
+    ExpiryWheel *m_wheel;
+    uint64_t m_tick; ///< \brief Tick of the slot in which the item is stored
+  };
+
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  ExpiryWheel ();
+  virtual ~ExpiryWheel ();
+
+  /**
+   * \brief Schedule expiration of the item, according to its current expire time
+   */
+  void
+  Schedule (Item &item);
+
+  /**
+   * \brief Notify the wheel that expire time of the item has changed
+   *
+   * Items that should expire later are left in place, items that should
+   * expire earlier than their slot are moved
+   */
+  void
+  Update (Item &item);
+
+  /**
+   * \brief Remove item from the wheel (item will not be expired)
+   */
+  void
+  Cancel (Item &item);
+
+  /**
+   * \brief Get number of scheduled items
+   */
+  uint32_t
+  GetSize () const;
+
+  /**
+   * \brief Get granularity of the wheel
+   */
+  const Time &
+  GetTick () const;
+
+protected:
+  // inherited from Object class
+  virtual void DoDispose (); ///< @brief Do cleanup
+
+private:
+  typedef boost::intrusive::list< Item,
+                                  boost::intrusive::member_hook< Item,
+                                                                 boost::intrusive::list_member_hook< boost::intrusive::link_mode<boost::intrusive::auto_unlink> >,
+                                                                 &Item::m_hook >,
+                                  boost::intrusive::constant_time_size<false>
+                                  > bucket;
+
+  void
+  Clear ();
+
+  void
+  Insert (Item &item);
+
+  void
+  Cascade (bucket *level, uint32_t slot);
+
+  void
+  ProcessTick ();
+
+  void
+  OnTick ();
+
+  void
+  RescheduleTick ();
+
+  uint64_t
+  ToTick (const Time &time) const;
+
+private:
+  static const uint32_t LEVEL0_BITS = 8;
+  static const uint32_t LEVEL_BITS = 6;
+  static const uint32_t LEVEL0_SIZE = 1 << LEVEL0_BITS;
+  static const uint32_t LEVEL_SIZE = 1 << LEVEL_BITS;
+
+  bucket m_level0[LEVEL0_SIZE]; ///< @brief one slot per tick
+  bucket m_level1[LEVEL_SIZE];  ///< @brief one slot per LEVEL0_SIZE ticks
+  bucket m_level2[LEVEL_SIZE];  ///< @brief one slot per LEVEL0_SIZE * LEVEL_SIZE ticks
+
+  Time m_tick;
+  uint64_t m_now;      ///< @brief Next tick to be processed
+  uint64_t m_nextTick; ///< @brief Tick of the scheduled event
+  uint32_t m_size;
+  bool m_inTick;
+  EventId m_tickEvent;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_EXPIRY_WHEEL_H_ */
@@ -0,0 +1,48 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-inform-counters.h"
+
+namespace ns3 {
+namespace ndn {
+
+InformCounters::InformCounters ()
+  : explorationInterests (0)
+  , exploitationInterests (0)
+  , explorationEntries (0)
+  , exploitationEntries (0)
+  , deltaSwitchBacks (0)
+  , randomFaces (0)
+  , qtabMisses (0)
+{
+}
+
+void
+InformCounters::Print (std::ostream &os) const
+{
+  os << "ExplorationInterests\t" << explorationInterests << "\t"
+     << "ExploitationInterests\t" << exploitationInterests << "\t"
+     << "ExplorationEntries\t" << explorationEntries << "\t"
+     << "ExploitationEntries\t" << exploitationEntries << "\t"
+     << "DeltaSwitchBacks\t" << deltaSwitchBacks << "\t"
+     << "RandomFaces\t" << randomFaces << "\t"
+     << "QtabMisses\t" << qtabMisses;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,67 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_INFORM_COUNTERS_H_
+#define	_NDN_INFORM_COUNTERS_H_
+
+#include <ostream>
+#include <stdint.h>
+
+/**
+ * \ingroup ndn
+ * \brief Increment an INFORM counter of the forwarding strategy
+ *
+ * Counters exist only if ndnSIM is configured with --enable-inform-counters, otherwise
+ * the macro expands to nothing and strategies have no counters at all.
+ */
+#ifdef NDNSIM_INFORM_COUNTERS
+#define NDN_INFORM_COUNT(counter) (m_informCounters.counter ++)
+#else
+#define NDN_INFORM_COUNT(counter)
+#endif
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Per-node counters of the decisions of the INFORM strategy
+ */
+struct InformCounters
+{
+  InformCounters ();
+
+  /**
+   * \brief Print counters as tab-separated "name value" pairs
+   */
+  void
+  Print (std::ostream &os) const;
+
+  uint64_t explorationInterests;  ///< \brief Interests forwarded in exploration phase
+  uint64_t exploitationInterests; ///< \brief Interests forwarded in exploitation phase
+  uint64_t explorationEntries;    ///< \brief switches from exploitation to exploration phase
+  uint64_t exploitationEntries;   ///< \brief switches from exploration to exploitation phase
+  uint64_t deltaSwitchBacks;      ///< \brief switches to exploration because the Q-value changed more than delta
+  uint64_t randomFaces;           ///< \brief Interests forwarded on a random face
+  uint64_t qtabMisses;            ///< \brief Data received without a QTAB entry
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_INFORM_COUNTERS_H_ */
@@ -0,0 +1,255 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-ladder-scheduler.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+
+#include <algorithm>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.LadderScheduler");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::LadderScheduler")
+    .SetGroupName ("Ndn")
+    .SetParent<Scheduler> ()
+    .AddConstructor<LadderScheduler> ()
+    ;
+  return tid;
+}
+
+LadderScheduler::LadderScheduler ()
+  : m_topMin (std::numeric_limits<uint64_t>::max ())
+  , m_topMax (0)
+  , m_topStart (0)
+  , m_rungCount (0)
+  , m_size (0)
+{
+}
+
+LadderScheduler::~LadderScheduler ()
+{
+}
+
+bool
+LadderScheduler::IsLater (const Event &a, const Event &b)
+{
+  return a.key > b.key;
+}
+
+void
+LadderScheduler::Insert (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+
+  m_size ++;
+  uint64_t ts = ev.key.m_ts;
+  if (ts >= m_topStart)
+    {
+      m_top.push_back (ev);
+      m_topMin = std::min (m_topMin, ts);
+      m_topMax = std::max (m_topMax, ts);
+      return;
+    }
+
+  for (uint32_t i = 0; i < m_rungCount; i++)
+    {
+      Rung &rung = m_rungs[i];
+      if (ts >= rung.GetCurrentStart ())
+        {
+          uint64_t bucket = (ts - rung.m_start) / rung.m_width;
+          NS_ASSERT (bucket < rung.m_size);
+          rung.m_buckets[bucket].push_back (ev);
+          return;
+        }
+    }
+
+  InsertBottom (ev);
+}
+
+bool
+LadderScheduler::IsEmpty () const
+{
+  return m_size == 0;
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext () const
+{
+  NS_ASSERT (m_size > 0);
+
+  // moving events down the ladder does not change the set of scheduled events
+  const_cast<LadderScheduler*> (this)->FillBottom ();
+  return m_bottom.back ();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext ()
+{
+  NS_ASSERT (m_size > 0);
+
+  FillBottom ();
+  Event ev = m_bottom.back ();
+  m_bottom.pop_back ();
+  m_size --;
+
+  NS_LOG_DEBUG (ev.key.m_ts << " " << ev.key.m_uid);
+  return ev;
+}
+
+void
+LadderScheduler::Remove (const Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (m_size > 0);
+
+  // the event is where Insert would have put it now: it could only have been moved down
+  // the ladder together with its bucket, and then Insert would follow it
+  m_size --;
+  uint64_t ts = ev.key.m_ts;
+  EventList *list = 0;
+  if (ts >= m_topStart)
+    {
+      list = &m_top;
+    }
+  else
+    {
+      for (uint32_t i = 0; i < m_rungCount; i++)
+        {
+          Rung &rung = m_rungs[i];
+          if (ts >= rung.GetCurrentStart ())
+            {
+              list = &rung.m_buckets[(ts - rung.m_start) / rung.m_width];
+              break;
+            }
+        }
+    }
+
+  if (list != 0)
+    {
+      // top and buckets are not sorted
+      for (EventList::iterator i = list->begin (); i != list->end (); i++)
+        {
+          if (i->key.m_uid == ev.key.m_uid)
+            {
+              *i = list->back ();
+              list->pop_back ();
+              return;
+            }
+        }
+      NS_FATAL_ERROR ("Event " << ev.key.m_uid << " is not scheduled");
+    }
+
+  EventList::iterator i = std::lower_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater);
+  NS_ASSERT_MSG (i != m_bottom.end () && i->key.m_uid == ev.key.m_uid,
+                 "Event " << ev.key.m_uid << " is not scheduled");
+  m_bottom.erase (i);
+}
+
+void
+LadderScheduler::InsertBottom (const Event &ev)
+{
+  // the next events are at the end of the bottom, so do the events that are usually scheduled
+  // before them (i.e., with zero or very short delays)
+  m_bottom.insert (std::upper_bound (m_bottom.begin (), m_bottom.end (), ev, IsLater), ev);
+}
+
+void
+LadderScheduler::SpawnRung (EventList &events, uint64_t start, uint64_t span)
+{
+  NS_ASSERT (m_rungCount < MAX_RUNGS);
+
+  Rung &rung = m_rungs[m_rungCount];
+  rung.m_start = start;
+  rung.m_width = std::max<uint64_t> ((span + events.size () - 1) / events.size (), 1);
+  rung.m_size = (span + rung.m_width - 1) / rung.m_width;
+  rung.m_current = 0;
+  // buckets of exhausted rungs are empty, and are reused with their memory
+  if (rung.m_buckets.size () < rung.m_size)
+    rung.m_buckets.resize (rung.m_size);
+  m_rungCount ++;
+
+  for (EventList::const_iterator i = events.begin (); i != events.end (); i++)
+    {
+      rung.m_buckets[(i->key.m_ts - start) / rung.m_width].push_back (*i);
+    }
+  events.clear ();
+}
+
+void
+LadderScheduler::FillBottom ()
+{
+  while (m_bottom.empty ())
+    {
+      if (m_rungCount == 0)
+        {
+          NS_ASSERT (!m_top.empty ());
+          if (m_top.size () <= THRESHOLD)
+            {
+              m_bottom.swap (m_top);
+              std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+              m_topStart = m_topMax + 1;
+            }
+          else
+            {
+              SpawnRung (m_top, m_topMin, m_topMax - m_topMin + 1);
+              m_topStart = m_rungs[0].m_start + m_rungs[0].m_size * m_rungs[0].m_width;
+            }
+          m_topMin = std::numeric_limits<uint64_t>::max ();
+          m_topMax = 0;
+          continue;
+        }
+
+      Rung &rung = m_rungs[m_rungCount - 1];
+      while (rung.m_current < rung.m_size && rung.m_buckets[rung.m_current].empty ())
+        {
+          rung.m_current ++;
+        }
+      if (rung.m_current == rung.m_size)
+        {
+          // upper rung has already moved past the bucket this rung was spawned from
+          m_rungCount --;
+          continue;
+        }
+
+      EventList &bucket = rung.m_buckets[rung.m_current];
+      uint64_t start = rung.GetCurrentStart ();
+      rung.m_current ++;
+      if (bucket.size () <= THRESHOLD || rung.m_width == 1 || m_rungCount == MAX_RUNGS)
+        {
+          m_bottom.swap (bucket);
+          std::sort (m_bottom.begin (), m_bottom.end (), IsLater);
+        }
+      else
+        {
+          SpawnRung (bucket, start, rung.m_width);
+        }
+    }
+}
+
+} // namespace ndn
+} // namespace ns3
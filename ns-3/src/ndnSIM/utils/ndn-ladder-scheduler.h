@@ -0,0 +1,120 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_LADDER_SCHEDULER_H_
+#define	_NDN_LADDER_SCHEDULER_H_
+
+#include "ns3/scheduler.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Ladder queue event scheduler (Tang, Goh and Thng, ACM TOMACS 2005)
+ *
+ * Events are kept in three tiers:
+ * - Top, an unsorted list of events far in the future;
+ * - Ladder, up to MAX_RUNGS rungs of buckets.  Each bucket is unsorted, and a bucket with
+ *   too many events is spread on a new rung with narrower buckets;
+ * - Bottom, a small sorted list with the events to be executed next.
+ *
+ * Insert and RemoveNext are O(1) amortized, independently of the distribution of event
+ * times: both the short link delays and the long PIT/QTAB/retransmission timers of the
+ * scenarios are handled well, while MapScheduler pays O(log n) on both operations.
+ *
+ * Use it with --SchedulerType=ns3::ndn::LadderScheduler
+ */
+class LadderScheduler : public Scheduler
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  LadderScheduler ();
+  virtual ~LadderScheduler ();
+
+  // inherited from Scheduler
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty () const;
+  virtual Event PeekNext () const;
+  virtual Event RemoveNext ();
+  virtual void Remove (const Event &ev);
+
+private:
+  typedef std::vector<Event> EventList;
+
+  struct Rung
+  {
+    std::vector<EventList> m_buckets;
+    uint64_t m_start;   ///< @brief Timestamp of the first bucket
+    uint64_t m_width;   ///< @brief Width of the buckets
+    uint32_t m_size;    ///< @brief Number of buckets in use
+    uint32_t m_current; ///< @brief First bucket not moved down yet
+
+    /**
+     * \brief Timestamp of the current bucket: older events go to lower rungs or to the bottom
+     */
+    uint64_t
+    GetCurrentStart () const { return m_start + m_current * m_width; }
+  };
+
+  /**
+   * \brief Spread events on the new lowest rung, with one bucket for about each event
+   */
+  void
+  SpawnRung (EventList &events, uint64_t start, uint64_t span);
+
+  /**
+   * \brief Move events down until the bottom contains the next events
+   */
+  void
+  FillBottom ();
+
+  void
+  InsertBottom (const Event &ev);
+
+  static bool
+  IsLater (const Event &a, const Event &b);
+
+private:
+  static const uint32_t MAX_RUNGS = 8;
+  static const uint32_t THRESHOLD = 50; ///< @brief Maximum number of events sorted into the bottom at once
+
+  EventList m_top;
+  uint64_t m_topMin;
+  uint64_t m_topMax;
+  uint64_t m_topStart; ///< @brief Events at or after this timestamp go to the top
+
+  Rung m_rungs[MAX_RUNGS];
+  uint32_t m_rungCount;
+
+  EventList m_bottom;  ///< @brief Sorted from the latest to the next event
+  uint32_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_LADDER_SCHEDULER_H_ */
@@ -0,0 +1,130 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-recording-scheduler.h"
+
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/string.h"
+#include "ns3/object-factory.h"
+
+NS_LOG_COMPONENT_DEFINE ("ndn.RecordingScheduler");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED (RecordingScheduler);
+
+TypeId
+RecordingScheduler::GetTypeId ()
+{
+  static TypeId tid = TypeId ("ns3::ndn::RecordingScheduler")
+    .SetGroupName ("Ndn")
+    .SetParent<Scheduler> ()
+    .AddConstructor<RecordingScheduler> ()
+
+    .AddAttribute ("Scheduler", "Scheduler that actually keeps the events",
+                   StringValue ("ns3::MapScheduler"),
+                   MakeStringAccessor (&RecordingScheduler::SetScheduler, &RecordingScheduler::GetScheduler),
+                   MakeStringChecker ())
+    .AddAttribute ("File", "Name of the file the scheduler operations are written to",
+                   StringValue ("scheduler-events.txt"),
+                   MakeStringAccessor (&RecordingScheduler::SetFile, &RecordingScheduler::GetFile),
+                   MakeStringChecker ())
+    ;
+  return tid;
+}
+
+RecordingScheduler::RecordingScheduler ()
+{
+}
+
+RecordingScheduler::~RecordingScheduler ()
+{
+}
+
+void
+RecordingScheduler::SetScheduler (std::string type)
+{
+  NS_ASSERT_MSG (m_scheduler == 0 || m_scheduler->IsEmpty (), "Scheduler cannot be changed while events are scheduled");
+
+  ObjectFactory factory;
+  factory.SetTypeId (type);
+  m_scheduler = factory.Create<Scheduler> ();
+}
+
+std::string
+RecordingScheduler::GetScheduler () const
+{
+  return m_scheduler->GetInstanceTypeId ().GetName ();
+}
+
+void
+RecordingScheduler::SetFile (std::string file)
+{
+  if (m_os.is_open ())
+    m_os.close ();
+
+  m_file = file;
+  m_os.open (m_file.c_str (), std::ios_base::out | std::ios_base::trunc);
+  if (!m_os.is_open ())
+    NS_FATAL_ERROR ("Cannot open " << m_file);
+}
+
+std::string
+RecordingScheduler::GetFile () const
+{
+  return m_file;
+}
+
+void
+RecordingScheduler::Insert (const Event &ev)
+{
+  m_os << "i " << ev.key.m_ts << " " << ev.key.m_uid << "\n";
+  m_scheduler->Insert (ev);
+}
+
+bool
+RecordingScheduler::IsEmpty () const
+{
+  return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event
+RecordingScheduler::PeekNext () const
+{
+  return m_scheduler->PeekNext ();
+}
+
+Scheduler::Event
+RecordingScheduler::RemoveNext ()
+{
+  Event ev = m_scheduler->RemoveNext ();
+  m_os << "n " << ev.key.m_ts << " " << ev.key.m_uid << "\n";
+  return ev;
+}
+
+void
+RecordingScheduler::Remove (const Event &ev)
+{
+  m_os << "r " << ev.key.m_ts << " " << ev.key.m_uid << "\n";
+  m_scheduler->Remove (ev);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,86 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_RECORDING_SCHEDULER_H_
+#define	_NDN_RECORDING_SCHEDULER_H_
+
+#include "ns3/scheduler.h"
+#include "ns3/ptr.h"
+
+#include <fstream>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Scheduler that forwards all operations to another scheduler and records them to a file
+ *
+ * Every operation is written as a line of the file:
+ * - "i <timestamp> <uid>" for Insert;
+ * - "n <timestamp> <uid>" for RemoveNext (event returned);
+ * - "r <timestamp> <uid>" for Remove.
+ *
+ * Timestamps are in simulator ticks.  The file can be replayed against any scheduler
+ * with scratch/ndn-scheduler-benchmark.cc.  To record a run:
+ *
+ * --SchedulerType=ns3::ndn::RecordingScheduler --ns3::ndn::RecordingScheduler::File=events.txt
+ */
+class RecordingScheduler : public Scheduler
+{
+public:
+  /**
+   * \brief Interface ID
+   *
+   * \return interface ID
+   */
+  static TypeId GetTypeId ();
+
+  RecordingScheduler ();
+  virtual ~RecordingScheduler ();
+
+  // inherited from Scheduler
+  virtual void Insert (const Event &ev);
+  virtual bool IsEmpty () const;
+  virtual Event PeekNext () const;
+  virtual Event RemoveNext ();
+  virtual void Remove (const Event &ev);
+
+private:
+  void
+  SetScheduler (std::string type);
+
+  std::string
+  GetScheduler () const;
+
+  void
+  SetFile (std::string file);
+
+  std::string
+  GetFile () const;
+
+private:
+  Ptr<Scheduler> m_scheduler;
+  std::string m_file;
+  std::ofstream m_os;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_RECORDING_SCHEDULER_H_ */
@@ -0,0 +1,129 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-request-catalog.h"
+
+#include "ns3/log.h"
+
+#include <map>
+#include <cstring>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.RequestCatalog");
+
+namespace ns3 {
+namespace ndn {
+
+Ptr<const RequestCatalog>
+RequestCatalog::Open (const std::string &path)
+{
+  // catalogs stay loaded until the end of the process, so runs in the same process do not reload them
+  static std::map<std::string, Ptr<const RequestCatalog> > catalogs;
+
+  std::map<std::string, Ptr<const RequestCatalog> >::iterator item = catalogs.find (path);
+  if (item != catalogs.end ())
+    return item->second;
+
+  Ptr<RequestCatalog> catalog = Ptr<RequestCatalog> (new RequestCatalog (), false);
+  if (!catalog->Load (path))
+    return 0;
+
+  catalogs.insert (std::make_pair (path, catalog));
+  return catalog;
+}
+
+RequestCatalog::RequestCatalog ()
+  : m_data (0)
+  , m_length (0)
+{
+}
+
+RequestCatalog::~RequestCatalog ()
+{
+  if (m_data != 0)
+    munmap (const_cast<char *> (m_data), m_length);
+}
+
+bool
+RequestCatalog::Load (const std::string &path)
+{
+  int fd = open (path.c_str (), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat info;
+  if (fstat (fd, &info) != 0)
+    {
+      close (fd);
+      return false;
+    }
+
+  m_length = info.st_size;
+  if (m_length > 0)
+    {
+      void *data = mmap (0, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED)
+        {
+          close (fd);
+          return false;
+        }
+      m_data = static_cast<const char *> (data);
+    }
+  close (fd); // mapping stays valid
+
+  const char *end = m_data + m_length;
+  for (const char *line = m_data; line < end; )
+    {
+      m_lines.push_back (line - m_data);
+
+      const char *newline = static_cast<const char *> (memchr (line, '\n', end - line));
+      if (newline == 0)
+        break;
+      line = newline + 1;
+    }
+
+  NS_LOG_DEBUG (path << ": " << m_lines.size () << " lines");
+  return true;
+}
+
+std::string
+RequestCatalog::GetLine (uint32_t num) const
+{
+  if (num == 0 || num > m_lines.size ())
+    return "";
+
+  size_t begin = m_lines[num - 1];
+  size_t end = (num < m_lines.size ()) ? m_lines[num] - 1 : m_length;
+  if (end > begin && m_data[end - 1] == '\n')
+    end --;
+
+  return std::string (m_data + begin, end - begin);
+}
+
+uint32_t
+RequestCatalog::GetSize () const
+{
+  return m_lines.size ();
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,82 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_REQUEST_CATALOG_H_
+#define	_NDN_REQUEST_CATALOG_H_
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+
+#include <string>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Read-only, line-indexed view of a request file
+ *
+ * The file is memory-mapped once and the offset of every line is recorded, so any line
+ * can be retrieved in O(1) instead of skipping all the preceding lines of the file.
+ * Catalogs are shared: all the applications opening the same file get the same instance.
+ */
+class RequestCatalog : public SimpleRefCount<RequestCatalog>
+{
+public:
+  /**
+   * \brief Get the catalog of the file, loading it on first use
+   * \param path path of the request file
+   * \returns 0 if the file cannot be read
+   */
+  static Ptr<const RequestCatalog>
+  Open (const std::string &path);
+
+  ~RequestCatalog ();
+
+  /**
+   * \brief Get the line of the file (numbering starts from 1)
+   *
+   * The trailing newline is not included. An empty string is returned if the file
+   * has less than num lines.
+   */
+  std::string
+  GetLine (uint32_t num) const;
+
+  /**
+   * \brief Get number of lines in the file
+   */
+  uint32_t
+  GetSize () const;
+
+private:
+  RequestCatalog ();
+
+  bool
+  Load (const std::string &path);
+
+private:
+  const char *m_data;
+  size_t m_length;
+  std::vector<size_t> m_lines; ///< @brief offset of the first character of every line
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_REQUEST_CATALOG_H_ */
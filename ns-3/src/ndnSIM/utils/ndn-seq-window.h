@@ -0,0 +1,138 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_SEQ_WINDOW_H_
+#define	_NDN_SEQ_WINDOW_H_
+
+#include "ns3/assert.h"
+
+#include <deque>
+#include <stdint.h>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Per-request state of an application, indexed by sequence number
+ *
+ * Sequence numbers are allocated in increasing order and retired roughly in the same order,
+ * so states are kept in a deque starting at the oldest sequence number that is still
+ * in use.  Lookups are O(1) and the memory is bounded by the span of outstanding requests,
+ * not by the number of requests issued since the application started.
+ */
+template<class State>
+class SeqWindow
+{
+public:
+  SeqWindow ()
+    : m_base (0)
+    , m_size (0)
+  {
+  }
+
+  /**
+   * \brief Add state for the sequence number (must not be lower than any retired one)
+   */
+  State &
+  Insert (uint32_t seq, const State &state)
+  {
+    if (m_slots.empty ())
+      m_base = seq;
+
+    NS_ASSERT_MSG (seq >= m_base, "Sequence number " << seq << " is already retired");
+    if (seq - m_base >= m_slots.size ())
+      m_slots.resize (seq - m_base + 1);
+
+    Slot &slot = m_slots[seq - m_base];
+    if (!slot.active)
+      m_size ++;
+    slot.active = true;
+    slot.state = state;
+    return slot.state;
+  }
+
+  /**
+   * \brief Find state of the sequence number
+   * \returns 0 if the sequence number has no state (never inserted or already retired)
+   */
+  State *
+  Find (uint32_t seq)
+  {
+    if (seq < m_base || seq - m_base >= m_slots.size () || !m_slots[seq - m_base].active)
+      return 0;
+
+    return &m_slots[seq - m_base].state;
+  }
+
+  /**
+   * \brief Retire state of the sequence number
+   */
+  void
+  Erase (uint32_t seq)
+  {
+    if (Find (seq) == 0)
+      return;
+
+    m_slots[seq - m_base].active = false;
+    m_size --;
+
+    while (!m_slots.empty () && !m_slots.front ().active)
+      {
+        m_slots.pop_front ();
+        m_base ++;
+      }
+  }
+
+  /**
+   * \brief Remove all states
+   */
+  void
+  Clear ()
+  {
+    m_slots.clear ();
+    m_size = 0;
+  }
+
+  /**
+   * \brief Get number of sequence numbers with state
+   */
+  uint32_t
+  GetSize () const
+  {
+    return m_size;
+  }
+
+private:
+  struct Slot
+  {
+    Slot () : active (false) { }
+
+    bool active;
+    State state;
+  };
+
+  std::deque<Slot> m_slots;
+  uint32_t m_base; ///< @brief sequence number of m_slots.front ()
+  uint32_t m_size;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_SEQ_WINDOW_H_ */
@@ -0,0 +1,95 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ndn-zipf-mandelbrot.h"
+
+#include "ns3/log.h"
+
+#include <map>
+#include <algorithm>
+#include <cmath>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+NS_LOG_COMPONENT_DEFINE ("ndn.ZipfMandelbrot");
+
+namespace ns3 {
+namespace ndn {
+
+Ptr<const ZipfMandelbrot>
+ZipfMandelbrot::Get (uint32_t n, double q, double s)
+{
+  typedef std::map< boost::tuple<uint32_t, double, double>, Ptr<const ZipfMandelbrot> > registry;
+  static registry tables;
+
+  // attributes are set one by one, so drop intermediate tables that no application uses anymore
+  for (registry::iterator table = tables.begin (); table != tables.end (); )
+    {
+      if (table->second->GetReferenceCount () == 1)
+        tables.erase (table++);
+      else
+        table ++;
+    }
+
+  boost::tuple<uint32_t, double, double> key (n, q, s);
+  registry::iterator table = tables.find (key);
+  if (table != tables.end ())
+    return table->second;
+
+  Ptr<const ZipfMandelbrot> distribution = Ptr<ZipfMandelbrot> (new ZipfMandelbrot (n, q, s), false);
+  tables.insert (std::make_pair (key, distribution));
+  return distribution;
+}
+
+ZipfMandelbrot::ZipfMandelbrot (uint32_t n, double q, double s)
+  : m_Pcum (n + 1)
+{
+  NS_LOG_DEBUG (q << " and " << s << " and " << n);
+
+  m_Pcum[0] = 0.0;
+  for (uint32_t i=1; i<=n; i++)
+    {
+      m_Pcum[i] = m_Pcum[i-1] + 1.0 / std::pow(i+q, s);
+    }
+
+  for (uint32_t i=1; i<=n; i++)
+    {
+      m_Pcum[i] = m_Pcum[i] / m_Pcum[n];
+      NS_LOG_LOGIC ("Cumulative probability [" << i << "]=" << m_Pcum[i]);
+    }
+}
+
+uint32_t
+ZipfMandelbrot::GetContent (double p_random) const
+{
+  std::vector<double>::const_iterator item = std::lower_bound (m_Pcum.begin () + 1, m_Pcum.end (), p_random);
+  if (item == m_Pcum.end ())
+    return 1;
+
+  return item - m_Pcum.begin ();
+}
+
+uint32_t
+ZipfMandelbrot::GetNumberOfContents () const
+{
+  return m_Pcum.size () - 1;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef _NDN_ZIPF_MANDELBROT_H_
+#define	_NDN_ZIPF_MANDELBROT_H_
+
+#include "ns3/simple-ref-count.h"
+#include "ns3/ptr.h"
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * \ingroup ndn
+ * \brief Immutable cumulative distribution of Zipf-Mandelbrot content popularity
+ *
+ * P(k) is proportional to 1 / (k+q)^s, for k in [1, N].  Tables are shared: all the
+ * applications using the same (N, q, s) get the same instance, and a content
+ * is sampled with a binary search over the cumulative probabilities.
+ */
+class ZipfMandelbrot : public SimpleRefCount<ZipfMandelbrot>
+{
+public:
+  /**
+   * \brief Get the distribution with the given parameters, building it on first use
+   * \param n number of contents
+   * \param q q in (k+q)^s
+   * \param s s in (k+q)^s
+   */
+  static Ptr<const ZipfMandelbrot>
+  Get (uint32_t n, double q, double s);
+
+  /**
+   * \brief Map a uniform random value in (0, 1] to the content rank in [1, N]
+   *
+   * Returns the smallest k such that p_random <= Pcum[k] (1 if there is none)
+   */
+  uint32_t
+  GetContent (double p_random) const;
+
+  /**
+   * \brief Get number of contents
+   */
+  uint32_t
+  GetNumberOfContents () const;
+
+private:
+  ZipfMandelbrot (uint32_t n, double q, double s);
+
+private:
+  std::vector<double> m_Pcum; ///< @brief cumulative probability, m_Pcum[0] = 0
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif	/* _NDN_ZIPF_MANDELBROT_H_ */
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011 UCLA
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "ndn-binary-trace-writer.h"
+
+#include "ns3/ndn-face.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+
+#include <cstring>
+
+#ifdef NDNSIM_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+NS_LOG_COMPONENT_DEFINE ("ndn.BinaryTraceWriter");
+
+namespace ns3 {
+namespace ndn {
+
+// records are copied as they are, make sure there is no padding
+typedef char RecordSizeCheck[sizeof (BinaryTraceWriter::Record) == 32 ? 1 : -1];
+
+const char BinaryTraceWriter::MAGIC[8] = { 'N', 'D', 'N', 'T', 'R', 'C', '0', '1' };
+
+BinaryTraceWriter::BinaryTraceWriter (const std::string &filename, bool compress, uint32_t bufferSize)
+  : m_buffer (std::max<uint32_t> (bufferSize, 4096))
+  , m_used (0)
+  , m_file (0)
+  , m_gzFile (0)
+{
+  if (compress)
+    {
+#ifdef NDNSIM_HAVE_ZLIB
+      m_gzFile = gzopen (filename.c_str (), "wb1"); // favour speed over compression ratio
+      if (m_gzFile == 0)
+        NS_FATAL_ERROR ("Cannot open trace file " << filename);
+#else
+      NS_FATAL_ERROR ("ndnSIM has been compiled without zlib, trace file " << filename << " cannot be compressed");
+#endif
+    }
+  else
+    {
+      m_file = fopen (filename.c_str (), "wb");
+      if (m_file == 0)
+        NS_FATAL_ERROR ("Cannot open trace file " << filename);
+    }
+
+  Append (MAGIC, sizeof (MAGIC));
+}
+
+BinaryTraceWriter::~BinaryTraceWriter ()
+{
+  Close ();
+}
+
+void
+BinaryTraceWriter::Close ()
+{
+  Flush ();
+
+  if (m_file != 0)
+    {
+      fclose (m_file);
+      m_file = 0;
+    }
+#ifdef NDNSIM_HAVE_ZLIB
+  if (m_gzFile != 0)
+    {
+      gzclose (static_cast<gzFile> (m_gzFile));
+      m_gzFile = 0;
+    }
+#endif
+}
+
+void
+BinaryTraceWriter::Flush ()
+{
+  if (m_used == 0)
+    return;
+
+  WriteToFile (&m_buffer[0], m_used);
+  m_used = 0;
+}
+
+void
+BinaryTraceWriter::WriteToFile (const void *data, uint32_t size)
+{
+  if (m_file != 0)
+    {
+      if (fwrite (data, 1, size, m_file) != size)
+        NS_FATAL_ERROR ("Cannot write trace file");
+    }
+#ifdef NDNSIM_HAVE_ZLIB
+  else if (m_gzFile != 0)
+    {
+      if (gzwrite (static_cast<gzFile> (m_gzFile), data, size) != static_cast<int> (size))
+        NS_FATAL_ERROR ("Cannot write trace file");
+    }
+#endif
+}
+
+void
+BinaryTraceWriter::Append (const void *data, uint32_t size)
+{
+  if (m_used + size > m_buffer.size ())
+    {
+      Flush ();
+      if (size > m_buffer.size ())
+        {
+          WriteToFile (data, size);
+          return;
+        }
+    }
+
+  memcpy (&m_buffer[m_used], data, size);
+  m_used += size;
+}
+
+void
+BinaryTraceWriter::Write (uint8_t type, const std::string &eventType, int64_t timeSent, int64_t downloadTime, uint32_t value)
+{
+  if (m_file == 0 && m_gzFile == 0)
+    return;
+
+  std::map<std::string, uint8_t>::iterator event = m_events.find (eventType);
+  if (event == m_events.end ())
+    {
+      NS_ASSERT_MSG (m_events.size () < 256, "Too many event types");
+      event = m_events.insert (std::make_pair (eventType, static_cast<uint8_t> (m_events.size ()))).first;
+
+      Record name;
+      memset (&name, 0, sizeof (name));
+      name.type = EVENT_NAME;
+      name.event = event->second;
+      name.value = eventType.size ();
+      Append (&name, sizeof (name));
+      Append (eventType.c_str (), eventType.size ());
+    }
+
+  Record record;
+  record.time = Simulator::Now ().GetMicroSeconds ();
+  record.timeSent = timeSent;
+  record.downloadTime = downloadTime;
+  record.value = value;
+  record.type = type;
+  record.event = event->second;
+  record.reserved = 0;
+  Append (&record, sizeof (record));
+}
+
+void
+BinaryTraceWriter::OnInterest (Ptr<const Interest> header, Ptr<const Face> face, std::string eventType, std::string nodeType)
+{
+  Write (INTEREST, eventType, 0, 0, face->GetId ());
+}
+
+void
+BinaryTraceWriter::OnData (Ptr<const ContentObject> header, Ptr<const Face> face, std::string eventType, std::string nodeType)
+{
+  Write (DATA, eventType, 0, 0, face->GetId ());
+}
+
+void
+BinaryTraceWriter::OnDataApp (Ptr<const ContentObject> header, std::string eventType, std::string nodeType)
+{
+  Write (DATA_APP, eventType, 0, 0, 0);
+}
+
+void
+BinaryTraceWriter::OnInterestApp (const std::string *name, int64_t timeSent, std::string eventType, std::string nodeType)
+{
+  Write (INTEREST_APP, eventType, timeSent, 0, 0);
+}
+
+void
+BinaryTraceWriter::OnDownloadTime (const std::string *name, int64_t timeSent, int64_t downloadTime, uint32_t distance, std::string eventType, std::string nodeType)
+{
+  Write (DOWNLOAD_TIME, eventType, timeSent, downloadTime, distance);
+}
+
+} // namespace ndn
+} // namespace ns3
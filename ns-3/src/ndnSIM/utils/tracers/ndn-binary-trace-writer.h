@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2011-2012 University of California, Los Angeles
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef NDN_BINARY_TRACE_WRITER_H
+#define NDN_BINARY_TRACE_WRITER_H
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+#include <stdio.h>
+
+namespace ns3 {
+namespace ndn {
+
+class Interest;
+class ContentObject;
+class Face;
+
+/**
+ * @ingroup ndn
+ * @brief Trace sink writing fixed-size binary records, instead of a text line per event
+ *
+ * Records are accumulated in a large buffer and written to the file (gzip-compressed if requested)
+ * only when the buffer is full.  Event types (e.g., "OutInterests") are written once, in EVENT_NAME
+ * records, and referenced by their index afterwards.
+ *
+ * Callbacks have the signatures of the trace sources of ForwardingStrategy (OutInterests,
+ * InInterests, AggregateInterests, OutData, InData, DataInCacheApp) and of the consumer
+ * applications (InterestApp, TimeOutTrace, NumMaxRtx, UncompleteFile, DownloadTime, DownloadTimeFile):
+ *
+ * \code
+ * Ptr<BinaryTraceWriter> writer = Create<BinaryTraceWriter> ("trace.bin.gz", true);
+ * node->GetObject<ForwardingStrategy> ()->TraceConnectWithoutContext ("OutInterests", MakeCallback (&BinaryTraceWriter::OnInterest, writer));
+ * \endcode
+ *
+ * The ndn-trace-to-text tool converts the files back into the text format of the ndn-inform scenario.
+ */
+class BinaryTraceWriter : public SimpleRefCount<BinaryTraceWriter>
+{
+public:
+  enum RecordType
+    {
+      EVENT_NAME = 0,    ///< @brief definition of an event type, followed by 'value' bytes of the name
+      INTEREST = 1,      ///< @brief value = face ID
+      DATA = 2,          ///< @brief value = face ID
+      DATA_APP = 3,
+      INTEREST_APP = 4,  ///< @brief timeSent is set
+      DOWNLOAD_TIME = 5  ///< @brief timeSent and downloadTime are set, value = hit distance
+    };
+
+  /**
+   * @brief Record of the file (32 bytes, host byte order)
+   */
+  struct Record
+  {
+    int64_t time;         ///< @brief time of the event (microseconds)
+    int64_t timeSent;     ///< @brief time when the request was sent (microseconds)
+    int64_t downloadTime; ///< @brief download time (microseconds)
+    uint32_t value;       ///< @brief face ID, hit distance, or length of the event name
+    uint8_t type;         ///< @brief RecordType
+    uint8_t event;        ///< @brief index of the event type
+    uint16_t reserved;
+  };
+
+  static const char MAGIC[8]; ///< @brief first bytes of the file
+
+  /**
+   * @brief Open trace file
+   * @param filename name of the file
+   * @param compress compress the file with gzip (requires zlib)
+   * @param bufferSize size of the write buffer (bytes)
+   */
+  BinaryTraceWriter (const std::string &filename, bool compress = false, uint32_t bufferSize = 1 << 20);
+
+  /**
+   * @brief Flush buffered records and close the file
+   */
+  ~BinaryTraceWriter ();
+
+  /**
+   * @brief Write buffered records to the file
+   */
+  void
+  Flush ();
+
+  /**
+   * @brief Flush buffered records and close the file (further records are ignored)
+   */
+  void
+  Close ();
+
+  void
+  OnInterest (Ptr<const Interest> header, Ptr<const Face> face, std::string eventType, std::string nodeType);
+
+  void
+  OnData (Ptr<const ContentObject> header, Ptr<const Face> face, std::string eventType, std::string nodeType);
+
+  void
+  OnDataApp (Ptr<const ContentObject> header, std::string eventType, std::string nodeType);
+
+  void
+  OnInterestApp (const std::string *name, int64_t timeSent, std::string eventType, std::string nodeType);
+
+  void
+  OnDownloadTime (const std::string *name, int64_t timeSent, int64_t downloadTime, uint32_t distance, std::string eventType, std::string nodeType);
+
+private:
+  void
+  Write (uint8_t type, const std::string &eventType, int64_t timeSent, int64_t downloadTime, uint32_t value);
+
+  void
+  Append (const void *data, uint32_t size);
+
+  void
+  WriteToFile (const void *data, uint32_t size);
+
+private:
+  std::map<std::string, uint8_t> m_events;
+  std::vector<char> m_buffer;
+  uint32_t m_used;
+
+  FILE *m_file;
+  void *m_gzFile; ///< @brief gzFile, if the trace is compressed
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_BINARY_TRACE_WRITER_H
@@ -150,9 +150,15 @@ public:
 
   typedef PayloadTraits payload_traits;
 
+  /**
+   * @brief Create trie node
+   * @param key name component of the node
+   * @param hash hash of the prefix ending with the node (see Name::GetPrefixHash), 0 for the root node
+   */
   inline
-  trie (const Key &key, size_t bucketSize = 10, size_t bucketIncrement = 10)
+  trie (const Key &key, size_t bucketSize = 10, size_t bucketIncrement = 10, std::size_t hash = 0)
     : key_ (key)
+    , hash_ (hash)
     , initialBucketSize_ (bucketSize)
     , bucketIncrement_ (bucketIncrement)
     , bucketSize_ (initialBucketSize_)
@@ -207,12 +213,14 @@ public:
   {
     trie *trieNode = this;
 
-    BOOST_FOREACH (const Key &subkey, key)
+    for (size_t i = 0; i < key.size (); i++)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
+        typename unordered_set::iterator item =
+          trieNode->children_.find (key_component (key, i), key_component_hash (), key_component_equal ());
         if (item == trieNode->children_.end ())
           {
-            trie *newNode = new trie (subkey, initialBucketSize_, bucketIncrement_);
+            trie *newNode = new trie (Key (key.GetComponentData (i), key.GetComponentSize (i)),
+                                      initialBucketSize_, bucketIncrement_, key.GetPrefixHash (i + 1));
             // std::cout << "new " << newNode << "\n";
             newNode->parent_ = trieNode;
 
@@ -308,9 +316,10 @@ public:
     iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
     bool reachLast = true;
 
-    BOOST_FOREACH (const Key &subkey, key)
+    for (size_t i = 0; i < key.size (); i++)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
+        typename unordered_set::iterator item =
+          trieNode->children_.find (key_component (key, i), key_component_hash (), key_component_equal ());
         if (item == trieNode->children_.end ())
           {
             reachLast = false;
@@ -342,9 +351,10 @@ public:
     iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
     bool reachLast = true;
 
-    BOOST_FOREACH (const Key &subkey, key)
+    for (size_t i = 0; i < key.size (); i++)
       {
-        typename unordered_set::iterator item = trieNode->children_.find (subkey);
+        typename unordered_set::iterator item =
+          trieNode->children_.find (key_component (key, i), key_component_hash (), key_component_equal ());
         if (item == trieNode->children_.end ())
           {
             reachLast = false;
@@ -452,6 +462,38 @@ public:
   PrintStat (std::ostream &os) const;
 
 private:
+  /**
+   * @brief Component of the full key, which is looked up in children_ without creating a temporary trie node
+   */
+  struct key_component
+  {
+    key_component (const FullKey &key, size_t num) : key_ (key), num_ (num) {}
+
+    const FullKey &key_;
+    size_t num_;
+  };
+
+  struct key_component_hash
+  {
+    std::size_t operator() (const key_component &component) const
+    {
+      return component.key_.GetPrefixHash (component.num_ + 1);
+    }
+  };
+
+  struct key_component_equal
+  {
+    bool operator() (const key_component &component, const trie &node) const
+    {
+      return component.key_.IsComponentEqual (component.num_, node.key_);
+    }
+
+    bool operator() (const trie &node, const key_component &component) const
+    {
+      return component.key_.IsComponentEqual (component.num_, node.key_);
+    }
+  };
+
   //The disposer object function
   struct trie_delete_disposer
   {
@@ -501,6 +543,7 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
+  std::size_t hash_; ///< hash of the prefix ending with this node (children_ are hashed by it)
 
   size_t initialBucketSize_;
   size_t bucketIncrement_;
@@ -576,7 +619,7 @@ template<typename FullKey, typename PayloadTraits, typename PolicyHook>
 inline std::size_t
 hash_value (const trie<FullKey, PayloadTraits, PolicyHook> &trie_node)
 {
-  return boost::hash_value (trie_node.key_);
+  return trie_node.hash_;
 }
 
 